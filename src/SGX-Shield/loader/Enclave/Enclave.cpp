@@ -36,6 +36,7 @@ void printf(const char *fmt, ...)
 
 extern char __elf_end;          /* defined in the linker script */
 #define _HEAP_BASE (((addr_t)&__elf_end + 0xfff) & ~0xfff)
+#define _HEAP_SIZE 0x10000      /* HeapMaxSize in Enclave.config.xml */
 
 const unsigned long __sgx_data_ofs = 0x2027000;
 #include "loader.cpp"
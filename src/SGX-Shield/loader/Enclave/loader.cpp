@@ -56,51 +56,301 @@ static uint32_t get_rand(void)
     return val;
 }
 
+/* relocation tables of the loader, bump-allocated from the _HEAP_SIZE bytes of heap */
+static addr_t heap_end = _HEAP_BASE;
+
+void *get_buf(size_t size) {
+    void *ret = (void *)heap_end;
+    size = (size + 7) & ~7UL;
+    if (size > _HEAP_BASE + _HEAP_SIZE - heap_end) {
+        ocall_print_string("sec_loader: out of heap for the metadata\n");
+        return NULL;
+    }
+    heap_end = heap_end + size;
+    return ret;
+}
+
+/*
+ * The symbol index and the free-range nodes grow with the number of
+ * symbols and do not fit in the heap for large programs (musl + mbedTLS
+ * has more than 8k symbols). They are taken from the top of the data
+ * region instead, at most _META_MAX bytes, and the data is placed below.
+ */
+#define _META_MAX (_SGX_SIZE / 4)
+static size_t meta_size;
+
+static void *get_meta(size_t size) {
+    size = (size + 7) & ~7UL;
+    if (size > _META_MAX - meta_size) {
+        ocall_print_string("sec_loader: out of data region for the metadata\n");
+        return NULL;
+    }
+    meta_size += size;
+    return (void *)((addr_t)_SGXDATA_BASE + _SGX_SIZE - meta_size);
+}
+
 #if RAND
-void *reserve_data(size_t size, size_t align)
+/*
+ * Free parts of the code and data regions, as treaps of disjoint
+ * [start, end) ranges ordered by start. Each node also keeps the total
+ * and the largest length of the ranges in its subtree, so that a random
+ * free byte or a range large enough can be found in O(log n).
+ */
+struct range {
+    addr_t start, end;
+    addr_t sum, max;    /* total and largest length in the subtree */
+    uint32_t prio;
+    struct range *left, *right;
+};
+
+static struct range *code_free, *data_free;
+/*
+ * The nodes of both regions are allocated once by reserve_init: each
+ * placement adds at most one, so n_symtab + 2 are enough.
+ */
+static struct range *range_pool;    /* free nodes, linked by left */
+static uint32_t range_seed;
+
+/* random placements tried before falling back to a fitting range */
+#define RESERVE_TRIES 16
+
+/* statistics of the placements in a region, for the load report */
+struct reserve_stat {
+    unsigned long n;            /* # of placements */
+    unsigned long tries;        /* # of random positions tried */
+    unsigned long fallbacks;    /* # of placements after RESERVE_TRIES */
+    unsigned long min_bits;     /* log2 of the aligned free positions */
+    unsigned long sum_bits;
+};
+static struct reserve_stat code_stat, data_stat;
+
+/* treap priorities, no need for RDRAND */
+static uint32_t range_prio(void)
 {
-    uint64_t ofs;
-    do {
-        ofs = rounddown(align, get_rand() % (_SGX_SIZE - size)) + (uint64_t)_SGXDATA_BASE;
-        for (unsigned i = 1;i < _n_symtab;++i)
-            if ((symtab[i].st_value <= ofs && ofs < symtab[i].st_value + symtab[i].st_size)
-                    || (symtab[i].st_value < ofs + size
-                        && ofs + size <= symtab[i].st_value + symtab[i].st_size)
-                    || (ofs <= symtab[i].st_value && symtab[i].st_value < ofs + size)
-                    || (ofs < symtab[i].st_value + symtab[i].st_size
-                        && symtab[i].st_value + symtab[i].st_size <= ofs + size)) {
-                ofs = 0;
-                break;
-            }
-    } while (!ofs || (ofs + size > (uint64_t)_SGXDATA_BASE + _SGX_SIZE));
-    return (void *)ofs;
+    range_seed ^= range_seed << 13;
+    range_seed ^= range_seed >> 17;
+    range_seed ^= range_seed << 5;
+    return range_seed;
 }
-#else
-void *reserve_data(size_t size, size_t align)
+
+static struct range *range_update(struct range *t)
 {
-    static void *data_end = _SGXDATA_BASE;
-    void *ret = (void *)rounddown(align, (addr_t)data_end+(align-1));
-    data_end = (void *)((addr_t)ret+rounddown(align, size+(align-1)));
-    return ret;
+    addr_t lsum = t->left ? t->left->sum : 0;
+    addr_t rsum = t->right ? t->right->sum : 0;
+    addr_t lmax = t->left ? t->left->max : 0;
+    addr_t rmax = t->right ? t->right->max : 0;
+    t->sum = lsum + (t->end - t->start) + rsum;
+    t->max = t->end - t->start;
+    if (lmax > t->max) t->max = lmax;
+    if (rmax > t->max) t->max = rmax;
+    return t;
 }
-#endif
 
-bool is_available(uint8_t *base, size_t index, size_t size)
+/* the pool must not be empty */
+static struct range *range_new(addr_t start, addr_t end)
+{
+    struct range *r = range_pool;
+    range_pool = r->left;
+    r->start = start;
+    r->end = end;
+    r->prio = range_prio();
+    r->left = r->right = NULL;
+    return range_update(r);
+}
+
+/* split T into the ranges starting before KEY and the others */
+static void range_split(struct range *t, addr_t key,
+        struct range **l, struct range **r)
+{
+    if (!t) {
+        *l = *r = NULL;
+    } else if (t->start < key) {
+        range_split(t->right, key, &t->right, r);
+        *l = range_update(t);
+    } else {
+        range_split(t->left, key, l, &t->left);
+        *r = range_update(t);
+    }
+}
+
+/* all the ranges of L start before those of R */
+static struct range *range_merge(struct range *l, struct range *r)
+{
+    if (!l) return r;
+    if (!r) return l;
+    if (l->prio > r->prio) {
+        l->right = range_merge(l->right, r);
+        return range_update(l);
+    }
+    r->left = range_merge(l, r->left);
+    return range_update(r);
+}
+
+/* the free range with the largest start <= ADDR */
+static struct range *range_find(struct range *t, addr_t addr)
+{
+    struct range *found = NULL;
+    while (t) {
+        if (t->start <= addr) {
+            found = t;
+            t = t->right;
+        } else
+            t = t->left;
+    }
+    return found;
+}
+
+/* the free range holding the *POS-th free byte, *POS becomes its offset */
+static struct range *range_at(struct range *t, addr_t *pos)
+{
+    while (t) {
+        addr_t lsum = t->left ? t->left->sum : 0;
+        if (*pos < lsum) {
+            t = t->left;
+            continue;
+        }
+        *pos -= lsum;
+        if (*pos < t->end - t->start)
+            return t;
+        *pos -= t->end - t->start;
+        t = t->right;
+    }
+    return NULL;
+}
+
+/* the first free range starting at or after ADDR with at least NEED bytes */
+static struct range *range_fit(struct range *t, addr_t addr, addr_t need)
+{
+    struct range *r;
+    if (!t || t->max < need)
+        return NULL;
+    if (t->start < addr)
+        return range_fit(t->right, addr, need);
+    if ((r = range_fit(t->left, addr, need)))
+        return r;
+    if (t->end - t->start >= need)
+        return t;
+    return range_fit(t->right, addr, need);
+}
+
+/* remove [ADDR, ADDR+SIZE), which must be free, from *T */
+static void range_take(struct range **t, addr_t addr, size_t size)
+{
+    struct range *l, *m, *r, *found;
+    addr_t start, end;
+    if (!size) return;
+    found = range_find(*t, addr);
+    start = found->start;
+    end = found->end;
+    range_split(*t, start, &l, &m);
+    range_split(m, start + 1, &m, &r);
+    found->left = range_pool;
+    range_pool = found;
+    if (start < addr)
+        l = range_merge(l, range_new(start, addr));
+    if (addr + size < end)
+        l = range_merge(l, range_new(addr + size, end));
+    *t = range_merge(l, r);
+}
+
+static unsigned long log2_floor(unsigned long n)
+{
+    unsigned long bits = 0;
+    while (n >>= 1) ++bits;
+    return bits;
+}
+
+/*
+ * Place SIZE bytes aligned to ALIGN (relative to BASE) at a random free
+ * position of the region *T.
+ *
+ * A random free byte is drawn and the aligned slot holding it is taken
+ * if max(SIZE, ALIGN) bytes from there are free. Every such slot covers
+ * ALIGN free bytes, so the slots are equally likely. After RESERVE_TRIES
+ * misses, a random aligned slot of the first range from a random position
+ * that is large enough is taken, so the time is bounded either way.
+ */
+static void *reserve_range(struct range **t, addr_t base, size_t size,
+        size_t align, struct reserve_stat *stat)
+{
+    addr_t need = size > align ? size : align;
+    struct range *r;
+    addr_t pos, slot;
+    unsigned long bits;
+
+    if (!align) {
+        align = 1;
+        need = size > 1 ? size : 1;
+    }
+    if (!*t || (*t)->max < need) {
+        ocall_print_string("sec_loader: out of memory for randomized placement\n");
+        return NULL;
+    }
+
+    bits = log2_floor((*t)->sum / align);
+    if (!stat->n || bits < stat->min_bits) stat->min_bits = bits;
+    stat->sum_bits += bits;
+    ++stat->n;
+
+    for (unsigned i = 0; i < RESERVE_TRIES; ++i) {
+        ++stat->tries;
+        pos = get_rand() % (*t)->sum;
+        r = range_at(*t, &pos);
+        slot = base + rounddown(align, r->start + pos - base);
+        if (slot >= r->start && slot + need <= r->end) {
+            range_take(t, slot, size);
+            return (void *)slot;
+        }
+    }
+
+    ++stat->fallbacks;
+    need = size + align - 1;
+    pos = base + get_rand() % _SGX_SIZE;
+    if (!(r = range_fit(*t, pos, need)) && !(r = range_fit(*t, 0, need))) {
+        ocall_print_string("sec_loader: out of memory for randomized placement\n");
+        return NULL;
+    }
+    slot = base + rounddown(align, r->start - base + align - 1);
+    slot += rounddown(align, get_rand() % (r->end - size - slot + 1));
+    range_take(t, slot, size);
+    return (void *)slot;
+}
+
+static bool reserve_init(void)
 {
-    for (unsigned i = 0;i < size;++i)
-        if (base[index+i]) return false;
+    size_t n = n_symtab + 2;
+    struct range *pool = (struct range *)get_meta(n * sizeof(struct range));
+    if (!pool)
+        return false;
+    for (size_t i = 0; i < n; ++i) {
+        pool[i].left = range_pool;
+        range_pool = &pool[i];
+    }
+    range_seed = get_rand() | 1;
+    code_free = range_new((addr_t)_SGXCODE_BASE, (addr_t)_SGXCODE_BASE + _SGX_SIZE);
+    data_free = range_new((addr_t)_SGXDATA_BASE,
+            (addr_t)_SGXDATA_BASE + _SGX_SIZE - meta_size);
     return true;
 }
 
-#if RAND
+void *reserve_data(size_t size, size_t align)
+{
+    return reserve_range(&data_free, (addr_t)_SGXDATA_BASE, size, align, &data_stat);
+}
+
 void *reserve_code(size_t size, size_t align)
 {
-    uint64_t index;
-    do index = rounddown(align, get_rand() % (_SGX_SIZE - size));
-    while (!is_available((uint8_t *)_SGXCODE_BASE, index, size));
-    return (void *)((uint64_t)_SGXCODE_BASE + index);
+    return reserve_range(&code_free, (addr_t)_SGXCODE_BASE, size, align, &code_stat);
 }
 #else
+void *reserve_data(size_t size, size_t align)
+{
+    static void *data_end = _SGXDATA_BASE;
+    void *ret = (void *)rounddown(align, (addr_t)data_end+(align-1));
+    data_end = (void *)((addr_t)ret+rounddown(align, size+(align-1)));
+    return ret;
+}
+
 void *reserve_code(size_t size, size_t align)
 {
     static void *code_end = _SGXCODE_BASE;
@@ -163,25 +413,85 @@ static void validate_ehdr(void)
         dlog("%u: Shdr entry size", __LINE__);
 }
 
-void *get_buf(size_t size) {
-    static addr_t heap_end = _HEAP_BASE;
-    void *ret = (void *)heap_end;
-    heap_end = heap_end + size;
-    return ret;
+/*
+ * Indices of the symbols sorted by (section, value, index), so that the
+ * symbol containing a relocation can be found by binary search
+ */
+static unsigned *symidx;
+
+static bool sym_before(unsigned a, unsigned b)
+{
+    if (symtab[a].st_shndx != symtab[b].st_shndx)
+        return symtab[a].st_shndx < symtab[b].st_shndx;
+    if (symtab[a].st_value != symtab[b].st_value)
+        return symtab[a].st_value < symtab[b].st_value;
+    return a < b;
 }
 
-/* search (section SE, OFS) from symtab - binary search can be applied */
-static unsigned search(const Elf64_Half se, const Elf64_Addr ofs)
+/*
+ * bottom-up merge sort, symbols are usually sorted already. The
+ * temporary array is given back to the metadata afterwards.
+ */
+static bool sort_symbols(void)
 {
-    // assuming that symbols are already sorted
+    unsigned *buf = (unsigned *)get_meta(n_symtab * sizeof(unsigned));
+    unsigned *spare = (unsigned *)get_meta(n_symtab * sizeof(unsigned));
+    unsigned *tmp = spare;
+    if (!buf || !spare)
+        return false;
+    symidx = buf;
     for (unsigned i = 0; i < n_symtab; ++i)
-      if (symtab[i].st_shndx == se && symtab[i].st_value <= ofs
-          && (i+1 >= n_symtab || symtab[i+1].st_value > ofs
-              || symtab[i+1].st_shndx != se)) return i;
-    return -1;
+        symidx[i] = i;
+    for (size_t width = 1; width < n_symtab; width *= 2) {
+        for (size_t lo = 0; lo < n_symtab; lo += 2 * width) {
+            size_t mid = lo + width < n_symtab ? lo + width : n_symtab;
+            size_t hi = lo + 2 * width < n_symtab ? lo + 2 * width : n_symtab;
+            size_t i = lo, j = mid, k = lo;
+            if (mid == hi || !sym_before(symidx[mid], symidx[mid-1])) {
+                /* already in order */
+                for (k = lo; k < hi; ++k)
+                    tmp[k] = symidx[k];
+                continue;
+            }
+            while (i < mid && j < hi)
+                tmp[k++] = sym_before(symidx[j], symidx[i]) ? symidx[j++] : symidx[i++];
+            while (i < mid)
+                tmp[k++] = symidx[i++];
+            while (j < hi)
+                tmp[k++] = symidx[j++];
+        }
+        unsigned *swap = symidx;
+        symidx = tmp;
+        tmp = swap;
+    }
+    if (symidx != buf) {
+        for (size_t k = 0; k < n_symtab; ++k)
+            buf[k] = symidx[k];
+        symidx = buf;
+    }
+    /* give back the temporary array, which is below the index */
+    meta_size = (addr_t)_SGXDATA_BASE + _SGX_SIZE - (addr_t)buf;
+    return true;
 }
 
-static void update_reltab(void)
+/* search (section SE, OFS) from symtab: the last symbol of SE at or before OFS */
+static unsigned search(const Elf64_Half se, const Elf64_Addr ofs)
+{
+    size_t lo = 0, hi = n_symtab;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        const Elf64_Sym *sym = &symtab[symidx[mid]];
+        if (sym->st_shndx < se || (sym->st_shndx == se && sym->st_value <= ofs))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo == 0 || symtab[symidx[lo-1]].st_shndx != se)
+        return -1;
+    return symidx[lo-1];
+}
+
+static bool update_reltab(void)
 {
     /* read shdr */
     if ((pshdr = GET_OBJ(Elf64_Shdr, pehdr->e_shoff)) == NULL
@@ -198,8 +508,12 @@ static void update_reltab(void)
         } else if (pshdr[i].sh_type == SHT_STRTAB)
             strtab = GET_OBJ(char, pshdr[i].sh_offset);
     }
+    if (!sort_symbols())
+        return false;
     n_reltab = (size_t *)get_buf(n_rel * sizeof(size_t));
     reltab = (Elf64_Rela **)get_buf(n_rel * sizeof(Elf64_Rela *));
+    if (!n_reltab || !reltab)
+        return false;
     n_rel = 0;
     for (unsigned i = 0; i < pehdr->e_shnum; ++i) {
         if (pshdr[i].sh_type == SHT_RELA && pshdr[i].sh_size) {
@@ -216,6 +530,7 @@ static void update_reltab(void)
             ++n_rel;
         }
     }
+    return true;
 }
 
 static void fill_zero(char *ptr, Elf64_Word size) {
@@ -231,6 +546,51 @@ static void cpy(char *dst, char *src, size_t size) {
 #else
 #include "nosgx_ocall_stub.cpp"
 #endif
+#ifdef LOAD_REPORT
+static unsigned long time_us(void)
+{
+    struct timeval tv;
+#ifndef NOSGX
+    sgx_gettimeofday(&tv, NULL);
+#else
+    gettimeofday(&tv, NULL);
+#endif
+    return tv.tv_sec * 1000000UL + tv.tv_usec;
+}
+
+#if RAND
+static void report_region(const char *name, const struct reserve_stat *stat)
+{
+    char buf[256];
+    unsigned long avg = stat->n ? stat->sum_bits * 10 / stat->n : 0;
+    snprintf(buf, sizeof(buf), "%s: %lu placements, %lu tries, %lu fallbacks, "
+            "entropy min %lu avg %lu.%lu bits\n", name, stat->n, stat->tries,
+            stat->fallbacks, stat->min_bits, avg / 10, avg % 10);
+    ocall_print_string(buf);
+}
+#endif
+
+/* times in us of the phases of enclave_main, and what was placed */
+static void load_report(unsigned long t_index, unsigned long t_load,
+        unsigned long t_relocate)
+{
+    char buf[256];
+    size_t n_rela = 0;
+    for (unsigned k = 0; k < n_rel; ++k)
+        n_rela += n_reltab[k];
+    ocall_print_string("=== sec_loader: load report ===\n");
+    snprintf(buf, sizeof(buf), "%lu symbols, %lu relocations\n"
+            "index: %lu us, load: %lu us, relocate: %lu us\n",
+            (unsigned long)n_symtab, (unsigned long)n_rela,
+            t_index, t_load, t_relocate);
+    ocall_print_string(buf);
+#if RAND
+    report_region("code", &code_stat);
+    report_region("data", &data_stat);
+#endif
+}
+#endif
+
 static unsigned char find_special_symbol(const char* name, const size_t i)
 {
     if (STR_EQUAL(name, "dep.bdr\0", 8)) {
@@ -259,7 +619,8 @@ static unsigned char find_special_symbol(const char* name, const size_t i)
     return 0;
 }
 
-static void load(void)
+/* false if a symbol could not be placed */
+static bool load(void)
 {
     Elf64_Addr last_off = (Elf64_Addr)-1;
     Elf64_Addr last_st_value = (Elf64_Addr)-1;
@@ -274,9 +635,14 @@ static void load(void)
         }
         unsigned char found = symtab[i].st_name ?
             find_special_symbol(&strtab[symtab[i].st_name], i) : 0;
+        /* only _stack is reserved among the special symbols */
+        if (found && !symtab[i].st_value)
+            return false;
         /* special shndx --> assumption: no abs, no undef */
         if (symtab[i].st_shndx == SHN_COMMON && !found) {
             symtab[i].st_value = (Elf64_Addr)reserve(0, symtab[i].st_size, symtab[i].st_value);
+            if (!symtab[i].st_value)
+                return false;
             fill_zero((char *)symtab[i].st_value, symtab[i].st_size);
         } else if (!found) {
             Elf64_Addr symoff = pshdr[symtab[i].st_shndx].sh_offset + symtab[i].st_value;
@@ -290,6 +656,8 @@ static void load(void)
 
                 symtab[i].st_value = (Elf64_Addr)reserve(pshdr[symtab[i].st_shndx].sh_flags,
                         symtab[i].st_size, pshdr[symtab[i].st_shndx].sh_addralign);
+                if (!symtab[i].st_value)
+                    return false;
 
                 /* fill zeros for .bss section .. otherwise, copy from file */
                 if (pshdr[symtab[i].st_shndx].sh_type == SHT_NOBITS) {
@@ -309,6 +677,7 @@ static void load(void)
         find_ptrace_target(&strtab[symtab[i].st_name], i);
 #endif
     }
+    return true;
 }
 
 static void relocate(void)
@@ -367,12 +736,32 @@ void enclave_main()
     dlog("__elf_end = %p", &__elf_end);
     dlog("heap base = %lx", _HEAP_BASE);
 
+#ifdef LOAD_REPORT
+    unsigned long t0 = time_us(), t1, t2;
+#endif
     validate_ehdr();
-    update_reltab();
+    if (!update_reltab())
+        return;
+#if RAND
+    if (!reserve_init())
+        return;
+#endif
+#ifdef LOAD_REPORT
+    t1 = time_us();
+#endif
     pr_progress("loading");
-    load();
+    if (!load()) {
+        ocall_print_string("sec_loader: loading failed\n");
+        return;
+    }
+#ifdef LOAD_REPORT
+    t2 = time_us();
+#endif
     pr_progress("relocating");
     relocate();
+#ifdef LOAD_REPORT
+    load_report(t1 - t0, t2 - t1, time_us() - t2);
+#endif
 
     entry = (void (*)())(main_sym->st_value);
     dlog("main: %p", entry);
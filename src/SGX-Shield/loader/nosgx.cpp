@@ -21,10 +21,13 @@ void sgx_read_rand(unsigned char *buf, size_t size)
 #else
 #define dlog(...)
 #endif
+#define pr_progress(s) dlog("\n=== sec_loader: %s ===", s)
 
 extern char __elf_end;          /* defined in the linker script */
-unsigned char heap_space[0x10000];
+/* as much heap as the enclave has, plus a page for the alignment */
+unsigned char heap_space[0x11000];
 #define _HEAP_BASE (((addr_t)heap_space + 0xfff) & ~0xfff)
+#define _HEAP_SIZE 0x10000
 
 static unsigned long __sgx_data_ofs = 0x2027000;
 void sgx_push_gadget(unsigned long a) {}
@@ -0,0 +1,109 @@
+/*
+ * Native check of the loader metadata with a large symbol table (more
+ * than the 64KB enclave heap can index): the binary search must agree
+ * with a linear scan, and one placement per symbol must stay inside its
+ * region, below the metadata, without overlaps.
+ *
+ *   $ make symtab_test && ./symtab_test [# of symbols]
+ */
+#define main nosgx_main
+#include "nosgx.cpp"
+#undef main
+
+#include <vector>
+#include <algorithm>
+
+/* the scan the loader used before the symbol index */
+static unsigned linear_search(const Elf64_Half se, const Elf64_Addr ofs)
+{
+    for (unsigned i = 0; i < n_symtab; ++i)
+        if (symtab[i].st_shndx == se && symtab[i].st_value <= ofs
+                && (i+1 >= n_symtab || symtab[i+1].st_value > ofs
+                    || symtab[i+1].st_shndx != se))
+            return i;
+    return -1;
+}
+
+static bool sym_less(const Elf64_Sym &a, const Elf64_Sym &b)
+{
+    if (a.st_shndx != b.st_shndx)
+        return a.st_shndx < b.st_shndx;
+    return a.st_value < b.st_value;
+}
+
+typedef std::pair<addr_t, addr_t> span;
+
+/* # of spans outside [lo, hi) or overlapping another one */
+static unsigned check_spans(std::vector<span> &v, addr_t lo, addr_t hi)
+{
+    unsigned bad = 0;
+    std::sort(v.begin(), v.end());
+    for (size_t i = 0; i < v.size(); ++i) {
+        if (v[i].first < lo || v[i].second > hi)
+            ++bad;
+        if (i && v[i].first != v[i].second && v[i-1].second > v[i].first)
+            ++bad;
+    }
+    return bad;
+}
+
+int main(int argc, const char *argv[])
+{
+    size_t n = argc > 1 ? strtoul(argv[1], NULL, 0) : 50000;
+    unsigned bad = 0;
+
+    void *sgx_data = mmap(_SGXDATA_BASE, _SGX_SIZE, PROT_READ|PROT_WRITE,
+            MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+    if (sgx_data == MAP_FAILED) {
+        fprintf(stderr, "mmap fails\n");
+        return 1;
+    }
+    __sgx_data_ofs = (unsigned long)sgx_data - (unsigned long)_SGXCODE_BASE;
+
+    /* symbols sorted by section and value, as in a relocatable object */
+    std::vector<Elf64_Sym> syms(n);
+    for (size_t i = 0; i < n; ++i) {
+        syms[i].st_shndx = 1 + rand() % 64;
+        syms[i].st_value = (rand() % 0x10000) * 8;
+        syms[i].st_size = (rand() % 64) * 8;
+    }
+    std::sort(syms.begin(), syms.end(), sym_less);
+    symtab = syms.data();
+    n_symtab = n;
+
+    if (!sort_symbols()) {
+        printf("FAIL: no room for the symbol index of %lu symbols\n", n);
+        return 1;
+    }
+    for (unsigned q = 0; q < 100000; ++q) {
+        Elf64_Half se = rand() % 66;
+        Elf64_Addr ofs = rand() % 0x90000;
+        if (search(se, ofs) != linear_search(se, ofs))
+            ++bad;
+    }
+    printf("%lu symbols: %u search mismatches\n", n, bad);
+
+    if (!reserve_init()) {
+        printf("FAIL: no room for the free ranges of %lu symbols\n", n);
+        return 1;
+    }
+    std::vector<span> data, code;
+    for (size_t i = 1; i < n; ++i) {
+        size_t size = syms[i].st_size, align = 1 << (rand() % 5);
+        addr_t p = (addr_t)reserve(i & 1 ? 0x4 : 0, size, align);
+        if (!p || p % align) {
+            ++bad;
+            continue;
+        }
+        (i & 1 ? code : data).push_back(span(p, p + size));
+    }
+    report_region("code", &code_stat);
+    report_region("data", &data_stat);
+    bad += check_spans(code, (addr_t)_SGXCODE_BASE, (addr_t)_SGXCODE_BASE + _SGX_SIZE);
+    bad += check_spans(data, (addr_t)_SGXDATA_BASE,
+            (addr_t)_SGXDATA_BASE + _SGX_SIZE - meta_size);
+
+    printf("%s: %u errors, %lu bytes of metadata\n", bad ? "FAIL" : "PASS",
+            bad, meta_size);
+    return bad != 0;
+}
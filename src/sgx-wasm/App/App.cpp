@@ -181,6 +181,26 @@ int initialize_enclave(const sgx_uswitchless_config_t* us_config)
 
 #include "ocall.cpp"
 
+/* Print the T-SGX profile of the last run when SGXWASM_PROFILE_REPORT is
+ * set. The enclave keeps one only in __PROFILE__ builds. */
+static void print_profile_report(void)
+{
+    size_t len = 0;
+    char *buf;
+
+    if (!getenv("SGXWASM_PROFILE_REPORT"))
+        return;
+    if (enclave_profile_report(global_eid, &len, NULL, 0) != SGX_SUCCESS ||
+        len == 0)
+        return;
+    buf = (char *) malloc(len + 1);
+    if (!buf)
+        return;
+    if (enclave_profile_report(global_eid, &len, buf, len + 1) == SGX_SUCCESS)
+        fputs(buf, stderr);
+    free(buf);
+}
+
 /* Application entry */
 int SGX_CDECL main(int argc, char *argv[])
 {
@@ -195,6 +215,7 @@ int SGX_CDECL main(int argc, char *argv[])
         printf("Error: enclave initialization failed\n");
         return -1;
     }
+    enclave_refresh_process_ids(global_eid);
 
     if (argc < 2) {
         fprintf(stderr, "Need an input .wasm file\n");
@@ -205,9 +226,19 @@ int SGX_CDECL main(int argc, char *argv[])
     
 #if !WASM_SPEC_TEST
     enclave_main(global_eid, filename);
+    print_profile_report();
 #else // do spec test.
+    if (argc == 2) {
+        /* A whole spec script (see run_spec_test.py) in one ecall. */
+        uint64_t counts[3] = { 0 };
+        int ret = -1;
+
+        enclave_spec_test_script(global_eid, &ret, filename, counts);
+        sgx_destroy_enclave(global_eid);
+        return ret != 0 || counts[1] != 0;
+    }
     if (argc < 3) {
-        fprintf(stderr, "Usage: ./app [.wasm] [target_fun] [# args] [value type ...] [expected value expected type]\n");
+        fprintf(stderr, "Usage: ./app [script] | [.wasm] [target_fun] [# args] [value type ...] [expected value expected type]\n");
         return -1;
     }
     char *fun_name = argv[2];
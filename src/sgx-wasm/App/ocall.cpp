@@ -17,6 +17,7 @@
 #include <sys/resource.h>
 #include <poll.h>
 #include <sys/sendfile.h>
+#include <pthread.h>
 
 //#define OCALL_TRACE
 
@@ -26,16 +27,6 @@ void ocall_print_string(const char *str)
   fprintf(stderr, "%s", str);
 }
 
-clock_t ocall_sgx_clock()
-{
-    return clock();
-}
-
-time_t ocall_sgx_time(time_t *timep)
-{
-    return time(timep);
-}
-
 struct tm *ocall_sgx_localtime(const time_t *timep)
 {
     return localtime(timep);
@@ -130,63 +121,17 @@ char *ocall_sgx_getcwd(char *buf, size_t size)
 #endif
 }
 
-pid_t ocall_sgx_getpid()
+/* Identity of the process, snapshotted by the enclave. */
+void ocall_sgx_getids(struct process_ids *ids)
 {
+    ids->pid = getpid();
+    ids->uid = getuid();
+    ids->euid = geteuid();
+    ids->gid = getgid();
+    ids->egid = getegid();
 #ifdef OCALL_TRACE
-    pid_t ret;
-    ret = getpid();
-    fprintf(stderr, "getpid(), return: %d\n", ret);
-    return ret;
-#else
-    return getpid();
-#endif
-}
-
-uid_t ocall_sgx_getuid()
-{
-#ifdef OCALL_TRACE
-    uid_t ret;
-    ret = getuid();
-    fprintf(stderr, "getuid(), return: %d\n", ret);
-    return ret;
-#else
-    return getuid();
-#endif
-}
-
-uid_t ocall_sgx_geteuid()
-{
-#ifdef OCALL_TRACE
-    uid_t ret;
-    ret = geteuid();
-    fprintf(stderr, "geteuid(), return: %d\n", ret);
-    return ret;
-#else
-    return geteuid();
-#endif
-}
-
-gid_t ocall_sgx_getgid()
-{
-#ifdef OCALL_TRACE
-    gid_t ret;
-    ret = getgid();
-    fprintf(stderr, "getgid(), return: %d\n", ret);
-    return ret;
-#else
-    return getgid();
-#endif
-}
-
-gid_t ocall_sgx_getegid()
-{
-#ifdef OCALL_TRACE
-    gid_t ret;
-    ret = getegid();
-    fprintf(stderr, "getegid(), return: %d\n", ret);
-    return ret;
-#else
-    return getegid();
+    fprintf(stderr, "getids(), pid: %d, uid: %u, euid: %u, gid: %u, egid: %u\n",
+            ids->pid, ids->uid, ids->euid, ids->gid, ids->egid);
 #endif
 }
 
@@ -460,26 +405,6 @@ int ocall_sgx_setsockopt(int s, int level, int optname, const void *optval, size
 
 #include <arpa/inet.h>
 
-unsigned short ocall_sgx_htons(unsigned short hostshort)
-{
-    return htons(hostshort);
-}
-
-unsigned long ocall_sgx_htonl(unsigned long hostlong)
-{
-    return htonl(hostlong);
-}
-
-unsigned short ocall_sgx_ntohs(unsigned short netshort)
-{
-    return ntohs(netshort);
-}
-
-unsigned long ocall_sgx_ntohl(unsigned long netlong)
-{
-    return ntohl(netlong);
-}
-
 void sgx_signal_handle_caller(int signum)
 {
     fprintf(stderr, "Error: signum = %d\n", signum);
@@ -706,3 +631,123 @@ unsigned long ocall_sgx_rdtsc() {
     asm volatile( "rdtsc" : "=a" (lo), "=d" (hi) );
     return( lo | ( hi << 32 ) );
 }
+
+static void *sgxwasm_worker_main(void *arg)
+{
+    (void)arg;
+    enclave_parallel_worker(global_eid);
+    return NULL;
+}
+
+/* Lend n threads to the enclave (e.g., for parallel compilation).
+   Each thread occupies one TCS until it leaves the enclave. */
+void ocall_sgxwasm_run_workers(size_t n)
+{
+    pthread_t *threads = (pthread_t *)malloc(sizeof(pthread_t) * n);
+    size_t i, n_started = 0;
+
+    if (!threads)
+        return;
+    for (i = 0; i < n; i++) {
+        if (pthread_create(&threads[i], NULL, sgxwasm_worker_main, NULL))
+            break;
+        n_started++;
+    }
+    for (i = 0; i < n_started; i++)
+        pthread_join(threads[i], NULL);
+    free(threads);
+}
+
+/* Window of untrusted memory shared with the I/O bridge of the enclave.
+   It lives as long as the enclave. */
+void *ocall_sgx_io_window(size_t size)
+{
+    return malloc(size);
+}
+
+long ocall_sgx_io_submit(void *ptr)
+{
+    struct io_request *req = (struct io_request *)ptr;
+    char *data = (char *)(req + 1);
+    ssize_t ret;
+
+    switch (req->op) {
+    case IO_REQUEST_WRITE:
+        ret = write(req->fd, data, req->len);
+        break;
+    case IO_REQUEST_READ:
+        ret = read(req->fd, data, req->len);
+        break;
+    case IO_REQUEST_SEND:
+        ret = send(req->fd, data, req->len, req->flags);
+        break;
+    case IO_REQUEST_RECV:
+        ret = recv(req->fd, data, req->len, req->flags);
+        break;
+    default:
+        errno = EINVAL;
+        ret = -1;
+        break;
+    }
+    req->err = ret < 0 ? errno : 0;
+    return ret;
+}
+
+/* Time page of the enclave, rewritten by a helper thread every
+   precision_us. The enclave falls back to ocall_sgx_clock_ns when it
+   stops changing. */
+static struct time_page *time_page;
+static useconds_t time_page_period;
+
+uint64_t ocall_sgx_clock_ns(int clock)
+{
+    static const clockid_t ids[TIME_PAGE_CLOCKS] = {
+        CLOCK_REALTIME, CLOCK_MONOTONIC, CLOCK_PROCESS_CPUTIME_ID
+    };
+    struct timespec ts;
+
+    if (clock < 0 || clock >= TIME_PAGE_CLOCKS || clock_gettime(ids[clock], &ts))
+        return 0;
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void publish_time(void)
+{
+    int i;
+    time_page->seq++;
+    __sync_synchronize();
+    for (i = 0; i < TIME_PAGE_CLOCKS; i++)
+        time_page->ns[i] = ocall_sgx_clock_ns(i);
+    __sync_synchronize();
+    time_page->seq++;
+}
+
+static void *time_helper_main(void *arg)
+{
+    (void)arg;
+    for (;;) {
+        usleep(time_page_period);
+        publish_time();
+    }
+    return NULL;
+}
+
+void *ocall_sgx_time_page(unsigned long precision_us)
+{
+    pthread_t thread;
+
+    if (time_page)
+        return time_page;
+    time_page = (struct time_page *)calloc(1, sizeof(struct time_page));
+    if (!time_page)
+        return NULL;
+    time_page_period = precision_us;
+    publish_time();
+    if (pthread_create(&thread, NULL, time_helper_main, NULL)) {
+        free(time_page);
+        time_page = NULL;
+        return NULL;
+    }
+    pthread_detach(thread);
+    return time_page;
+}
@@ -54,9 +54,11 @@
 #include <sgxwasm/emscripten.h>
 #include <sgxwasm/high_level.h>
 #include <sgxwasm/instantiate.h>
+#include <sgxwasm/parallel.h>
 #include <sgxwasm/parse.h>
 #include <sgxwasm/runtime.h>
 #include <sgxwasm/sense.h>
+#include <sgxwasm/timesrc.h>
 #include <sgxwasm/util.h>
 
 #if 0
@@ -77,6 +79,8 @@ int
 run_wasm_test(const char*, uint32_t, int, size_t, size_t,
               const char*, uint64_t*, uint8_t*, size_t,
 	      uint64_t, uint8_t);
+int
+run_spec_test_script(const char*, uint64_t*);
 
 static void*
 get_stack_top(void)
@@ -187,6 +191,29 @@ error:
   return res;
 }
 
+#if __PROFILE__
+// Profile of the last run, for enclave_profile_report.
+static char* profile_report;
+static size_t profile_report_length;
+
+static void
+save_profile_report(struct WasmJITHigh* high)
+{
+  size_t len;
+  char* buf;
+
+  if (sgxwasm_high_format_profile(high, "asm", NULL, 0, &len) < 0)
+    return;
+  buf = malloc(len + 1);
+  if (!buf)
+    return;
+  sgxwasm_high_format_profile(high, "asm", buf, len + 1, &len);
+  free(profile_report);
+  profile_report = buf;
+  profile_report_length = len;
+}
+#endif
+
 static int
 run_emscripten_file(const char* filename,
                     uint32_t static_bump,
@@ -209,7 +236,7 @@ run_emscripten_file(const char* filename,
 
 #if SGXWASM_LOADTIME_BENCH
   uint64_t t1, t2;
-  ocall_sgx_rdtsc(&t1);
+  t1 = sgxwasm_cycles();
 #endif
 
   // Initialize emscripten context.
@@ -262,7 +289,7 @@ run_emscripten_file(const char* filename,
     goto error;
   }
 #if SGXWASM_LOADTIME_BENCH
-  ocall_sgx_rdtsc(&t2);
+  t2 = sgxwasm_cycles();
   printf("%lu\t", t2 - t1);
 #endif
 
@@ -291,6 +318,13 @@ run_emscripten_file(const char* filename,
     goto error;
   }
 
+#if __PROFILE__
+  if (sgxwasm_high_dump_profile(&high, "asm", SGXWASM_PROFILE_PATH) < 0) {
+    printf("failed to write profile\n");
+  }
+  save_profile_report(&high);
+#endif
+
   if (0) {
     char error_buffer[256];
 
@@ -350,3 +384,41 @@ enclave_spec_test(const char* path, const char* fun_name,
                 fun_name, args, args_type, n_args_type, expected, expected_type);
   return;
 }
+
+int
+enclave_spec_test_script(const char* path, uint64_t* counts)
+{
+  return run_spec_test_script(path, counts);
+}
+
+size_t
+enclave_profile_report(char* buf, size_t size)
+{
+  size_t len = 0;
+
+#if __PROFILE__
+  len = profile_report_length;
+  if (size > 0) {
+    size_t n = len < size ? len : size - 1;
+    if (n > 0)
+      memcpy(buf, profile_report, n);
+    buf[n] = '\0';
+  }
+#else
+  if (size > 0)
+    buf[0] = '\0';
+#endif
+  return len;
+}
+
+void
+enclave_parallel_worker(void)
+{
+  sgxwasm_parallel_worker();
+}
+
+void
+enclave_refresh_process_ids(void)
+{
+  refresh_process_ids();
+}
@@ -118,4 +118,20 @@ gid_t getegid();
 
 void exit(int status);
 
+int sgxwasm_spawn_workers(size_t n);
+
+/* Time source (sgxwasm/timesrc.c). */
+void* sgxwasm_time_page(unsigned long precision_us);
+unsigned long sgxwasm_time_exit(int clock);
+
+/* Snapshot the identity of the process (getpid, getuid, ...). Called
+   through enclave_refresh_process_ids after the enclave is created and
+   whenever the App changes it, or lazily on first use. */
+void refresh_process_ids(void);
+
+/* I/O bridge (sgxwasm/iobridge.c). */
+struct io_request;
+void* sgxwasm_io_window(size_t size);
+long sgxwasm_io_submit(struct io_request* req);
+
 #endif
@@ -6,6 +6,7 @@
 
 #include "ocall_stub.h"
 #include "Enclave_t.h"
+#include "sgxwasm/timesrc.h"
 
 #ifdef LD_DEBUG
 
@@ -44,26 +45,19 @@ printf(const char* fmt, ...)
   return 0;
 }
 
+// In microseconds, the CLOCKS_PER_SEC of the untrusted side.
 clock_t
 clock()
 {
-  clock_t retv;
-  sgx_status_t sgx_retv;
-  if ((sgx_retv = ocall_sgx_clock(&retv)) != SGX_SUCCESS) {
-    printf(" FAILED!, Error code = %d\n", sgx_retv);
-    abort();
-  }
-  return retv;
+  return sgxwasm_time_get(SGXWASM_CLOCK_PROCESS, 0) / 1000;
 }
 
 time_t
 time(time_t* timep)
 {
-  time_t retv;
-  sgx_status_t sgx_retv;
-  if ((sgx_retv = ocall_sgx_time(&retv, timep)) != SGX_SUCCESS) {
-    printf(" FAILED!, Error code = %d\n", sgx_retv);
-    abort();
+  time_t retv = sgxwasm_time_get(SGXWASM_CLOCK_REALTIME, 0) / 1000000000;
+  if (timep) {
+    *timep = retv;
   }
   return retv;
 }
@@ -128,6 +122,13 @@ gettimeofday(struct timeval* tv, struct timezone* tz)
 {
   int retv;
   sgx_status_t sgx_retv;
+  if (!tz) {
+    uint64_t ns = sgxwasm_time_get(SGXWASM_CLOCK_REALTIME, 0);
+    tv->tv_sec = ns / 1000000000;
+    tv->tv_usec = ns % 1000000000 / 1000;
+    return 0;
+  }
+  // The time zone is only known to the untrusted side.
   if ((sgx_retv = ocall_sgx_gettimeofday(&retv, tv, tz)) != SGX_SUCCESS) {
     printf(" FAILED!, Error code = %d\n", sgx_retv);
     abort();
@@ -583,49 +584,25 @@ setsockopt(int s, int level, int optname, const void* optval, size_t optlen)
 unsigned short
 htons(unsigned short hostshort)
 {
-  unsigned short retv;
-  sgx_status_t sgx_retv;
-  if ((sgx_retv = ocall_sgx_htons(&retv, hostshort)) != SGX_SUCCESS) {
-    printf(" FAILED!, Error code = %d\n", sgx_retv);
-    abort();
-  }
-  return retv;
+  return __builtin_bswap16((uint16_t)hostshort);
 }
 
 unsigned long
 htonl(unsigned long hostlong)
 {
-  unsigned long retv;
-  sgx_status_t sgx_retv;
-  if ((sgx_retv = ocall_sgx_htonl(&retv, hostlong)) != SGX_SUCCESS) {
-    printf(" FAILED!, Error code = %d\n", sgx_retv);
-    abort();
-  }
-  return retv;
+  return __builtin_bswap32((uint32_t)hostlong);
 }
 
 unsigned short
 ntohs(unsigned short netshort)
 {
-  unsigned short retv;
-  sgx_status_t sgx_retv;
-  if ((sgx_retv = ocall_sgx_ntohs(&retv, netshort)) != SGX_SUCCESS) {
-    printf(" FAILED!, Error code = %d\n", sgx_retv);
-    abort();
-  }
-  return retv;
+  return __builtin_bswap16((uint16_t)netshort);
 }
 
 unsigned long
 ntohl(unsigned long netlong)
 {
-  unsigned long retv;
-  sgx_status_t sgx_retv;
-  if ((sgx_retv = ocall_sgx_ntohl(&retv, netlong)) != SGX_SUCCESS) {
-    printf(" FAILED!, Error code = %d\n", sgx_retv);
-    abort();
-  }
-  return retv;
+  return __builtin_bswap32((uint32_t)netlong);
 }
 
 sighandler_t
@@ -969,16 +946,35 @@ rmdir(const char* pathname)
   return 0;
 }
 
-uid_t
-geteuid(void)
+static struct process_ids process_ids;
+static volatile int process_ids_valid = 0;
+
+void
+refresh_process_ids(void)
 {
-  uid_t retv;
   sgx_status_t sgx_retv;
-  if ((sgx_retv = ocall_sgx_geteuid(&retv)) != SGX_SUCCESS) {
+  if ((sgx_retv = ocall_sgx_getids(&process_ids)) != SGX_SUCCESS) {
     printf(" FAILED!, Error code = %d\n", sgx_retv);
     abort();
   }
-  return retv;
+  process_ids_valid = 1;
+}
+
+// Taken once, when the untrusted side did not call
+// enclave_refresh_process_ids after creating the enclave.
+static const struct process_ids*
+get_process_ids(void)
+{
+  if (!process_ids_valid) {
+    refresh_process_ids();
+  }
+  return &process_ids;
+}
+
+uid_t
+geteuid(void)
+{
+  return get_process_ids()->euid;
 }
 
 int
@@ -1008,47 +1004,82 @@ ioctl(int fd, unsigned long request, ...)
 pid_t
 getpid()
 {
-  pid_t retv;
+  return get_process_ids()->pid;
+}
+
+uid_t
+getuid()
+{
+  return get_process_ids()->uid;
+}
+
+gid_t
+getgid()
+{
+  return get_process_ids()->gid;
+}
+
+gid_t
+getegid()
+{
+  return get_process_ids()->egid;
+}
+
+int
+sgxwasm_spawn_workers(size_t n)
+{
   sgx_status_t sgx_retv;
-  if ((sgx_retv = ocall_sgx_getpid(&retv)) != SGX_SUCCESS) {
+  if ((sgx_retv = ocall_sgxwasm_run_workers(n)) != SGX_SUCCESS) {
     printf(" FAILED!, Error code = %d\n", sgx_retv);
-    abort();
+    return 0;
+  }
+  return 1;
+}
+
+void*
+sgxwasm_io_window(size_t size)
+{
+  void* retv;
+  sgx_status_t sgx_retv;
+  if ((sgx_retv = ocall_sgx_io_window(&retv, size)) != SGX_SUCCESS) {
+    printf(" FAILED!, Error code = %d\n", sgx_retv);
+    return NULL;
   }
   return retv;
 }
 
-uid_t
-getuid()
+void*
+sgxwasm_time_page(unsigned long precision_us)
 {
-  uid_t retv;
+  void* retv;
   sgx_status_t sgx_retv;
-  if ((sgx_retv = ocall_sgx_getuid(&retv)) != SGX_SUCCESS) {
+  if ((sgx_retv = ocall_sgx_time_page(&retv, precision_us)) != SGX_SUCCESS) {
     printf(" FAILED!, Error code = %d\n", sgx_retv);
-    abort();
+    return NULL;
   }
   return retv;
 }
 
-gid_t
-getgid()
+unsigned long
+sgxwasm_time_exit(int clock)
 {
-  gid_t retv;
+  uint64_t retv;
   sgx_status_t sgx_retv;
-  if ((sgx_retv = ocall_sgx_getgid(&retv)) != SGX_SUCCESS) {
+  if ((sgx_retv = ocall_sgx_clock_ns(&retv, clock)) != SGX_SUCCESS) {
     printf(" FAILED!, Error code = %d\n", sgx_retv);
-    abort();
+    return 0;
   }
   return retv;
 }
 
-gid_t
-getegid()
+long
+sgxwasm_io_submit(struct io_request* req)
 {
-  gid_t retv;
+  long retv;
   sgx_status_t sgx_retv;
-  if ((sgx_retv = ocall_sgx_getegid(&retv)) != SGX_SUCCESS) {
+  if ((sgx_retv = ocall_sgx_io_submit(&retv, req)) != SGX_SUCCESS) {
     printf(" FAILED!, Error code = %d\n", sgx_retv);
-    abort();
+    return -1;
   }
   return retv;
 }
@@ -765,6 +765,18 @@ emit_cmp_ri(struct SizedBuffer* output,
   return 1;
 }
 
+int
+emit_cmp_rm(struct SizedBuffer* output,
+            sgxwasm_register_t dst,
+            struct Operand* src,
+            sgxwasm_valtype_t type)
+{
+  emit_rex_rm(output, dst, src, type, 1);
+  emit(output, 0x3b);
+  emit_operand_rm(output, dst, src);
+  return 1;
+}
+
 int
 emit_cdq(struct SizedBuffer* output)
 {
@@ -913,6 +925,21 @@ emit_set_cond(struct SizedBuffer* output,
   return count;
 }
 
+int
+emit_cmov_rr(struct SizedBuffer* output,
+             condition_t cc,
+             sgxwasm_register_t dst,
+             sgxwasm_register_t src,
+             sgxwasm_valtype_t type)
+{
+  assert(is_uint4(cc));
+  emit_rex_rr(output, dst, src, type, 1);
+  emit(output, 0x0f);
+  emit(output, 0x40 | cc);
+  emit_modrm_rr(output, dst, src);
+  return 1;
+}
+
 // Bit operations
 
 int
@@ -1159,6 +1186,14 @@ emit_call_r(struct SizedBuffer* output, sgxwasm_valtype_t addr)
   return 1;
 }
 
+int
+emit_call_32(struct SizedBuffer* output, int32_t imm)
+{
+  emit(output, 0xe8);
+  emit_imm(output, (int64_t)imm, IMM_4_BYTE);
+  return 1;
+}
+
 // Moves.
 
 int
@@ -1795,6 +1830,18 @@ emit_movsd_mr(struct SizedBuffer* output,
   return 1;
 }
 
+int
+emit_movups_mr(struct SizedBuffer* output,
+               struct Operand* dst,
+               sgxwasm_register_t src)
+{
+  emit_rex_rm(output, src, dst, VALTYPE_F32, 1);
+  emit(output, 0x0f);
+  emit(output, 0x11); // store
+  emit_sse_operand_rm(output, src, dst);
+  return 1;
+}
+
 int
 emit_movsd_rr(struct SizedBuffer* output,
               sgxwasm_register_t dst,
@@ -2222,6 +2269,15 @@ emit_jmp_r(struct SizedBuffer* output, sgxwasm_register_t target)
   return 1;
 }
 
+int
+emit_jmp_m(struct SizedBuffer* output, struct Operand* target)
+{
+  emit_rex_m(output, target, VALTYPE_I32, 1);
+  emit(output, 0xff);
+  emit_operand_cm(output, 0x04, target);
+  return 1;
+}
+
 int
 emit_jcc(struct SizedBuffer* output,
          condition_t cond,
@@ -2270,12 +2326,10 @@ emit_jcc(struct SizedBuffer* output,
 }
 
 int
-emit_cond_jump_rr(struct SizedBuffer* output,
-                  condition_t cond,
-                  label_t* label,
-                  sgxwasm_valtype_t type,
-                  sgxwasm_register_t lhs,
-                  sgxwasm_register_t rhs)
+emit_cond_compare_rr(struct SizedBuffer* output,
+                     sgxwasm_valtype_t type,
+                     sgxwasm_register_t lhs,
+                     sgxwasm_register_t rhs)
 {
   int count = 0;
   if (rhs != REG_UNKNOWN) {
@@ -2292,6 +2346,18 @@ emit_cond_jump_rr(struct SizedBuffer* output,
   } else {
     count += emit_test_rr(output, lhs, lhs, VALTYPE_I32);
   }
+  return count;
+}
+
+int
+emit_cond_jump_rr(struct SizedBuffer* output,
+                  condition_t cond,
+                  label_t* label,
+                  sgxwasm_valtype_t type,
+                  sgxwasm_register_t lhs,
+                  sgxwasm_register_t rhs)
+{
+  int count = emit_cond_compare_rr(output, type, lhs, rhs);
   count += emit_jcc(output, cond, label, Far);
   return count;
 }
@@ -2385,6 +2451,14 @@ emit_xend(struct SizedBuffer* output)
   return 1;
 }
 
+int
+emit_ud2(struct SizedBuffer* output)
+{
+  emit(output, 0x0f);
+  emit(output, 0x0b);
+  return 1;
+}
+
 int
 emit_std(struct SizedBuffer* output)
 {
@@ -2708,6 +2782,33 @@ get_load_value_type(load_type_t type)
   }
 }
 
+uint32_t
+get_load_size(load_type_t type)
+{
+  switch (type) {
+    case I32Load8U:
+    case I64Load8U:
+    case I32Load8S:
+    case I64Load8S:
+      return 1;
+    case I32Load16U:
+    case I64Load16U:
+    case I32Load16S:
+    case I64Load16S:
+      return 2;
+    case I32Load:
+    case I64Load32U:
+    case I64Load32S:
+    case F32Load:
+      return 4;
+    case I64Load:
+    case F64Load:
+      return 8;
+    default:
+      assert(0);
+  }
+}
+
 int
 Load(struct SizedBuffer* output,
      sgxwasm_register_t dst,
@@ -2846,6 +2947,28 @@ get_store_value_type(store_type_t type)
   }
 }
 
+uint32_t
+get_store_size(store_type_t type)
+{
+  switch (type) {
+    case I32Store8:
+    case I64Store8:
+      return 1;
+    case I32Store16:
+    case I64Store16:
+      return 2;
+    case I32Store:
+    case I64Store32:
+    case F32Store:
+      return 4;
+    case I64Store:
+    case F64Store:
+      return 8;
+    default:
+      assert(0);
+  }
+}
+
 int
 Store(struct SizedBuffer* output,
       sgxwasm_register_t dst_addr,
@@ -3202,6 +3325,8 @@ emit_type_conversion(struct SizedBuffer* output,
   return count;
 }
 
+// Zeroes size stack slots from slot index upwards with rep stosq.
+// Clobbers RDI, RCX and RAX.
 int
 InitStack(struct SizedBuffer* output, size_t index, size_t size)
 {
@@ -3224,6 +3349,32 @@ InitStack(struct SizedBuffer* output, size_t index, size_t size)
   return count;
 }
 
+// Zeroes size stack slots from slot index upwards with 16-byte stores
+// of ScratchFP.
+int
+ZeroStack(struct SizedBuffer* output, size_t index, size_t size)
+{
+  int count = 0;
+  struct Operand dst;
+  int32_t offset;
+
+  if (size == 0) {
+    return 0;
+  }
+  offset = index * StackSlotSize * -1 - StackOffset;
+
+  count += emit_xorps_rr(output, ScratchFP, ScratchFP);
+  for (; size >= 2; size -= 2, offset += 2 * StackSlotSize) {
+    build_operand(&dst, GP_RBP, REG_UNKNOWN, SCALE_NONE, offset);
+    count += emit_movups_mr(output, &dst, ScratchFP);
+  }
+  if (size) {
+    build_operand(&dst, GP_RBP, REG_UNKNOWN, SCALE_NONE, offset);
+    count += emit_movsd_mr(output, &dst, ScratchFP);
+  }
+  return count;
+}
+
 // For runtime hook
 void
 SaveRegisterStates(struct SizedBuffer* output)
@@ -290,6 +290,11 @@ emit_cmp_ri(struct SizedBuffer*,
             sgxwasm_register_t,
             int64_t,
             sgxwasm_valtype_t);
+int
+emit_cmp_rm(struct SizedBuffer*,
+            sgxwasm_register_t,
+            struct Operand*,
+            sgxwasm_valtype_t);
 
 int
 emit_idiv_r(struct SizedBuffer*, sgxwasm_register_t, sgxwasm_valtype_t);
@@ -321,6 +326,12 @@ emit_set_cond(struct SizedBuffer*,
               sgxwasm_register_t,
               sgxwasm_valtype_t);
 int
+emit_cmov_rr(struct SizedBuffer*,
+             condition_t,
+             sgxwasm_register_t,
+             sgxwasm_register_t,
+             sgxwasm_valtype_t);
+int
 emit_test_rr(struct SizedBuffer*,
              sgxwasm_register_t,
              sgxwasm_register_t,
@@ -339,6 +350,8 @@ emit_lea_rm(struct SizedBuffer*,
 int
 emit_call_r(struct SizedBuffer*, sgxwasm_valtype_t);
 int
+emit_call_32(struct SizedBuffer*, int32_t);
+int
 emit_subq_sp_32(struct SizedBuffer*, uint32_t);
 // Bit operations.
 int
@@ -488,6 +501,8 @@ emit_movsd_rm(struct SizedBuffer*, sgxwasm_register_t, struct Operand*);
 int
 emit_movsd_mr(struct SizedBuffer*, struct Operand*, sgxwasm_register_t);
 int
+emit_movups_mr(struct SizedBuffer*, struct Operand*, sgxwasm_register_t);
+int
 emit_movsd_rr(struct SizedBuffer*, sgxwasm_register_t, sgxwasm_register_t);
 int
 emit_movmskps_rr(struct SizedBuffer*, sgxwasm_register_t, sgxwasm_register_t);
@@ -555,7 +570,15 @@ emit_jmp_32(struct SizedBuffer*, int32_t);
 int
 emit_jmp_r(struct SizedBuffer*, sgxwasm_register_t);
 int
+emit_jmp_m(struct SizedBuffer*, struct Operand*);
+int
 emit_jcc(struct SizedBuffer*, condition_t, label_t*, distance_t);
+// cmp lhs, rhs (test lhs, lhs if rhs is REG_UNKNOWN) of emit_cond_jump_rr.
+int
+emit_cond_compare_rr(struct SizedBuffer*,
+                     sgxwasm_valtype_t,
+                     sgxwasm_register_t,
+                     sgxwasm_register_t);
 int
 emit_cond_jump_rr(struct SizedBuffer*,
                   condition_t,
@@ -570,6 +593,9 @@ emit_xbegin(struct SizedBuffer*, label_t*);
 int
 emit_xend(struct SizedBuffer*);
 
+int
+emit_ud2(struct SizedBuffer*);
+
 int
 emit_std(struct SizedBuffer*);
 int
@@ -632,6 +658,7 @@ Spill(struct SizedBuffer*,
 
 load_type_t get_load_type(sgxwasm_valtype_t);
 sgxwasm_valtype_t get_load_value_type(load_type_t);
+uint32_t get_load_size(load_type_t);
 int
 Load(struct SizedBuffer*,
      sgxwasm_register_t,
@@ -648,6 +675,7 @@ LoadCallerFrameSlot(struct SizedBuffer*,
                     sgxwasm_valtype_t);
 store_type_t get_store_type(sgxwasm_valtype_t);
 sgxwasm_valtype_t get_store_value_type(store_type_t);
+uint32_t get_store_size(store_type_t);
 int
 Store(struct SizedBuffer*,
       sgxwasm_register_t,
@@ -664,6 +692,8 @@ Shift(struct SizedBuffer*, sgxwasm_register_t, uint8_t);
 int
 InitStack(struct SizedBuffer*, size_t, size_t);
 int
+ZeroStack(struct SizedBuffer*, size_t, size_t);
+int
 emit_type_conversion(struct SizedBuffer*,
                      uint8_t,
                      sgxwasm_register_t,
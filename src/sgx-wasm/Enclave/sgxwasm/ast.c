@@ -47,46 +47,11 @@ init_instruction(struct Instr* instr)
   memset(instr, 0, sizeof(*instr));
 }
 
-void
-free_instruction(struct Instr* instr)
-{
-  switch (instr->opcode) {
-    case OPCODE_BLOCK:
-    case OPCODE_LOOP: {
-      struct BlockLoopExtra* block =
-        instr->opcode == OPCODE_BLOCK ? &instr->data.block : &instr->data.loop;
-      if (block->instructions) {
-        free_instructions(block->instructions, block->n_instructions);
-      }
-      break;
-    };
-    case OPCODE_IF: {
-      if (instr->data.if_.instructions_then) {
-        free_instructions(instr->data.if_.instructions_then,
-                          instr->data.if_.n_instructions_then);
-      }
-      if (instr->data.if_.instructions_else) {
-        free_instructions(instr->data.if_.instructions_else,
-                          instr->data.if_.n_instructions_else);
-      }
-      break;
-    }
-    case OPCODE_BR_TABLE: {
-      if (instr->data.br_table.labelidxs) {
-        free(instr->data.br_table.labelidxs);
-      }
-      break;
-    }
-  }
-}
-
+// Instructions own no memory, see struct Instr.
 void
 free_instructions(struct Instr* instructions, size_t n_instructions)
 {
-  size_t i;
-  for (i = 0; i < n_instructions; ++i) {
-    free_instruction(&instructions[i]);
-  }
+  (void)n_instructions;
   free(instructions);
 }
 
@@ -172,6 +137,10 @@ sgxwasm_free_wasm_module(struct WASMModule* module)
       if (code->instructions) {
         free_instructions(code->instructions, code->n_instructions);
       }
+
+      if (code->labels) {
+        free(code->labels);
+      }
     }
     free(module->code_section.codes);
   }
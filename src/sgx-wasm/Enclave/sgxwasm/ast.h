@@ -300,6 +300,11 @@ struct Limits
 #define FUNC_TYPE_OUTPUT_IDX(ft, idx) ((ft)->output_type)
 #define FUNC_TYPE_OUTPUT_TYPES(ft) (&((ft)->output_type))
 
+// The inputs stay inline, so a FuncType remains a plain value.
+// struct Function, CompilerContext and calls into the runtime copy it
+// or build it on the stack. Moving the inputs out of line would need an
+// owner that outlives all of those. Identical types of a module are
+// interned at parse time instead (intern_types in parse.c).
 #define FUNC_TYPE_MAX_INPUTS 254
 #define FUNC_TYPE_MAX_OUTPUTS 1
 
@@ -321,6 +326,10 @@ struct MemoryType
   struct Limits limits;
 };
 
+// Function bodies are flat: the instructions of nested blocks follow
+// their BLOCK, LOOP or IF in the same array, and every block is closed
+// by its END (ELSE stays inline in the IF). Blocks record the index of
+// their END (and of their ELSE), so that a reader can skip them.
 struct Instr
 {
   uint8_t opcode;
@@ -329,16 +338,13 @@ struct Instr
     struct BlockLoopExtra
     {
       uint8_t blocktype;
-      size_t n_instructions;
-      struct Instr* instructions;
+      uint32_t end;
     } block, loop;
     struct IfExtra
     {
       uint8_t blocktype;
-      size_t n_instructions_then;
-      struct Instr* instructions_then;
-      size_t n_instructions_else;
-      struct Instr* instructions_else;
+      uint32_t else_; // Same as end for one-armed ifs.
+      uint32_t end;
     } if_;
     struct BrIfExtra
     {
@@ -346,8 +352,8 @@ struct Instr
     } br, br_if;
     struct
     {
+      uint32_t* labelidxs; // Points into the labels of the function.
       uint32_t n_labelidxs;
-      uint32_t* labelidxs;
       uint32_t labelidx;
     } br_table;
     struct
@@ -396,8 +402,6 @@ struct Instr
 void
 init_instruction(struct Instr* instr);
 void
-free_instruction(struct Instr* instr);
-void
 free_instructions(struct Instr* instructions, size_t n_instructions);
 
 #define TypeSectionType FuncType
@@ -504,6 +508,8 @@ struct CodeSection
     } * locals;
     size_t n_instructions;
     struct Instr* instructions;
+    uint32_t* labels; // Label indices of all br_table, in order.
+    uint64_t hash; // Of the body bytes, see hash_bytes().
   } * codes;
 };
 
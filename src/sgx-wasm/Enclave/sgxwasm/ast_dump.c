@@ -83,29 +83,17 @@ dump_instruction(const struct Instr* instruction, int indent)
              sps,
              "",
              instruction->data.block.blocktype);
-      /*dump_instructions(instruction->data.block.instructions,
-                        instruction->data.block.n_instructions,
-                        indent + 1);*/
       break;
     case OPCODE_LOOP:
       printf(
         "%*sloop 0x%02" PRIx8 "\n", sps, "", instruction->data.loop.blocktype);
-      /*dump_instructions(instruction->data.loop.instructions,
-                        instruction->data.loop.n_instructions,
-                        indent + 1);*/
       break;
     case OPCODE_IF:
       printf(
         "%*sif 0x%02" PRIx8 "\n", sps, "", instruction->data.if_.blocktype);
-      /*dump_instructions(instruction->data.if_.instructions_then,
-                        instruction->data.if_.n_instructions_then,
-                        indent + 1);*/
       break;
     case OPCODE_ELSE:
       printf("%*selse\n", sps, "");
-      /*dump_instructions(instruction->data.if_.instructions_else,
-                        instruction->data.if_.n_instructions_else,
-                        indent + 1);*/
       break;
     case OPCODE_BR:
       printf("%*sbr 0x%" PRIx32 "\n", sps, "", instruction->data.br.labelidx);
@@ -0,0 +1,416 @@
+#include <sgxwasm/cache.h>
+#include <sgxwasm/util.h>
+
+#if __SGX__
+#include "sgx_tcrypto.h"
+#include "sgx_tseal.h"
+#else
+#include <openssl/evp.h>
+#endif
+
+#define CODE_CACHE_MAGIC 0x43435753 // "SWCC"
+#define CODE_CACHE_VERSION 6
+
+// Chunk size for writing the blob out (keeps each ocall buffer small).
+#define CODE_CACHE_WRITE_CHUNK 0x10000
+
+// SHA-256 of the key: sgx_tcrypto in the enclave, OpenSSL outside. A
+// failed update is remembered and fails sha256_final.
+
+struct Sha256
+{
+#if __SGX__
+  sgx_sha_state_handle_t handle;
+#else
+  EVP_MD_CTX* handle;
+#endif
+  int ok;
+};
+
+#if __SGX__
+static int
+sha256_init(struct Sha256* sha)
+{
+  sha->ok = sgx_sha256_init(&sha->handle) == SGX_SUCCESS;
+  return sha->ok;
+}
+
+static void
+sha256_update(struct Sha256* sha, const void* data, size_t size)
+{
+  if (sha->ok &&
+      sgx_sha256_update(data, (uint32_t)size, sha->handle) != SGX_SUCCESS) {
+    sha->ok = 0;
+  }
+}
+
+static int
+sha256_final(struct Sha256* sha, uint8_t* digest)
+{
+  sgx_sha256_hash_t* hash = (sgx_sha256_hash_t*)digest;
+  if (sha->ok && sgx_sha256_get_hash(sha->handle, hash) != SGX_SUCCESS) {
+    sha->ok = 0;
+  }
+  sgx_sha256_close(sha->handle);
+  return sha->ok;
+}
+#else
+static int
+sha256_init(struct Sha256* sha)
+{
+  sha->handle = EVP_MD_CTX_new();
+  sha->ok = sha->handle != NULL &&
+            EVP_DigestInit_ex(sha->handle, EVP_sha256(), NULL);
+  if (!sha->ok) {
+    EVP_MD_CTX_free(sha->handle);
+  }
+  return sha->ok;
+}
+
+static void
+sha256_update(struct Sha256* sha, const void* data, size_t size)
+{
+  if (sha->ok && !EVP_DigestUpdate(sha->handle, data, size)) {
+    sha->ok = 0;
+  }
+}
+
+static int
+sha256_final(struct Sha256* sha, uint8_t* digest)
+{
+  if (sha->ok && !EVP_DigestFinal_ex(sha->handle, digest, NULL)) {
+    sha->ok = 0;
+  }
+  EVP_MD_CTX_free(sha->handle);
+  return sha->ok;
+}
+#endif
+
+// End of SHA-256.
+
+int
+sgxwasm_cache_key(struct CodeCacheKey* key, const char* buf, size_t size,
+                  struct PassManager* pm, struct SystemConfig* config,
+                  const struct HardeningProfile* profile)
+{
+  struct Sha256 sha;
+  size_t i;
+  // Build options that change the generated code.
+  const int64_t options[] = { CODE_CACHE_VERSION,
+                              sizeof(struct MemoryRef),
+                              UnitSize,
+                              __OPT_INIT_STACK__,
+                              __PIN_MEM_BASE__,
+                              SGXWASM_MEMORY_BOUNDS_CHECK,
+                              __DIRECT_CALL__,
+                              __BR_JUMP_TABLE__,
+                              BR_JUMP_TABLE_MIN,
+                              FIX_SIZE_ASLR,
+                              FIX_SIZE_UNIT,
+                              TSX_SUPPORT,
+                              LSPECTRE_MASK,
+                              VARYS_MAGIC,
+                              VARYS_THRESHOLD };
+
+  if (!sha256_init(&sha)) {
+    return 0;
+  }
+  sha256_update(&sha, buf, size);
+  for (i = 0; i < pm->size; i++) {
+    const char* name = pm->data[i].name;
+    sha256_update(&sha, name, strlen(name) + 1);
+  }
+  sha256_update(&sha, &config->tsx_support, sizeof(config->tsx_support));
+  if (profile) {
+    for (i = 0; i < profile->entries.size; i++) {
+      const struct ProfileEntry* entry = &profile->entries.data[i];
+      if (entry->name) {
+        sha256_update(&sha, entry->name, strlen(entry->name) + 1);
+      }
+      sha256_update(&sha, &entry->hash, sizeof(entry->hash));
+      sha256_update(&sha, &entry->hardening, sizeof(entry->hardening));
+    }
+  }
+  sha256_update(&sha, options, sizeof(options));
+  return sha256_final(&sha, key->digest);
+}
+
+static void
+cache_path(const struct CodeCacheKey* key, char* path, size_t path_size)
+{
+  char hex[2 * 8 + 1];
+  size_t i;
+  for (i = 0; i < 8; i++) {
+    snprintf(&hex[2 * i], 3, "%02x", key->digest[i]);
+  }
+  snprintf(path, path_size, "%s/sgxwasm-%s.cache", SGXWASM_CODE_CACHE_DIR,
+           hex);
+}
+
+struct CacheHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  uint8_t key[CODE_CACHE_KEY_SIZE];
+  uint64_t n_funcs;
+};
+
+struct CacheFunction
+{
+  uint64_t code_size;
+  uint64_t n_memrefs;
+};
+
+static char*
+serialize(const struct CodeCacheKey* key, const struct CompileResult* results,
+          size_t n, size_t* out_size)
+{
+  struct CacheHeader header;
+  size_t size = sizeof(struct CacheHeader);
+  size_t i;
+  char *blob, *p;
+
+  for (i = 0; i < n; i++) {
+    size += sizeof(struct CacheFunction) + results[i].code_size +
+            results[i].memrefs.size * sizeof(struct MemoryRef);
+  }
+  blob = malloc(size);
+  if (!blob) {
+    return NULL;
+  }
+
+  header.magic = CODE_CACHE_MAGIC;
+  header.version = CODE_CACHE_VERSION;
+  memcpy(header.key, key->digest, CODE_CACHE_KEY_SIZE);
+  header.n_funcs = n;
+  memcpy(blob, &header, sizeof(header));
+  p = blob + sizeof(header);
+
+  for (i = 0; i < n; i++) {
+    const struct CompileResult* result = &results[i];
+    struct CacheFunction f;
+    size_t memrefs_size = result->memrefs.size * sizeof(struct MemoryRef);
+    f.code_size = result->code_size;
+    f.n_memrefs = result->memrefs.size;
+    memcpy(p, &f, sizeof(f));
+    p += sizeof(f);
+    memcpy(p, result->unmapped, result->code_size);
+    p += result->code_size;
+    if (memrefs_size) {
+      memcpy(p, result->memrefs.data, memrefs_size);
+      p += memrefs_size;
+    }
+  }
+  assert((size_t)(p - blob) == size);
+
+  *out_size = size;
+  return blob;
+}
+
+static int
+deserialize(const struct CodeCacheKey* key, const char* blob, size_t size,
+            struct CompileResult* results, size_t n)
+{
+  struct CacheHeader header;
+  const char* p = blob;
+  const char* end = blob + size;
+  size_t i;
+
+  if (size < sizeof(header)) {
+    return 0;
+  }
+  memcpy(&header, p, sizeof(header));
+  p += sizeof(header);
+  if (header.magic != CODE_CACHE_MAGIC ||
+      header.version != CODE_CACHE_VERSION ||
+      memcmp(header.key, key->digest, CODE_CACHE_KEY_SIZE) != 0 ||
+      header.n_funcs != n) {
+    return 0;
+  }
+
+  for (i = 0; i < n; i++) {
+    struct CompileResult* result = &results[i];
+    struct CacheFunction f;
+    size_t memrefs_size;
+
+    if ((size_t)(end - p) < sizeof(f)) {
+      goto error;
+    }
+    memcpy(&f, p, sizeof(f));
+    p += sizeof(f);
+    if (f.n_memrefs > SIZE_MAX / sizeof(struct MemoryRef)) {
+      goto error;
+    }
+    memrefs_size = f.n_memrefs * sizeof(struct MemoryRef);
+    if (f.code_size == 0 || (size_t)(end - p) < f.code_size ||
+        (size_t)(end - p) - f.code_size < memrefs_size) {
+      goto error;
+    }
+
+    result->unmapped = malloc(f.code_size);
+    if (!result->unmapped) {
+      goto error;
+    }
+    memcpy(result->unmapped, p, f.code_size);
+    result->code_size = f.code_size;
+    p += f.code_size;
+
+    if (memrefs_size) {
+      result->memrefs.data = malloc(memrefs_size);
+      if (!result->memrefs.data) {
+        goto error;
+      }
+      memcpy(result->memrefs.data, p, memrefs_size);
+      p += memrefs_size;
+    }
+    result->memrefs.capacity = f.n_memrefs;
+    result->memrefs.size = f.n_memrefs;
+  }
+  if (p != end) {
+    goto error;
+  }
+
+  return 1;
+
+error:
+  for (i = 0; i < n; i++) {
+    if (results[i].unmapped) {
+      free(results[i].unmapped);
+    }
+    if (results[i].memrefs.data) {
+      free(results[i].memrefs.data);
+    }
+    memset(&results[i], 0, sizeof(struct CompileResult));
+  }
+  return 0;
+}
+
+int
+sgxwasm_cache_load(const struct CodeCacheKey* key,
+                   struct CompileResult* results, size_t n)
+{
+  char path[256];
+  char* blob;
+  size_t size;
+  int ret;
+
+  cache_path(key, path, sizeof(path));
+  blob = sgxwasm_load_file(path, &size);
+  if (!blob) {
+    return 0;
+  }
+
+#if __SGX__
+  {
+    const sgx_sealed_data_t* sealed = (const sgx_sealed_data_t*)blob;
+    uint8_t mac_text[CODE_CACHE_KEY_SIZE];
+    uint32_t mac_size = sizeof(mac_text);
+    uint32_t plain_size;
+    char* plain;
+
+    if (size < sizeof(sgx_sealed_data_t) ||
+        sgx_get_add_mac_txt_len(sealed) != mac_size) {
+      sgxwasm_unload_file(blob, size);
+      return 0;
+    }
+    plain_size = sgx_get_encrypt_txt_len(sealed);
+    plain = malloc(plain_size);
+    if (!plain) {
+      sgxwasm_unload_file(blob, size);
+      return 0;
+    }
+    // The key is also bound as additional MAC text.
+    if (sgx_unseal_data(sealed, mac_text, &mac_size, (uint8_t*)plain,
+                        &plain_size) != SGX_SUCCESS ||
+        memcmp(mac_text, key->digest, CODE_CACHE_KEY_SIZE) != 0) {
+      free(plain);
+      sgxwasm_unload_file(blob, size);
+      return 0;
+    }
+    sgxwasm_unload_file(blob, size);
+    ret = deserialize(key, plain, plain_size, results, n);
+    free(plain);
+  }
+#else
+  ret = deserialize(key, blob, size, results, n);
+  sgxwasm_unload_file(blob, size);
+#endif
+
+  return ret;
+}
+
+int
+sgxwasm_cache_store(const struct CodeCacheKey* key,
+                    const struct CompileResult* results, size_t n)
+{
+  char path[256];
+  char* plain;
+  char* blob;
+  size_t size, offset;
+  FILE* f;
+  int ret = 1;
+
+  plain = serialize(key, results, n, &size);
+  if (!plain) {
+    return 0;
+  }
+
+#if __SGX__
+  {
+    sgx_attributes_t attribute_mask;
+    uint32_t sealed_size;
+
+    if (size > UINT32_MAX) {
+      free(plain);
+      return 0;
+    }
+    sealed_size = sgx_calc_sealed_data_size(CODE_CACHE_KEY_SIZE, size);
+    if (sealed_size == UINT32_MAX) {
+      free(plain);
+      return 0;
+    }
+    blob = malloc(sealed_size);
+    if (!blob) {
+      free(plain);
+      return 0;
+    }
+    attribute_mask.flags = TSEAL_DEFAULT_FLAGSMASK;
+    attribute_mask.xfrm = 0x0;
+    // Seal to this enclave build, whose passes produced the code.
+    if (sgx_seal_data_ex(SGX_KEYPOLICY_MRENCLAVE, attribute_mask,
+                         TSEAL_DEFAULT_MISCMASK, CODE_CACHE_KEY_SIZE,
+                         key->digest, size, (const uint8_t*)plain,
+                         sealed_size,
+                         (sgx_sealed_data_t*)blob) != SGX_SUCCESS) {
+      free(blob);
+      free(plain);
+      return 0;
+    }
+    free(plain);
+    size = sealed_size;
+  }
+#else
+  blob = plain;
+#endif
+
+  cache_path(key, path, sizeof(path));
+  f = fopen(path, "wb");
+  if (!f) {
+    free(blob);
+    return 0;
+  }
+  for (offset = 0; offset < size; offset += CODE_CACHE_WRITE_CHUNK) {
+    size_t chunk = size - offset;
+    if (chunk > CODE_CACHE_WRITE_CHUNK) {
+      chunk = CODE_CACHE_WRITE_CHUNK;
+    }
+    if (fwrite(blob + offset, 1, chunk, f) != chunk) {
+      ret = 0;
+      break;
+    }
+  }
+  fclose(f);
+  free(blob);
+
+  return ret;
+}
@@ -0,0 +1,46 @@
+#ifndef __SGXWASM__CACHE_H__
+#define __SGXWASM__CACHE_H__
+
+#include <sgxwasm/compile.h>
+#include <sgxwasm/config.h>
+#include <sgxwasm/pass.h>
+#include <sgxwasm/profile.h>
+#include <sgxwasm/sense.h>
+#include <sgxwasm/sys.h>
+
+// Load-time cache of synthesized code.
+//
+// The cache holds the output of the compiler and the passes for every
+// function (code before relocation and its memory references, which
+// carry the relocation entries and the code units). A warm start thus
+// skips compilation and only re-runs code placement and relocation, so
+// the layout is still randomized on every load.
+//
+// The entry is keyed by the module bytes, the enabled passes, the
+// hardening profile, the sensed system configuration and the build
+// options that change the generated code. For SGX, the blob is sealed
+// to the enclave identity (MRENCLAVE) before it leaves the enclave.
+
+#define CODE_CACHE_KEY_SIZE 32
+
+struct CodeCacheKey
+{
+  uint8_t digest[CODE_CACHE_KEY_SIZE];
+};
+
+// Returns 0 if the key could not be computed; the cache is then skipped.
+int
+sgxwasm_cache_key(struct CodeCacheKey*, const char*, size_t,
+                  struct PassManager*, struct SystemConfig*,
+                  const struct HardeningProfile*);
+
+// Fill the results of n functions from the cache. Returns 0 on a miss.
+int
+sgxwasm_cache_load(const struct CodeCacheKey*, struct CompileResult*, size_t);
+
+// Returns 0 if the entry could not be written.
+int
+sgxwasm_cache_store(const struct CodeCacheKey*, const struct CompileResult*,
+                    size_t);
+
+#endif
@@ -1,5 +1,6 @@
 #include <sgxwasm/compile.h>
 #include <sgxwasm/config.h>
+#include <sgxwasm/loadtime.h>
 #include <sgxwasm/pass.h>
 #include <sgxwasm/sys.h>
 
@@ -17,6 +18,10 @@
 
 #define FUNC_EXIT_CONT SIZE_MAX
 
+// Registers entry functions save for the host below their frame:
+// MemBaseReg with __PIN_MEM_BASE__, PredicateReg with LSPECTRE_MASK.
+#define ENTRY_SAVED_REGS (__PIN_MEM_BASE__ + (__LSPECTRE__ && LSPECTRE_MASK))
+
 DEFINE_VECTOR_GROW(memrefs, struct MemoryReferences);
 
 static DEFINE_VECTOR_INIT(stack, struct StackState);
@@ -275,6 +280,18 @@ end:
 //#endif
 
 #if __PASS__
+#if SGXWASM_LOADTIME_PROFILE > 1
+#define HOOK_PROFILE_START(ctx)                                                \
+  struct LoadTimeSpan span;                                                    \
+  sgxwasm_loadtime_start(&span, output(ctx)->size)
+#define HOOK_PROFILE_END(ctx, func, i, hook)                                   \
+  sgxwasm_loadtime_hook((func)->fun_index, (i), (hook), &span,                 \
+                        output(ctx)->size)
+#else
+#define HOOK_PROFILE_START(ctx)
+#define HOOK_PROFILE_END(ctx, func, i, hook)
+#endif
+
 static void
 passes_function_start(struct CompilerContext* ctx)
 {
@@ -287,7 +304,9 @@ passes_function_start(struct CompilerContext* ctx)
     if (!pass->function_start) {
       continue;
     }
+    HOOK_PROFILE_START(ctx);
     (pass->function_start)(ctx, func);
+    HOOK_PROFILE_END(ctx, func, i, LOADTIME_FUNCTION_START);
   }
 }
 
@@ -303,7 +322,9 @@ passes_function_end(struct CompilerContext* ctx)
     if (!pass->function_end) {
       continue;
     }
+    HOOK_PROFILE_START(ctx);
     (pass->function_end)(ctx, func);
+    HOOK_PROFILE_END(ctx, func, i, LOADTIME_FUNCTION_END);
   }
 }
 
@@ -320,7 +341,9 @@ passes_control_start(struct CompilerContext* ctx, control_type_t type)
     if (!pass->control_start) {
       continue;
     }
+    HOOK_PROFILE_START(ctx);
     (pass->control_start)(ctx, func, type, depth);
+    HOOK_PROFILE_END(ctx, func, i, LOADTIME_CONTROL_START);
   }
 }
 
@@ -339,7 +362,9 @@ passes_control_end(struct CompilerContext* ctx, control_type_t type)
     if (!pass->control_end) {
       continue;
     }
+    HOOK_PROFILE_START(ctx);
     (pass->control_end)(ctx, func, type, depth);
+    HOOK_PROFILE_END(ctx, func, i, LOADTIME_CONTROL_END);
   }
 }
 
@@ -356,7 +381,9 @@ passes_instruction_start(struct CompilerContext* ctx)
     if (!pass->instruction_start) {
       continue;
     }
+    HOOK_PROFILE_START(ctx);
     (pass->instruction_start)(ctx, func, instr);
+    HOOK_PROFILE_END(ctx, func, i, LOADTIME_INSTRUCTION_START);
   }
 }
 
@@ -373,7 +400,9 @@ passes_instruction_end(struct CompilerContext* ctx)
     if (!pass->instruction_end) {
       continue;
     }
+    HOOK_PROFILE_START(ctx);
     (pass->instruction_end)(ctx, func, instr);
+    HOOK_PROFILE_END(ctx, func, i, LOADTIME_INSTRUCTION_END);
   }
 }
 
@@ -390,8 +419,14 @@ passes_machine_inst_start(struct CompilerContext* ctx,
     if (!pass->machine_inst_start) {
       continue;
     }
+    HOOK_PROFILE_START(ctx);
     (pass->machine_inst_start)(ctx, func, minstr);
+    HOOK_PROFILE_END(ctx, func, i, LOADTIME_MACHINE_INST_START);
   }
+  minstr->offset = pc_offset(output(ctx));
+  minstr->size = 0;
+  minstr->jump = JumpNone;
+  minstr->cond = COND_NONE;
 }
 
 static void
@@ -402,13 +437,35 @@ passes_machine_inst_end(struct CompilerContext* ctx,
   struct PassManager* pm = ctx->pm;
   const struct Function* func = ctx->func;
   size_t i;
+  minstr->size = pc_offset(output(ctx)) - minstr->offset;
+  if (!VECTOR_GROW(&ctx->minstrs)) {
+    assert(0);
+  }
+  ctx->minstrs.data[ctx->minstrs.size - 1] = *minstr;
   for (i = 0; i < pm->size; i++) {
     struct Pass* pass = &pm->data[i];
     if (!pass->machine_inst_end) {
       continue;
     }
+    HOOK_PROFILE_START(ctx);
     (pass->machine_inst_end)(ctx, func, minstr);
+    HOOK_PROFILE_END(ctx, func, i, LOADTIME_MACHINE_INST_END);
+  }
+}
+
+// Records the jmp or jcc (cond is not COND_NONE) emitted from offset
+// start as the end of minstr.
+static void
+set_jump(struct CompilerContext* ctx, struct MachineInstr* minstr,
+         size_t start, condition_t cond)
+{
+  size_t size = pc_offset(output(ctx)) - start;
+  if (cond == COND_NONE) {
+    minstr->jump = size == 2 ? JumpShort : JumpNear;
+  } else {
+    minstr->jump = size == 2 ? JccShort : JccNear;
   }
+  minstr->cond = cond;
 }
 #endif
 
@@ -445,6 +502,7 @@ uncond_jmp(struct CompilerContext* ctx, label_t* label, uint32_t depth,
 #endif
   num_low_instrs(ctx) += emit_jmp_label(output(ctx), label, distance);
 #if __PASS__
+  set_jump(ctx, &minstr, minstr.offset, COND_NONE);
   passes_machine_inst_end(ctx, &minstr);
 #endif
 }
@@ -462,9 +520,13 @@ cond_jmp(struct CompilerContext* ctx, condition_t cond, label_t* label,
   minstr.depth = depth;
   passes_machine_inst_start(ctx, &minstr);
 #endif
-  num_low_instrs(ctx) +=
-    emit_cond_jump_rr(output(ctx), cond, label, type, lhs, rhs);
+  num_low_instrs(ctx) += emit_cond_compare_rr(output(ctx), type, lhs, rhs);
+#if __PASS__
+  size_t start = pc_offset(output(ctx));
+#endif
+  num_low_instrs(ctx) += emit_jcc(output(ctx), cond, label, Far);
 #if __PASS__
+  set_jump(ctx, &minstr, start, cond);
   passes_machine_inst_end(ctx, &minstr);
 #endif
 }
@@ -482,9 +544,13 @@ br_table_cond_jmp(struct CompilerContext* ctx, condition_t cond, label_t* label,
   minstr.max = max;
   passes_machine_inst_start(ctx, &minstr);
 #endif
-  num_low_instrs(ctx) +=
-    emit_cond_jump_rr(output(ctx), cond, label, type, lhs, rhs);
+  num_low_instrs(ctx) += emit_cond_compare_rr(output(ctx), type, lhs, rhs);
 #if __PASS__
+  size_t start = pc_offset(output(ctx));
+#endif
+  num_low_instrs(ctx) += emit_jcc(output(ctx), cond, label, Far);
+#if __PASS__
+  set_jump(ctx, &minstr, start, cond);
   passes_machine_inst_end(ctx, &minstr);
 #endif
 }
@@ -501,6 +567,7 @@ br_table_uncond_jmp(struct CompilerContext* ctx, label_t* label, uint32_t depth)
 #endif
   num_low_instrs(ctx) += emit_jmp_label(output(ctx), label, Far);
 #if __PASS__
+  set_jump(ctx, &minstr, minstr.offset, COND_NONE);
   passes_machine_inst_end(ctx, &minstr);
 #endif
 }
@@ -603,6 +670,8 @@ load_const_to_reg(struct CompilerContext* ctx, sgxwasm_register_t reg,
 }
 
 // Wrapper of LoadConstant.
+// Calls the function in addr, or with a direct call patched by
+// RELO_CALL_REL if addr is REG_UNKNOWN.
 __attribute__((unused)) static void
 call_function(struct CompilerContext* ctx, sgxwasm_register_t addr,
               size_t fun_index)
@@ -613,6 +682,29 @@ call_function(struct CompilerContext* ctx, sgxwasm_register_t addr,
   minstr.type = CallFunction;
   minstr.fun_index = fun_index;
   passes_machine_inst_start(ctx, &minstr);
+#endif
+  if (addr == REG_UNKNOWN) {
+    struct MemoryRef* memref = new_memref(ctx->memrefs);
+    num_low_instrs(ctx) += emit_call_32(output(ctx), 0);
+    memref->type = MEMREF_FUNC_REL;
+    memref->code_offset = output(ctx)->size - 4;
+    memref->idx = fun_index;
+  } else {
+    num_low_instrs(ctx) += emit_call_r(output(ctx), addr);
+  }
+#if __PASS__
+  passes_machine_inst_end(ctx, &minstr);
+#endif
+}
+
+__attribute__((unused)) static void
+call_runtime(struct CompilerContext* ctx, sgxwasm_register_t addr)
+{
+#if __PASS__
+  struct MachineInstr minstr;
+  minstr.instr = compile_state(ctx)->instr;
+  minstr.type = CallRuntime;
+  passes_machine_inst_start(ctx, &minstr);
 #endif
   num_low_instrs(ctx) += emit_call_r(output(ctx), addr);
 #if __PASS__
@@ -638,6 +730,178 @@ low_return(struct CompilerContext* ctx)
 
 // End of machine-level hooks.
 
+// Machine-instruction buffer.
+
+const struct MachineInstr*
+last_jump(struct CompilerContext* ctx)
+{
+  size_t i = ctx->minstrs.size;
+  const struct MachineInstr* minstr;
+  // Skip the labels bound at the end of the output.
+  while (i > 0 && ctx->minstrs.data[i - 1].size == 0) {
+    i--;
+  }
+  if (i == 0) {
+    return NULL;
+  }
+  minstr = &ctx->minstrs.data[i - 1];
+  if (minstr->jump == JumpNone ||
+      minstr->offset + minstr->size != pc_offset(output(ctx))) {
+    return NULL;
+  }
+  return minstr;
+}
+
+static size_t
+jump_size(uint8_t jump)
+{
+  switch (jump) {
+    case JumpShort:
+    case JccShort:
+      return 2;
+    case JumpNear:
+      return 5;
+    case JccNear:
+      return 6;
+    default:
+      return 0;
+  }
+}
+
+uint8_t
+drop_last_jump(struct CompilerContext* ctx, condition_t* cond)
+{
+  struct MachineInstr* minstr = (struct MachineInstr*)last_jump(ctx);
+  uint8_t jump;
+  if (!minstr) {
+    return JumpNone;
+  }
+  jump = minstr->jump;
+  output_buf_shrink(output(ctx), jump_size(jump));
+  minstr->size -= jump_size(jump);
+  if (cond) {
+    *cond = minstr->cond;
+  }
+  minstr->jump = JumpNone;
+  minstr->cond = COND_NONE;
+  return jump;
+}
+
+uint8_t
+widen_last_jump(struct CompilerContext* ctx)
+{
+  struct MachineInstr* minstr = (struct MachineInstr*)last_jump(ctx);
+  struct SizedBuffer* out = output(ctx);
+  if (!minstr) {
+    return JumpNone;
+  }
+  if (minstr->jump == JumpShort) {
+    // eb XX -> e9 XX 00 00 00, keeping XX for a near-linked label.
+    out->data[pc_offset(out) - 2] = 0xe9;
+    emit_imm(out, 0, 3);
+    minstr->size += 3;
+    minstr->jump = JumpNear;
+  } else if (minstr->jump == JccShort) {
+    // 7c XX -> 0f 8c 00 00 00 00, only emitted for bound labels.
+    out->data[pc_offset(out) - 2] = 0x0f;
+    out->data[pc_offset(out) - 1] = 0x80 | minstr->cond;
+    emit_imm(out, 0, 4);
+    minstr->size += 4;
+    minstr->jump = JccNear;
+  }
+  return minstr->jump;
+}
+
+void
+emit_pass_jump(struct CompilerContext* ctx, condition_t cond)
+{
+  struct MachineInstr* minstr;
+  size_t start = pc_offset(output(ctx));
+  if (cond == COND_NONE) {
+    emit_jmp_32(output(ctx), 0);
+  } else {
+    label_t label = { 0, 0 };
+    emit_jcc(output(ctx), cond, &label, Far);
+  }
+  if (!VECTOR_GROW(&ctx->minstrs)) {
+    assert(0);
+  }
+  minstr = &ctx->minstrs.data[ctx->minstrs.size - 1];
+  memset(minstr, 0, sizeof(struct MachineInstr));
+  minstr->instr = compile_state(ctx)->instr;
+  minstr->type = cond == COND_NONE ? UcondBranch : CondBranch;
+  minstr->offset = start;
+  minstr->size = pc_offset(output(ctx)) - start;
+  minstr->jump = cond == COND_NONE ? JumpNear : JccNear;
+  minstr->cond = cond;
+}
+
+void
+take_code_tail(struct CompilerContext* ctx, size_t offset, size_t first_memref,
+               struct CodeTail* tail)
+{
+  size_t i = ctx->minstrs.size;
+  assert(offset <= pc_offset(output(ctx)));
+  tail->offset = offset;
+  tail->size = pc_offset(output(ctx)) - offset;
+  tail->data = NULL;
+  tail->first_memref = first_memref;
+  tail->end_memref = ctx->memrefs->size;
+  tail->n_minstrs = 0;
+  tail->minstrs = NULL;
+  if (tail->size == 0) {
+    return;
+  }
+  tail->data = malloc(tail->size);
+  assert(tail->data != NULL);
+  memcpy(tail->data, output(ctx)->data + offset, tail->size);
+  output_buf_shrink(output(ctx), tail->size);
+
+  while (i > 0 && ctx->minstrs.data[i - 1].offset >= offset) {
+    i--;
+  }
+  tail->n_minstrs = ctx->minstrs.size - i;
+  if (tail->n_minstrs) {
+    tail->minstrs = malloc(tail->n_minstrs * sizeof(struct MachineInstr));
+    assert(tail->minstrs != NULL);
+    memcpy(tail->minstrs, &ctx->minstrs.data[i],
+           tail->n_minstrs * sizeof(struct MachineInstr));
+    ctx->minstrs.size = i;
+  }
+}
+
+void
+put_code_tail(struct CompilerContext* ctx, struct CodeTail* tail)
+{
+  struct MemoryReferences* memrefs = ctx->memrefs;
+  size_t offset = pc_offset(output(ctx));
+  size_t delta = offset - tail->offset;
+  size_t i;
+  if (tail->size == 0) {
+    return;
+  }
+  assert(offset >= tail->offset);
+  output_buf(output(ctx), tail->data, tail->size);
+  for (i = tail->first_memref; i < tail->end_memref; i++) {
+    struct MemoryRef* memref = &memrefs->data[i];
+    if (memref->code_offset >= tail->offset &&
+        memref->code_offset < tail->offset + tail->size) {
+      memref->code_offset += delta;
+    }
+  }
+  for (i = 0; i < tail->n_minstrs; i++) {
+    if (!VECTOR_GROW(&ctx->minstrs)) {
+      assert(0);
+    }
+    tail->minstrs[i].offset += delta;
+    ctx->minstrs.data[ctx->minstrs.size - 1] = tail->minstrs[i];
+  }
+  free(tail->data);
+  free(tail->minstrs);
+  tail->data = NULL;
+  tail->minstrs = NULL;
+}
+
 __attribute__((unused)) static unsigned
 peek_stack(struct CacheState* cache_state)
 {
@@ -1093,7 +1357,7 @@ execute_moves(struct CompilerContext* ctx,
     int offset = next_spill_spot * StackSlotSize * -1 - StackOffset;
     if (!mem_tracer_grow(mem_tracer(ctx)))
       assert(0);
-    record_memory_access(mem_tracer(ctx), c->cont, c->type,
+    record_memory_access(mem_tracer(ctx), instr_id(ctx), c->type,
                          control_depth(control(ctx)), MEM_ACCESS_WRITE,
                          MEM_STACK, offset);
 #endif
@@ -1144,7 +1408,7 @@ execute_loads(struct CompilerContext* ctx,
         int offset = load->stack_index * StackSlotSize * -1 - StackOffset;
         if (!mem_tracer_grow(mem_tracer(ctx)))
           assert(0);
-        record_memory_access(mem_tracer(ctx), c->cont, c->type,
+        record_memory_access(mem_tracer(ctx), instr_id(ctx), c->type,
                              control_depth(control(ctx)), MEM_ACCESS_READ,
                              MEM_STACK, offset);
 #endif
@@ -1190,14 +1454,14 @@ move_stack_value(struct CompilerContext* ctx, int dst_idx, int src_idx,
   if (!mem_tracer_grow(mem_tracer(ctx)))
     assert(0);
   offset = src_idx * StackSlotSize * -1 - StackOffset;
-  record_memory_access(mem_tracer(ctx), c->cont, c->type,
+  record_memory_access(mem_tracer(ctx), instr_id(ctx), c->type,
                        control_depth(control(ctx)), MEM_ACCESS_READ, MEM_STACK,
                        offset);
   // Record Spill
   if (!mem_tracer_grow(mem_tracer(ctx)))
     assert(0);
   offset = dst_idx * StackSlotSize * -1 - StackOffset;
-  record_memory_access(mem_tracer(ctx), c->cont, c->type,
+  record_memory_access(mem_tracer(ctx), instr_id(ctx), c->type,
                        control_depth(control(ctx)), MEM_ACCESS_WRITE, MEM_STACK,
                        offset);
 #endif
@@ -1240,7 +1504,7 @@ transfer_stack_slot(struct CompilerContext* ctx,
           int offset = dst_idx * StackSlotSize * -1 - StackOffset;
           if (!mem_tracer_grow(mem_tracer(ctx)))
             assert(0);
-          record_memory_access(mem_tracer(ctx), c->cont, c->type,
+          record_memory_access(mem_tracer(ctx), instr_id(ctx), c->type,
                                control_depth(control(ctx)), MEM_ACCESS_WRITE,
                                MEM_STACK, offset);
 #endif
@@ -1255,7 +1519,7 @@ transfer_stack_slot(struct CompilerContext* ctx,
           int offset = dst_idx * StackSlotSize * -1 - StackOffset;
           if (!mem_tracer_grow(mem_tracer(ctx)))
             assert(0);
-          record_memory_access(mem_tracer(ctx), c->cont, c->type,
+          record_memory_access(mem_tracer(ctx), instr_id(ctx), c->type,
                                control_depth(control(ctx)), MEM_ACCESS_WRITE,
                                MEM_STACK, offset);
 #endif
@@ -1314,6 +1578,7 @@ init_compiler_context(struct CompilerContext* ctx, const struct Function* func,
   ctx->compile_state.instr_id = 0;
   ctx->compile_state.instr_list = NULL;
   ctx->compile_state.n_instrs = 0;
+  ctx->compile_state.next = 0;
   ctx->num_used_spill_slots = 0;
   memcpy(&ctx->sig, fun_type, sizeof(struct FuncType));
   ctx->num_locals = num_locals;
@@ -1325,6 +1590,10 @@ init_compiler_context(struct CompilerContext* ctx, const struct Function* func,
     ctx->max_memory_size = 0;
   }
   ctx->num_low_instrs = 0;
+  ctx->flags = 0;
+  VECTOR_INIT(&ctx->minstrs);
+  VECTOR_INIT(&ctx->pending_jumps);
+  ctx->pending_scanned = memrefs ? memrefs->size : 0;
 #if MEMORY_TRACE
   mem_tracer_init(&ctx->mem_tracer);
 #endif
@@ -1339,36 +1608,49 @@ free_compiler_context(struct CompilerContext* ctx)
   if (ctx->ool_list.data) {
     free(ctx->ool_list.data);
   }
+  free(ctx->minstrs.data);
+  free(ctx->pending_jumps.data);
 }
 
 // End of definition of CompilerContext
 
 // Implementation of compile state.
 
-static void
-update_compile_state(struct CompilerContext* ctx)
-{
-  struct ControlBlock* c = control_at(control(ctx), 0);
-  struct CompileState* state = compile_state(ctx);
-  state->instr_list = c->instructions;
-  state->n_instrs = c->n_instructions;
-}
-
 static const struct Instr*
 get_next_instr(struct CompilerContext* ctx)
 {
-  struct ControlBlock* c = control_at(control(ctx), 0);
   struct CompileState* state = compile_state(ctx);
-  size_t* count = &c->cont;
-  if (*count >= state->n_instrs) {
+  if (state->next >= state->n_instrs) {
     return NULL;
   }
-  state->instr = &state->instr_list[*count];
-  state->instr_id = *count;
-  (*count)++;
+  state->instr = &state->instr_list[state->next];
+  state->instr_id = state->next;
+  state->next++;
   return state->instr;
 }
 
+// Continues after the END of the block that starts at instr.
+static void
+skip_block(struct CompilerContext* ctx, const struct Instr* instr)
+{
+  uint32_t end;
+  switch (instr->opcode) {
+    case OPCODE_BLOCK:
+      end = instr->data.block.end;
+      break;
+    case OPCODE_LOOP:
+      end = instr->data.loop.end;
+      break;
+    case OPCODE_IF:
+      end = instr->data.if_.end;
+      break;
+    default:
+      return;
+  }
+  assert(end > instr_id(ctx) && end < num_instrs(ctx));
+  compile_state(ctx)->next = end + 1;
+}
+
 // End of compile state.
 
 __attribute__((unused)) static void
@@ -1390,7 +1672,7 @@ spill(struct CompilerContext* ctx, uint32_t index)
       int offset = index * StackSlotSize * -1 - StackOffset;
       if (!mem_tracer_grow(mem_tracer(ctx)))
         assert(0);
-      record_memory_access(mem_tracer(ctx), c->cont, c->type,
+      record_memory_access(mem_tracer(ctx), instr_id(ctx), c->type,
                            control_depth(control(ctx)), MEM_ACCESS_WRITE,
                            MEM_STACK, offset);
 #endif
@@ -1405,7 +1687,7 @@ spill(struct CompilerContext* ctx, uint32_t index)
       int offset = index * StackSlotSize * -1 - StackOffset;
       if (!mem_tracer_grow(mem_tracer(ctx)))
         assert(0);
-      record_memory_access(mem_tracer(ctx), c->cont, c->type,
+      record_memory_access(mem_tracer(ctx), instr_id(ctx), c->type,
                            control_depth(control(ctx)), MEM_ACCESS_WRITE,
                            MEM_STACK, offset);
 #endif
@@ -1436,7 +1718,7 @@ spill_register(struct CompilerContext* ctx, sgxwasm_register_t reg)
   } else {
     struct ControlBlock* c =
       &control(ctx)->data[control_depth(control(ctx)) - 1];
-    cont = c->cont;
+    cont = instr_id(ctx);
     type = c->type;
   }
 #endif
@@ -1580,7 +1862,7 @@ pop_to_register(struct CompilerContext* ctx, reglist_t pinned)
       int offset = index * StackSlotSize * -1 - StackOffset;
       if (!mem_tracer_grow(mem_tracer(ctx)))
         assert(0);
-      record_memory_access(mem_tracer(ctx), c->cont, c->type,
+      record_memory_access(mem_tracer(ctx), instr_id(ctx), c->type,
                            control_depth(control(ctx)), MEM_ACCESS_READ,
                            MEM_STACK, offset);
 #endif
@@ -1634,7 +1916,8 @@ add_pair(struct RegisterReuseMap* map, sgxwasm_register_t src,
   if (previous == dst) {
     return;
   }
-  if (!reusemap_grow(map)) {
+  // Each pair takes two slots.
+  if (!reusemap_grow(map) || !reusemap_grow(map)) {
     assert(0);
   }
   map->data[map->size - 2] = src;
@@ -2033,6 +2316,16 @@ return_impl(struct CompilerContext* ctx)
   // Leave frame.
   num_low_instrs(ctx) += Move(output(ctx), GP_RSP, GP_RBP, VALTYPE_I64);
   num_low_instrs(ctx) += emit_popq_r(output(ctx), GP_RBP);
+#if __LSPECTRE__ && LSPECTRE_MASK
+  if (is_entry(ctx)) {
+    num_low_instrs(ctx) += emit_popq_r(output(ctx), PredicateReg);
+  }
+#endif
+#if __PIN_MEM_BASE__
+  if (is_entry(ctx)) {
+    num_low_instrs(ctx) += emit_popq_r(output(ctx), MemBaseReg);
+  }
+#endif
 
   // XXX: We assume the return without popping additional bytes for now.
   // emit_ret(output(ctx), 0);
@@ -2112,6 +2405,60 @@ generate_br_table(struct CompilerContext* ctx, sgxwasm_register_t tmp,
                     br_targets);
 }
 
+// Jump table lowering: an indirect jmp through a table of table_count
+// slots emitted inline, followed by one case per distinct target. The
+// bounds check is done by the caller. relocate() fills the slots with
+// the absolute addresses of the cases, which are matched by the index
+// of the br_table and the depth of the case.
+static void
+generate_br_jump_table(struct CompilerContext* ctx, sgxwasm_register_t tmp,
+                       sgxwasm_register_t value, uint32_t* table,
+                       uint32_t table_count, label_t* br_targets)
+{
+  struct MemoryRef* memref;
+  struct Operand op;
+  uint64_t id = (uint64_t)instr_id(ctx) << 32;
+  uint32_t i;
+
+  load_from_memory(ctx, tmp, MEMREF_JUMP_TABLE, id);
+  // Clear the upper half of the index.
+  num_low_instrs(ctx) += emit_mov_rr(output(ctx), value, value, VALTYPE_I32);
+  build_operand(&op, tmp, value, SCALE_8, 0);
+#if __PASS__
+  struct MachineInstr minstr;
+  minstr.instr = compile_state(ctx)->instr;
+  minstr.type = JumpTableJmp;
+  minstr.min = 0;
+  minstr.max = table_count;
+  passes_machine_inst_start(ctx, &minstr);
+#endif
+  num_low_instrs(ctx) += emit_jmp_m(output(ctx), &op);
+#if __PASS__
+  passes_machine_inst_end(ctx, &minstr);
+#endif
+
+  for (i = 0; i < table_count; i++) {
+    memref = new_memref(ctx->memrefs);
+    memref->type = MEMREF_JUMP_TABLE_ENTRY;
+    memref->code_offset = pc_offset(output(ctx));
+    memref->idx = id | table[i];
+    emit_imm(output(ctx), -1, sizeof(uint64_t));
+  }
+
+  for (i = 0; i < table_count; i++) {
+    uint32_t depth = table[i];
+    if (is_bound(&br_targets[depth])) {
+      continue;
+    }
+    br_table_bind(ctx, &br_targets[depth], BrCaseTarget, 0, 0, depth);
+    memref = new_memref(ctx->memrefs);
+    memref->type = MEMREF_JUMP_TABLE_CASE;
+    memref->code_offset = pc_offset(output(ctx));
+    memref->idx = id | depth;
+    br_or_ret(ctx, depth);
+  }
+}
+
 static void
 set_local_from_stack_slot(struct CompilerContext* ctx,
                           struct StackSlot* dst_slot)
@@ -2128,7 +2475,7 @@ set_local_from_stack_slot(struct CompilerContext* ctx,
       int offset = index * StackSlotSize * -1 - StackOffset;
       if (!mem_tracer_grow(mem_tracer(ctx)))
         assert(0);
-      record_memory_access(mem_tracer(ctx), c->cont, c->type,
+      record_memory_access(mem_tracer(ctx), instr_id(ctx), c->type,
                            control_depth(control(ctx)), MEM_ACCESS_READ,
                            MEM_STACK, offset);
 #endif
@@ -2153,7 +2500,7 @@ set_local_from_stack_slot(struct CompilerContext* ctx,
   int offset = index * StackSlotSize * -1 - StackOffset;
   if (!mem_tracer_grow(mem_tracer(ctx)))
     assert(0);
-  record_memory_access(mem_tracer(ctx), c->cont, c->type,
+  record_memory_access(mem_tracer(ctx), instr_id(ctx), c->type,
                        control_depth(control(ctx)), MEM_ACCESS_READ, MEM_STACK,
                        offset);
 #endif
@@ -2225,7 +2572,7 @@ get_local(struct CompilerContext* ctx, size_t index)
       int offset = index * StackSlotSize * -1 - StackOffset;
       if (!mem_tracer_grow(mem_tracer(ctx)))
         assert(0);
-      record_memory_access(mem_tracer(ctx), c->cont, c->type,
+      record_memory_access(mem_tracer(ctx), instr_id(ctx), c->type,
                            control_depth(control(ctx)), MEM_ACCESS_READ,
                            MEM_STACK, offset);
 #endif
@@ -2309,7 +2656,7 @@ prepare_call(struct CompilerContext* ctx, const struct FuncType* fun_type,
     offset = idx * StackSlotSize * -1 - StackOffset;
     if (!mem_tracer_grow(mem_tracer(ctx)))
       assert(0);
-    record_memory_access(mem_tracer(ctx), c->cont, c->type,
+    record_memory_access(mem_tracer(ctx), instr_id(ctx), c->type,
                          control_depth(control(ctx)), MEM_ACCESS_WRITE,
                          MEM_STACK, offset);
 #endif
@@ -2426,6 +2773,14 @@ call_direct(struct CompilerContext* ctx, const struct ModuleTypes* module_types,
 
   prepare_call(ctx, fun_type, NULL);
 
+  // Imported functions may be outside of the code region.
+  if (__DIRECT_CALL__ &&
+      fun_index >= sgxwasm_get_module(ctx->func)->n_imported_funcs) {
+    call_function(ctx, REG_UNKNOWN, fun_index);
+    finish_call(ctx, fun_type);
+    return;
+  }
+
   addr =
     get_unused_register_with_class(ctx, GP_REG, EmptyRegList, EmptyRegList);
 
@@ -3291,50 +3646,13 @@ EmitBinOp(struct CompilerContext* ctx, sgxwasm_valtype_t src_type,
   push_register(ctx, result_type, dst);
 }
 
-// Try to de-duplicate the type id with the same signature.
-size_t
-dedup_type(const struct FuncTypeVector* type_table, size_t id)
-{
-  assert(id < type_table->size);
-  size_t i, j;
-  int found = 0;
-  struct FuncType target_type = type_table->data[id];
-  for (i = 0; i < id; i++) {
-    struct FuncType type = type_table->data[i];
-    if (target_type.n_inputs != type.n_inputs) {
-      continue;
-    }
-    for (j = 0; j < target_type.n_inputs; j++) {
-      if (target_type.input_types[j] != type.input_types[j]) {
-        found = 0;
-        break;
-      }
-      found = 1;
-    }
-    if (found == 0) {
-      continue;
-    }
-    if (target_type.output_type != type.output_type) {
-      found = 0;
-      continue;
-    }
-    found = 1;
-    break;
-  }
-  if (found == 1) {
-    return i;
-  }
-  // Not found duplicated type, return the original one.
-  return id;
-}
-
 __attribute__((unused)) static void
 call_indirect(struct CompilerContext* ctx,
               // const struct TypeSection* type_table,
               const struct FuncTypeVector* type_table, uint32_t type_index)
 {
   const struct FuncType* fun_type;
-  type_index = dedup_type(type_table, type_index);
+  // Identical types share their index, see intern_types().
   assert(type_index < type_table->size);
   fun_type = &type_table->data[type_index];
 
@@ -3414,26 +3732,32 @@ enum MEM_OOB_CHECK
 typedef enum MEM_OOB_CHECK mem_oob_check_t;
 
 // NOTE: Emscripten already inserts the runtime check on the beginning
-// of the function.
+// of the function. The dynamic check compares index + offset +
+// access_size with the current size of the memory, for builds whose
+// guard does not cover every access (SGXWASM_MEMORY_BOUNDS_CHECK).
+// The size is read at MEMORY_BOUND_OFFSET from base, the data of the
+// memory, which the access needs anyway. Out-of-bounds accesses stop at
+// a ud2 rather than an out-of-line trap, whose labels are never bound.
 __attribute__((unused)) static int
 bounds_check_mem(struct CompilerContext* ctx, uint32_t access_size,
-                 uint32_t offset, sgxwasm_register_t index, reglist_t* pinned,
+                 uint32_t offset, sgxwasm_register_t index,
+                 sgxwasm_register_t base, reglist_t* pinned,
                  mem_oob_check_t check_type)
 {
+  // A max_memory_size of 0 is no maximum, i.e. 4 GiB.
+  uint64_t max_size =
+    ctx->max_memory_size ? ctx->max_memory_size : (uint64_t)1 << 32;
+
   // Static check.
-  int static_oob = !is_in_bounds(offset, access_size, ctx->max_memory_size);
+  int static_oob = !is_in_bounds((uint64_t)offset, access_size, max_size);
 
   // The memory access is in bounds.
   if (!static_oob && (check_type == STATIC_CHECK)) {
     return 0;
   }
 
-  size_t position = pc_offset(output(ctx));
-  label_t* trap_label = add_out_of_line_trap(out_of_line_code(ctx), position,
-                                             TrapMemOutOfBounds, 0);
-
   if (static_oob) {
-    num_low_instrs(ctx) += emit_jmp_label(output(ctx), trap_label, Far);
+    num_low_instrs(ctx) += emit_ud2(output(ctx));
     struct ControlBlock* current_block = control_at(control(ctx), 0);
     if (reachable(current_block)) {
       current_block->reachability = SpecOnlyReachable;
@@ -3443,12 +3767,54 @@ bounds_check_mem(struct CompilerContext* ctx, uint32_t access_size,
 
   assert(check_type == DYNAMIC_CHECK);
 
-  (void)index;
-  (void)pinned;
+  int64_t last = (int64_t)offset + access_size;
+  sgxwasm_register_t end =
+    get_unused_register_with_class(ctx, GP_REG, EmptyRegList, *pinned);
+  struct Operand op;
+  label_t in_bounds = { 0, 0 };
+
+  // Zero-extends the index.
+  num_low_instrs(ctx) += emit_mov_rr(output(ctx), end, index, VALTYPE_I32);
+  if (is_uint31(last)) {
+    num_low_instrs(ctx) += emit_add_ri(output(ctx), end, last, VALTYPE_I64);
+  } else {
+    set(pinned, end);
+    sgxwasm_register_t tmp =
+      get_unused_register_with_class(ctx, GP_REG, EmptyRegList, *pinned);
+    load_const_to_reg(ctx, tmp, last, VALTYPE_I64);
+    num_low_instrs(ctx) += emit_add_rr(output(ctx), end, tmp, VALTYPE_I64);
+    clear(pinned, end);
+  }
+  build_operand(&op, base, REG_UNKNOWN, SCALE_NONE, MEMORY_BOUND_OFFSET);
+  num_low_instrs(ctx) += emit_cmp_rm(output(ctx), end, &op, VALTYPE_I64);
+  num_low_instrs(ctx) += emit_jcc(output(ctx), COND_LE_U, &in_bounds, Far);
+  num_low_instrs(ctx) += emit_ud2(output(ctx));
+  bind_label(output(ctx), &in_bounds, pc_offset(output(ctx)));
 
   return 0;
 }
 
+#if SGXWASM_MEMORY_BOUNDS_CHECK
+#define MEM_OOB_CHECK DYNAMIC_CHECK
+#else
+#define MEM_OOB_CHECK STATIC_CHECK
+#endif
+
+// Zero the index of a memory access on mispredicted paths (see
+// LSPECTRE_MASK). PredicateReg is all ones on the architectural path,
+// so the value of index does not change there.
+__attribute__((unused)) static void
+mask_mem_index(struct CompilerContext* ctx, sgxwasm_register_t index)
+{
+#if __LSPECTRE__ && LSPECTRE_MASK
+  num_low_instrs(ctx) +=
+    emit_and_rr(output(ctx), index, PredicateReg, VALTYPE_I32);
+#else
+  (void)ctx;
+  (void)index;
+#endif
+}
+
 __attribute__((unused)) static void
 load_mem(struct CompilerContext* ctx, load_type_t type, uint32_t offset)
 {
@@ -3457,12 +3823,18 @@ load_mem(struct CompilerContext* ctx, load_type_t type, uint32_t offset)
   sgxwasm_register_t index = pop_to_register(ctx, EmptyRegList);
   assert(is_gp(index));
   set(&pinned, index);
-  // Bounds check.
-  // TODO: Memory masking.
+#if __PIN_MEM_BASE__
+  sgxwasm_register_t addr = MemBaseReg;
+#else
   sgxwasm_register_t addr =
     get_unused_register_with_class(ctx, GP_REG, EmptyRegList, pinned);
   set(&pinned, addr);
   load_from_memory(ctx, addr, MEMREF_MEM, 0);
+#endif
+  // Bounds check.
+  bounds_check_mem(ctx, get_load_size(type), offset, index, addr, &pinned,
+                   MEM_OOB_CHECK);
+  mask_mem_index(ctx, index);
 
   sgxwasm_register_class_t rc = reg_class_for(value_type);
   sgxwasm_register_t value =
@@ -3489,13 +3861,18 @@ store_mem(struct CompilerContext* ctx, store_type_t type, uint32_t offset)
   sgxwasm_register_t index = pop_to_register(ctx, pinned);
   assert(is_gp(index));
   set(&pinned, index);
-  // Bounds check.
-
-  // TODO: Memory masking.
+#if __PIN_MEM_BASE__
+  sgxwasm_register_t addr = MemBaseReg;
+#else
   sgxwasm_register_t addr =
     get_unused_register_with_class(ctx, GP_REG, EmptyRegList, pinned);
   set(&pinned, addr);
   load_from_memory(ctx, addr, MEMREF_MEM, 0);
+#endif
+  // Bounds check.
+  bounds_check_mem(ctx, get_store_size(type), offset, index, addr, &pinned,
+                   MEM_OOB_CHECK);
+  mask_mem_index(ctx, index);
 
   uint32_t protected_load_pc = 0;
   // reglist_t outer_pinned = 0;
@@ -3504,6 +3881,48 @@ store_mem(struct CompilerContext* ctx, store_type_t type, uint32_t offset)
     Store(output(ctx), addr, index, offset, value, type, &protected_load_pc, 1);
   // use_trap_handler
 }
+// The data of a memory never moves when it grows (see
+// sgxwasm_memory_init), only its size is read at runtime.
+__attribute__((unused)) static void
+memory_size(struct CompilerContext* ctx)
+{
+  sgxwasm_register_t size;
+  struct Operand op;
+
+  if (ctx->max_memory_size != 0 &&
+      ctx->max_memory_size == ctx->min_memory_size) {
+    // Cannot grow.
+    push_const(ctx, VALTYPE_I32, ctx->min_memory_size / WASM_PAGE_SIZE);
+    return;
+  }
+
+  size =
+    get_unused_register_with_class(ctx, GP_REG, EmptyRegList, EmptyRegList);
+  load_from_memory(ctx, size, MEMREF_MEMORY, 0);
+  build_operand(&op, size, REG_UNKNOWN, SCALE_NONE,
+                offsetof(struct Memory, size));
+  num_low_instrs(ctx) += emit_mov_rm(output(ctx), size, &op, VALTYPE_I64);
+  num_low_instrs(ctx) += emit_shr_ri(output(ctx), size, 16, VALTYPE_I64);
+  push_register(ctx, VALTYPE_I32, size);
+}
+
+__attribute__((unused)) static void
+memory_grow(struct CompilerContext* ctx)
+{
+  struct FuncType fun_type;
+  sgxwasm_valtype_t i32 = VALTYPE_I32;
+
+  // sgxwasm_memory_grow(memory, pages)
+  _sgxwasm_create_func_type(&fun_type, 1, &i32, 1, &i32);
+  prepare_call(ctx, &fun_type, NULL);
+  num_low_instrs(ctx) += emit_mov_rr(output(ctx), GPParameterList[1],
+                                     GPParameterList[0], VALTYPE_I32);
+  load_from_memory(ctx, GPParameterList[0], MEMREF_MEMORY, 0);
+  load_from_memory(ctx, ScratchGP2, MEMREF_MEMORY_GROW, 0);
+  call_runtime(ctx, ScratchGP2);
+  finish_call(ctx, &fun_type);
+}
+
 __attribute__((unused)) static int
 sgxwasm_compile_function_body(struct CompilerContext* ctx,
                               // const struct TypeSection* type_table,
@@ -3528,11 +3947,9 @@ sgxwasm_compile_function_body(struct CompilerContext* ctx,
   if (c == NULL)
     goto error;
   c->label_state.stack_base = num_locals(ctx);
-  // Backward compatiable.
-  c->instructions = instructions;
-  c->n_instructions = n_instructions;
-  c->cont = 0;
-  update_compile_state(ctx);
+  compile_state(ctx)->instr_list = instructions;
+  compile_state(ctx)->n_instrs = n_instructions;
+  compile_state(ctx)->next = 0;
 
   /*#if __PASS__
     passes_function_start(ctx);
@@ -3555,9 +3972,10 @@ sgxwasm_compile_function_body(struct CompilerContext* ctx,
     passes_instruction_start(ctx);
 #endif
 
-    // Skip unreachable instructions.
+    // Skip unreachable instructions, and nested blocks as a whole.
     if (opcode != OPCODE_END && opcode != OPCODE_ELSE && unreachable(c)) {
       // printf("skip opcode: %x\n", opcode);
+      skip_block(ctx, instr);
       continue;
     }
 
@@ -3581,13 +3999,6 @@ sgxwasm_compile_function_body(struct CompilerContext* ctx,
 
         c->label_state.stack_base = stack_height(cache_state(ctx));
 
-        c->instructions = instr->data.block.instructions;
-        c->n_instructions = instr->data.block.n_instructions;
-        c->cont = 0;
-
-        // Start processing the control block.
-        update_compile_state(ctx);
-
 #if SGXWASM_DEBUG_COMPILE
         dump_cache_state_info(cache_state(ctx));
         dump_control_stack(control(ctx));
@@ -3622,13 +4033,6 @@ sgxwasm_compile_function_body(struct CompilerContext* ctx,
 
         // TODO: Stack check.
 
-        c->instructions = instr->data.loop.instructions;
-        c->n_instructions = instr->data.loop.n_instructions;
-        c->cont = 0;
-
-        // Start processing the control block.
-        update_compile_state(ctx);
-
 #if SGXWASM_DEBUG_COMPILE
         dump_cache_state_info(cache_state(ctx));
         dump_control_stack(control(ctx));
@@ -3667,13 +4071,6 @@ sgxwasm_compile_function_body(struct CompilerContext* ctx,
 #if 0
         emit_lfence(output(ctx));
 #endif
-        c->instructions = instr->data.if_.instructions_then;
-        c->n_instructions = instr->data.if_.n_instructions_then;
-        c->cont = 0;
-
-        // Start processing the control block.
-        update_compile_state(ctx);
-
 #if SGXWASM_DEBUG_COMPILE
         dump_cache_state_info(cache_state(ctx));
         dump_control_stack(control(ctx));
@@ -3732,7 +4129,6 @@ sgxwasm_compile_function_body(struct CompilerContext* ctx,
         assert(control_depth(control(ctx)) != 0);
         if (control_depth(control(ctx)) == 1) {
           // If at the last (implicit) control, check we are at end.
-          // assert(c->cont == c->n_instructions);
           assert(instr_id(ctx) == num_instrs(ctx) - 1);
 #if __PASS__
           passes_function_end(ctx);
@@ -3781,7 +4177,6 @@ sgxwasm_compile_function_body(struct CompilerContext* ctx,
         if (!parent_reached && reachable(c)) {
           c->reachability = SpecOnlyReachable;
         }
-        update_compile_state(ctx);
 
 #if SGXWASM_DEBUG_COMPILE
         dump_cache_state_info(cache_state(ctx));
@@ -3950,9 +4345,15 @@ sgxwasm_compile_function_body(struct CompilerContext* ctx,
             br_table_cond_jmp(ctx, COND_GE_U, &case_default, VALTYPE_I32, value,
                               tmp, 0, 0);
 
-            generate_br_table(ctx, tmp, value, 0 /* min */,
-                              table_count /* max */, table, &iterator,
-                              table_count, br_targets);
+            if ((ctx->flags & SGXWASM_COMPILE_FLAG_JUMP_TABLE) &&
+                table_count >= BR_JUMP_TABLE_MIN) {
+              generate_br_jump_table(ctx, tmp, value, table, table_count,
+                                     br_targets);
+            } else {
+              generate_br_table(ctx, tmp, value, 0 /* min */,
+                                table_count /* max */, table, &iterator,
+                                table_count, br_targets);
+            }
             br_table_bind(ctx, &case_default, BrTableTarget, 0, 0, 0);
           }
 
@@ -4479,29 +4880,11 @@ sgxwasm_compile_function_body(struct CompilerContext* ctx,
         break;
       }
       case OPCODE_MEMORY_SIZE: {
-        uint32_t size = ctx->min_memory_size / 65536;
-        push_const(ctx, VALTYPE_I32, size);
+        memory_size(ctx);
         break;
       }
-      case OPCODE_MEMORY_GROW: { // XXX: Check-needed
-        sgxwasm_register_t value = pop_to_register(ctx, EmptyRegList);
-        if (ctx->max_memory_size == 0) {
-          uint32_t size = ctx->min_memory_size / 65536;
-          push_const(ctx, VALTYPE_I32, size);
-        } else {
-          sgxwasm_register_t page_size = get_unused_register_with_class(
-            ctx, GP_REG, EmptyRegList, EmptyRegList);
-          size_t max_size = ctx->max_memory_size / 65536;
-          label_t els = { 0, 0 };
-          label_t end = { 0, 0 };
-          emit_cmp_ri(output(ctx), value, max_size, VALTYPE_I32);
-          emit_jcc(output(ctx), COND_GT_U, &els, Near);
-          push_register(ctx, VALTYPE_I32, value);
-          emit_jmp_label(output(ctx), &end, Near);
-          bind_label(output(ctx), &els, pc_offset(output(ctx)));
-          push_const(ctx, VALTYPE_I32, -1);
-          bind_label(output(ctx), &end, pc_offset(output(ctx)));
-        }
+      case OPCODE_MEMORY_GROW: {
+        memory_grow(ctx);
         break;
       }
       default:
@@ -4540,23 +4923,149 @@ process_parameters(struct CompilerContext* ctx,
     }
   } else if (is_stack(param->loc)) {
     // TODO: Test stack-based parameter passing.
+    uint32_t caller_slot = param->stack_offset;
+#if ENTRY_SAVED_REGS
+    // Skip the registers saved for the host.
+    if (is_entry(ctx)) {
+      caller_slot += ENTRY_SAVED_REGS;
+    }
+#endif
     reg = get_unused_register_with_class(ctx, rc, EmptyRegList, EmptyRegList);
     num_low_instrs(ctx) +=
-      LoadCallerFrameSlot(output(ctx), reg, param->stack_offset, type);
+      LoadCallerFrameSlot(output(ctx), reg, caller_slot, type);
   }
   push_register(ctx, type, reg);
 
   return 1;
 }
 
+#if __OPT_INIT_STACK__
+enum
+{
+  LocalRead = 1,
+  LocalWritten = 2,
+};
+
+// First access to each local in the code at the start of the body that
+// is entered only by falling through, i.e. up to the first branch.
+// Locals marked LocalWritten are written before they can be read.
+static uint8_t*
+first_local_access(const struct CodeSectionCode* code, uint32_t n_locals)
+{
+  uint8_t* access = calloc(n_locals + 1, sizeof(uint8_t));
+  size_t i;
+  if (!access) {
+    return NULL;
+  }
+  for (i = 0; i < code->n_instructions; i++) {
+    const struct Instr* instr = &code->instructions[i];
+    uint32_t index;
+    switch (instr->opcode) {
+      case OPCODE_GET_LOCAL:
+        index = instr->data.get_local.localidx;
+        assert(index < n_locals);
+        if (!access[index]) {
+          access[index] = LocalRead;
+        }
+        break;
+      case OPCODE_SET_LOCAL:
+      case OPCODE_TEE_LOCAL:
+        index = instr->data.set_local.localidx;
+        assert(index < n_locals);
+        if (!access[index]) {
+          access[index] = LocalWritten;
+        }
+        break;
+      case OPCODE_IF:
+      case OPCODE_ELSE:
+      case OPCODE_BR:
+      case OPCODE_BR_IF:
+      case OPCODE_BR_TABLE:
+      case OPCODE_RETURN:
+      case OPCODE_UNREACHABLE:
+        return access;
+      default:
+        break;
+    }
+  }
+  return access;
+}
+
+// Zeroes the slots of the locals [begin, end) that may be read before
+// being written. Long runs of slots use rep stosq, shorter ones 16-byte
+// stores.
+static void
+init_local_slots(struct CompilerContext* ctx, uint32_t begin, uint32_t end,
+                 const uint8_t* access)
+{
+  uint32_t i = begin, run;
+  while (i < end) {
+    if (access[i] == LocalWritten) {
+      i++;
+      continue;
+    }
+    for (run = 1; i + run < end && access[i + run] != LocalWritten; run++) {
+    }
+    if (run >= INIT_STACK_REP_MIN) {
+      // Keep the parameters passed in RDI and RCX in the scratch registers.
+      int save_rdi =
+        get_use_count(cache_state(ctx)->register_use_count, GP_RDI) != 0;
+      int save_rcx =
+        get_use_count(cache_state(ctx)->register_use_count, GP_RCX) != 0;
+      spill_register(ctx, GP_RAX);
+      if (save_rdi) {
+        num_low_instrs(ctx) +=
+          Move(output(ctx), ScratchGP, GP_RDI, VALTYPE_I64);
+      }
+      if (save_rcx) {
+        num_low_instrs(ctx) +=
+          Move(output(ctx), ScratchGP2, GP_RCX, VALTYPE_I64);
+      }
+      num_low_instrs(ctx) += InitStack(output(ctx), i + run - 1, run);
+      if (save_rdi) {
+        num_low_instrs(ctx) +=
+          Move(output(ctx), GP_RDI, ScratchGP, VALTYPE_I64);
+      }
+      if (save_rcx) {
+        num_low_instrs(ctx) +=
+          Move(output(ctx), GP_RCX, ScratchGP2, VALTYPE_I64);
+      }
+    } else {
+      num_low_instrs(ctx) += ZeroStack(output(ctx), i + run - 1, run);
+    }
+    i += run;
+  }
+}
+#endif
+
 static uint64_t
 prepare_stack_frame(struct CompilerContext* ctx)
 {
   uint64_t offset;
+#if __PIN_MEM_BASE__
+  // Entry functions save the host's RBX and set up MemBaseReg. Calls
+  // between wasm functions never clobber it because it is excluded
+  // from allocation, so the base is loaded once per host call.
+  if (is_entry(ctx)) {
+    num_low_instrs(ctx) += emit_pushq_r(output(ctx), MemBaseReg);
+  }
+#endif
+#if __LSPECTRE__ && LSPECTRE_MASK
+  // Wasm code is entered on the architectural path.
+  if (is_entry(ctx)) {
+    num_low_instrs(ctx) += emit_pushq_r(output(ctx), PredicateReg);
+    num_low_instrs(ctx) += emit_movl_ri(output(ctx), PredicateReg, -1);
+  }
+#endif
   num_low_instrs(ctx) += emit_pushq_r(output(ctx), GP_RBP);
   num_low_instrs(ctx) += Move(output(ctx), GP_RBP, GP_RSP, VALTYPE_I64);
   num_low_instrs(ctx) += emit_subq_sp_32(output(ctx), 0);
   offset = pc_offset(output(ctx)) - 4;
+#if __PIN_MEM_BASE__
+  if (is_entry(ctx)) {
+    load_from_memory(ctx, MemBaseReg, MEMREF_MEM, 0);
+  }
+#endif
   return offset;
 }
 
@@ -4569,6 +5078,12 @@ patch_stack_frame(struct CompilerContext* ctx, uint64_t offset, uint32_t size)
   if ((bytes % StackAlignment) != 0) {
     bytes += StackAlignment - bytes % StackAlignment;
   }
+#if ENTRY_SAVED_REGS
+  // Re-align after the extra pushes of the registers saved for the host.
+  if (is_entry(ctx)) {
+    bytes += 8 * (ENTRY_SAVED_REGS % 2);
+  }
+#endif
   for (i = 0; i < 4; i++) {
     set_byte_at(output(ctx), offset + i, bytes & 0xff);
     bytes = bytes >> 8;
@@ -4592,7 +5107,7 @@ sgxwasm_compile_function(struct PassManager* pm,
   uint32_t n_locals = 0;
   char* out;
   uint64_t pc_offset_stack_frame;
-  reglist_t used_registers = get_allocable_reg_list();
+  reglist_t used_registers;
   uint32_t register_use_count[RegisterNum] = { 0 };
   reglist_t last_spilled_regs = 0;
 
@@ -4603,6 +5118,7 @@ sgxwasm_compile_function(struct PassManager* pm,
 
   // Initialize allocable list of registers.
   init_allocable_reg_list();
+  used_registers = get_allocable_reg_list();
 
   {
     size_t i;
@@ -4615,6 +5131,7 @@ sgxwasm_compile_function(struct PassManager* pm,
   init_compiler_context(&ctx, func, memrefs, pm, &sstack, &used_registers,
                         register_use_count, &last_spilled_regs, fun_type,
                         n_locals, mem);
+  ctx.flags = flags;
 
 #if __PASS__ // Hooking point for the start of the function.
   passes_function_start(&ctx);
@@ -4660,26 +5177,25 @@ sgxwasm_compile_function(struct PassManager* pm,
   // Process the rest of local variables.
   {
     size_t i;
+#if __OPT_INIT_STACK__
+    // The locals live in their stack slots, zeroed in bulk.
+    uint8_t* access = first_local_access(code, n_locals);
+    if (!access)
+      goto error;
+#endif
     for (i = 0; i < code->n_locals; ++i) {
       sgxwasm_valtype_t valtype = code->locals[i].valtype;
       size_t j;
       for (j = 0; j < code->locals[i].count; j++) {
-        switch (valtype) {
-          case VALTYPE_I32:
 #if __OPT_INIT_STACK__
-            push_stack(cache_state(&ctx), VALTYPE_I32, LOC_STACK, REG_UNKNOWN,
-                       0);
+        push_stack(cache_state(&ctx), valtype, LOC_STACK, REG_UNKNOWN, 0);
 #else
+        switch (valtype) {
+          case VALTYPE_I32:
             push_const(&ctx, VALTYPE_I32, 0);
-#endif
             break;
           case VALTYPE_I64:
-#if __OPT_INIT_STACK__
-            push_stack(cache_state(&ctx), VALTYPE_I64, LOC_STACK, REG_UNKNOWN,
-                       0);
-#else
             push_const(&ctx, VALTYPE_I64, 0);
-#endif
             break;
           case VALTYPE_F32:
           case VALTYPE_F64: {
@@ -4695,12 +5211,12 @@ sgxwasm_compile_function(struct PassManager* pm,
             // Unsupported type.
             break;
         }
+#endif
       }
     }
 #if __OPT_INIT_STACK__
-    spill_register(&ctx, GP_RDI);
-    spill_register(&ctx, GP_RCX);
-    InitStack(output(&ctx), n_locals - 1, n_locals - fun_type->n_inputs);
+    init_local_slots(&ctx, fun_type->n_inputs, n_locals, access);
+    free(access);
 #endif
     assert(n_locals == stack_height(cache_state(&ctx)));
   }
@@ -71,6 +71,13 @@ struct MemoryReferences
       MEMREF_BR_TABLE_TARGET,
       MEMREF_BR_CASE_TARGET,
       MEMREF_SSA_POLLING,
+      MEMREF_MEMORY,      // struct Memory
+      MEMREF_MEMORY_GROW, // sgxwasm_memory_grow
+      MEMREF_FUNC_REL,    // rel32 of a direct call
+      MEMREF_JUMP_TABLE,  // Address of the jump table of a br_table
+      MEMREF_JUMP_TABLE_ENTRY, // Slot of a jump table
+      MEMREF_JUMP_TABLE_CASE,  // Case that slots jump to
+      MEMREF_AEX_COUNT,        // imm32 of a Varys check, patched by the pass
     } type;
     size_t code_offset;
     size_t idx;
@@ -82,13 +89,23 @@ struct MemoryReferences
 };
 DECLARE_VECTOR_GROW(memrefs, struct MemoryReferences);
 
+// Output of compiling one function, kept until it is placed in the
+// code region (see sgxwasm_instantiate).
+struct CompileResult
+{
+  char* unmapped;
+  size_t code_size;
+  struct MemoryReferences memrefs;
+};
+
 struct MemoryRef* new_memref(struct MemoryReferences*);
 
 #define SGXWASM_COMPILE_FLAG_INTEL_RETPOLINE 1
 #define SGXWASM_COMPILE_FLAG_AMD_RETPOLINE 2
-
-size_t
-dedup_type(const struct FuncTypeVector *, size_t);
+// Host-callable function (export or start) of a module with a memory.
+#define SGXWASM_COMPILE_FLAG_ENTRY 4
+// Lower large br_tables to jump tables (see __BR_JUMP_TABLE__).
+#define SGXWASM_COMPILE_FLAG_JUMP_TABLE 8
 
 char*
 sgxwasm_compile_function(struct PassManager*,
@@ -179,15 +196,8 @@ struct Control
     reachability_type_t reachability;
     label_t label;
     struct CacheState label_state;
-    // Backward compatiable.
-    size_t cont;
-    const struct Instr* instructions;
-    size_t n_instructions;
     struct ElseState
     {
-      size_t cont;
-      const struct Instr* instructions;
-      size_t n_instructions;
       label_t label;
       struct CacheState state;
     } else_state;
@@ -334,6 +344,20 @@ enum
   BindLabel = 0x19,
   CallFunction = 0x1a,
   Return = 0x1b,
+  // Call into the runtime (memory.grow).
+  CallRuntime = 0x1c,
+  // Indirect jmp through the jump table of a br_table.
+  JumpTableJmp = 0x1d,
+};
+
+// Jump a machine instruction ends with.
+enum JumpForm
+{
+  JumpNone = 0,
+  JumpShort, // jmp rel8
+  JumpNear,  // jmp rel32
+  JccShort,  // jcc rel8
+  JccNear,   // jcc rel32
 };
 
 // Machine instruction
@@ -342,7 +366,12 @@ struct MachineInstr
   // Reference to the IR-level instruction.
   const struct Instr *instr;
   uint8_t type;
+  // Set by the compiler before the machine_inst_end hooks: the bytes of
+  // the instruction in the output and the jump it ends with.
+  size_t offset;
   size_t size;
+  uint8_t jump;
+  condition_t cond;
   // For branch instructions.
   uint32_t depth;
   // For br_table.
@@ -356,12 +385,14 @@ struct MachineInstr
 
 // Ref: WasmFullDecoder
 
+// The function body is read in order, see struct Instr.
 struct CompileState
 {
   const struct Instr* instr;
   size_t instr_id;
   const struct Instr* instr_list;
   size_t n_instrs;
+  size_t next;
 };
 
 struct CompilerContext
@@ -381,6 +412,14 @@ struct CompilerContext
   // Allow referecing pass manager.
   struct PassManager* pm;
   size_t num_low_instrs;
+  unsigned flags;
+  // Machine instructions of the function, in output order (see
+  // last_jump()).
+  DEFINE_ANON_VECTOR(struct MachineInstr) minstrs;
+  // Memory references of jumps whose target is not known yet (see
+  // pending_jumps() in pass_cfg.h), and how far memrefs was scanned.
+  DEFINE_ANON_VECTOR(size_t) pending_jumps;
+  size_t pending_scanned;
 #if MEMORY_TRACE
   struct MemoryTracer mem_tracer;
 #endif
@@ -397,6 +436,7 @@ struct CompilerContext
 #define instr_list(ctx) ((ctx)->compile_state.instr_list)
 #define num_instrs(ctx) (ctx->compile_state.n_instrs)
 #define num_low_instrs(ctx) (ctx->num_low_instrs)
+#define is_entry(ctx) ((ctx)->flags & SGXWASM_COMPILE_FLAG_ENTRY)
 
 #define stack_height(cache_state) (cache_state)->stack_state->size
 
@@ -405,6 +445,57 @@ control_at(struct Control*, int);
 
 // End of definition of data structures.
 
+// Machine-instruction buffer.
+//
+// The compiler records every machine instruction emitted through the
+// machine-level hooks, and the passes record the jumps they emit, so
+// that the passes can find and rewrite the jump at the end of the
+// output in constant time instead of decoding the output.
+
+// Jump the output ends with, or NULL.
+const struct MachineInstr*
+last_jump(struct CompilerContext*);
+
+// Remove the jump the output ends with. Returns its form (JumpNone if
+// there is none) and its condition in cond, if not NULL.
+uint8_t
+drop_last_jump(struct CompilerContext*, condition_t* cond);
+
+// Turn the rel8 jump the output ends with into its rel32 form, whose
+// target is then relocated. Returns the form (JumpNear or JccNear), or
+// JumpNone if the output does not end with a jump.
+uint8_t
+widen_last_jump(struct CompilerContext*);
+
+// Emit a jmp (COND_NONE) or jcc rel32 whose target is relocated.
+void
+emit_pass_jump(struct CompilerContext*, condition_t cond);
+
+// Code taken out of the end of the output to insert code before it.
+struct CodeTail
+{
+  size_t offset;
+  size_t size;
+  char* data;
+  // Memory references that may point into it.
+  size_t first_memref;
+  size_t end_memref;
+  // Its machine instructions.
+  size_t n_minstrs;
+  struct MachineInstr* minstrs;
+};
+
+// Take the code from offset to the end of the output. The memory
+// references pointing into it are among first_memref and later ones.
+void
+take_code_tail(struct CompilerContext*, size_t offset, size_t first_memref,
+               struct CodeTail*);
+
+// Append the code taken by take_code_tail() and move its memory
+// references and machine instructions along.
+void
+put_code_tail(struct CompilerContext*, struct CodeTail*);
+
 // High-level APIs
 void
 spill_register(struct CompilerContext*, sgxwasm_register_t);
@@ -21,6 +21,14 @@
 #define SGXWASM_LOADTIME_MEMORY 0
 #endif
 
+// Per-phase and per-function load-time profile (see loadtime.h): 1 for
+// the phases and the functions, 2 to also break the compile time down
+// to every hook of every pass. For SGX, each cycle read is an ocall, so
+// the hook counters of level 2 include that overhead.
+#ifndef SGXWASM_LOADTIME_PROFILE
+#define SGXWASM_LOADTIME_PROFILE 0
+#endif
+
 #ifndef SGXWASM_BINARY_SIZE
 #define SGXWASM_BINARY_SIZE 0
 #endif
@@ -51,15 +59,134 @@
 
 // Configurations for compilation.
 
-// FIXME: Not working correcly now.
+// Keep the locals of a function in their stack slots and zero the
+// slots in bulk at entry, skipping locals written before any branch
+// and before being read. Runs of at least INIT_STACK_REP_MIN slots are
+// zeroed with rep stosq, shorter ones with 16-byte SSE stores.
 #ifndef __OPT_INIT_STACK__
-#define __OPT_INIT_STACK__ 0
+#define __OPT_INIT_STACK__ 1
+#endif
+
+#ifndef INIT_STACK_REP_MIN
+#define INIT_STACK_REP_MIN 32
+#endif
+
+// Call functions of the same module with a relocated call rel32
+// instead of loading the target into a register. The code region is
+// smaller than 2 GB, so any target is in range.
+#ifndef __DIRECT_CALL__
+#define __DIRECT_CALL__ 1
+#endif
+
+// Lower br_tables with at least BR_JUMP_TABLE_MIN entries to a bounds
+// check and an indirect jmp through a table of relocated case addresses,
+// instead of a binary search. Not used with the passes that instrument
+// every branch (tsgx, varys, lspectre) or fixed-size code units.
+#ifndef __BR_JUMP_TABLE__
+#define __BR_JUMP_TABLE__ 1
+#endif
+
+#ifndef BR_JUMP_TABLE_MIN
+#define BR_JUMP_TABLE_MIN 4
+#endif
+
+// Keep the base of the linear memory in MemBaseReg instead of
+// materializing it with a relocated movabs at every load/store.
+// Entry functions (exports and the start function) set it up.
+#ifndef __PIN_MEM_BASE__
+#define __PIN_MEM_BASE__ 0
+#endif
+
+// Number of threads compiling functions in sgxwasm_instantiate.
+// For SGX, TCSNum in Enclave.config.xml must be at least this large.
+#ifndef SGXWASM_COMPILE_THREADS
+#define SGXWASM_COMPILE_THREADS 1
+#endif
+
+// Cache synthesized code across loads (see cache.h).
+#ifndef SGXWASM_CODE_CACHE
+#define SGXWASM_CODE_CACHE 0
+#endif
+
+#ifndef SGXWASM_CODE_CACHE_DIR
+#define SGXWASM_CODE_CACHE_DIR "."
 #endif
 
 #ifndef __SGX__
 #define __SGX__ 1
 #endif
 
+// Linear memory. The range up to the maximum size of a memory, at most
+// SGXWASM_MEMORY_RESERVE, is reserved at instantiation and followed by
+// SGXWASM_MEMORY_GUARD bytes that are never accessible.
+// For SGX, memories come from the reserved memory of the enclave
+// (ReservedMemMaxSize in Enclave.config.xml).
+#ifndef SGXWASM_MEMORY_RESERVE
+#if __SGX__
+#define SGXWASM_MEMORY_RESERVE 0x4000000
+#else
+#define SGXWASM_MEMORY_RESERVE 0x100000000
+#endif
+#endif
+
+// An access reaches an i32 index plus a u32 offset plus 8 bytes past the
+// base. Outside SGX, every memory maps that whole range, so any access
+// outside the memory faults on the guard. The reserved memory of the
+// enclave cannot hold that, so SGX builds compare every access against
+// the current size of the memory instead (SGXWASM_MEMORY_BOUNDS_CHECK).
+#define SGXWASM_MEMORY_ACCESS_RANGE 0x200000008
+
+#ifndef SGXWASM_MEMORY_GUARD
+#if __SGX__
+#define SGXWASM_MEMORY_GUARD 0x10000
+#else
+#define SGXWASM_MEMORY_GUARD 0x100010000
+#endif
+#endif
+
+// The bounds check costs 4 instructions per load and store: mov and add
+// to form the end of the access, a cmp with the size stored before the
+// data of the memory and a jcc to a ud2. A native loop that only does a
+// prefix sum over 64 KiB of memory (one i32.load and one i32.store per
+// word) runs 43% slower with it, 31% with __PIN_MEM_BASE__.
+#ifndef SGXWASM_MEMORY_BOUNDS_CHECK
+#define SGXWASM_MEMORY_BOUNDS_CHECK                                            \
+  (SGXWASM_MEMORY_RESERVE + SGXWASM_MEMORY_GUARD < SGXWASM_MEMORY_ACCESS_RANGE)
+#endif
+
+// Initial and maximum size of the emscripten memory, in wasm pages.
+// Modules built without ALLOW_MEMORY_GROWTH import it with a maximum,
+// which SGXWASM_EMSCRIPTEN_MAX_PAGES may not exceed.
+#ifndef SGXWASM_EMSCRIPTEN_PAGES
+#define SGXWASM_EMSCRIPTEN_PAGES 256
+#endif
+
+#ifndef SGXWASM_EMSCRIPTEN_MAX_PAGES
+#define SGXWASM_EMSCRIPTEN_MAX_PAGES 256
+#endif
+
+// Time source for SGX (see timesrc.h): period of the updates of the
+// shared page, reads of an unchanged page after which it is considered
+// stale, and whether every read leaves the enclave.
+#ifndef SGXWASM_TIME_PRECISION_US
+#define SGXWASM_TIME_PRECISION_US 1000
+#endif
+
+#ifndef SGXWASM_TIME_STALE_READS
+#define SGXWASM_TIME_STALE_READS 0x10000
+#endif
+
+#ifndef SGXWASM_TIME_STRICT
+#define SGXWASM_TIME_STRICT 0
+#endif
+
+// Size of the untrusted buffer through which the I/O bridge moves the
+// data of writev/readv/send/recv for SGX (see iobridge.h). Larger
+// requests are split.
+#ifndef SGXWASM_IO_WINDOW_SIZE
+#define SGXWASM_IO_WINDOW_SIZE 0x40000
+#endif
+
 // Configurations for passes.
 
 #ifndef __PASS__
@@ -134,6 +261,14 @@
 #define __LSPECTRE__ 0
 #endif
 
+// LSPECTRE: instead of an lfence after every conditional branch, clear
+// PredicateReg with a cmov on the path a branch was not meant to take
+// and mask the index of every load and store with it (speculative load
+// hardening), so mispredicted paths only access the start of memory.
+#ifndef LSPECTRE_MASK
+#define LSPECTRE_MASK 0
+#endif
+
 #ifndef __DEBUG_LSPECTRE__
 #define __DEBUG_LSPECTRE__ 0
 #endif
@@ -154,4 +289,44 @@
 #define __DEBUG_PASS__ 0
 #endif
 
+// Hardening profile (see profile.h).
+// __PROFILE__ builds count function calls, block entries and T-SGX
+// aborts and commits and write the profile after main returns. Every
+// build reads the profile at SGXWASM_PROFILE_PATH, if any, when
+// instantiating.
+#ifndef __PROFILE__
+#define __PROFILE__ 0
+#endif
+
+#ifndef SGXWASM_PROFILE_PATH
+#define SGXWASM_PROFILE_PATH "sgxwasm.profile"
+#endif
+
+// Policy derived from the counters when writing the profile.
+// Skip T-SGX for functions whose calls abort at least this often (%).
+#ifndef PROFILE_SKIP_ABORT_RATE
+#define PROFILE_SKIP_ABORT_RATE 50
+#endif
+
+// Cheaper treatment for hot functions with few blocks per call.
+#ifndef PROFILE_OPT_CALLS
+#define PROFILE_OPT_CALLS 10000
+#endif
+
+#ifndef PROFILE_OPT_BLOCKS
+#define PROFILE_OPT_BLOCKS 4
+#endif
+
+// Split the transactions of functions in which at least this share of
+// them abort (%).
+#ifndef PROFILE_SPLIT_ABORT_RATE
+#define PROFILE_SPLIT_ABORT_RATE 10
+#endif
+
+// Merge the transactions of functions that never abort and commit at
+// least this many per call.
+#ifndef PROFILE_MERGE_COMMITS
+#define PROFILE_MERGE_COMMITS 64
+#endif
+
 #endif
@@ -75,7 +75,6 @@ sgxwasm_instantiate_emscripten_runtime(struct EmscriptenContext* ctx,
   struct Function* tmp_func = NULL;
   struct Function** tmp_table_buf = NULL;
   struct Table* tmp_table = NULL;
-  char* tmp_mem_buf = NULL;
   struct Memory* tmp_mem = NULL;
   struct Global* tmp_global = NULL;
   struct Module* module = NULL;
@@ -182,14 +181,12 @@ LVECTOR_INIT(&modules);
 
 #define DEFINE_WASM_MEMORY(_name, _min, _max)                                  \
   {                                                                            \
-    tmp_mem_buf = calloc((_min)*WASM_PAGE_SIZE, 1);                            \
-    if ((_min) && !tmp_mem_buf)                                                \
-      goto error;                                                              \
     tmp_mem = calloc(1, sizeof(struct Memory));                               \
-    tmp_mem->data = tmp_mem_buf;                                               \
-    tmp_mem_buf = NULL;                                                        \
-    tmp_mem->size = (_min)*WASM_PAGE_SIZE;                                     \
-    tmp_mem->max = (_max)*WASM_PAGE_SIZE;                                      \
+    if (!tmp_mem)                                                              \
+      goto error;                                                              \
+    if (!sgxwasm_memory_init(                                                  \
+          tmp_mem, (_min)*WASM_PAGE_SIZE, (_max)*WASM_PAGE_SIZE))              \
+      goto error;                                                              \
     LVECTOR_GROW(&module->mems);                                               \
     module->mems.data[module->mems.size - 1] = tmp_mem;                        \
     tmp_mem = NULL;                                                            \
@@ -259,10 +256,8 @@ LVECTOR_INIT(&modules);
     free(tmp_table->data);
     free(tmp_table);
   }
-  if (tmp_mem_buf)
-    free(tmp_mem_buf);
   if (tmp_mem) {
-    free(tmp_mem->data);
+    sgxwasm_memory_free(tmp_mem);
     free(tmp_mem);
   }
   if (tmp_global)
@@ -33,6 +33,11 @@
 #endif
 #include <time.h>
 
+#if __SGX__
+#include "sgx_rsrv_mem_mngr.h"
+#include "sgx_trts.h"
+#endif
+
 #if __SGX__
 static uint64_t sgxwasm_code_pointer = (int64_t)__SGXWASM_CODE_BASE;
 #else
@@ -42,78 +47,264 @@ static uint64_t sgxwasm_code_pointer;
 static uint64_t sgxwasm_code_base;
 static uint64_t sgxwasm_code_end;
 static uint64_t sgxwasm_code_size;
-// Use bitmap to record the usage of the code pages.
-// The size of bitmap is obtained by (total_size / unit_size) / 8,
-// as we use uint8.
-#define TotalUnits CodeSize / UnitSize
-#define BitmapSize TotalUnits / 8
-static uint8_t sgxwasm_code_bitmap[BitmapSize];
-
-// Bitmap operations
-enum
+
+// The free space of the code region is kept as a set of extents (runs
+// of free units), binned by size class: class k holds the extents whose
+// length is in [2^k, 2^(k+1)). Code is never freed, so the extents are
+// only ever split and each one is a maximal free run.
+//
+// A randomized allocation picks one of the classes in which every
+// extent fits, weighted by the number of fitting start units it holds,
+// then an extent of that class (rejection-sampled by its own weight,
+// with a bounded number of tries) and a random start inside it. This
+// matches the distribution of uniform probing over all fitting starts
+// in O(number of classes), while uniform probing needs an unbounded
+// number of tries as the region fills up.
+#define N_EXTENT_CLASSES 32
+#define EXTENT_PICK_TRIES 8
+
+struct CodeExtent
 {
-  BITS_PER_WORD = sizeof(uint8_t) * 8
+  uint32_t start;
+  uint32_t length;
+  uint32_t slot; // Position in the list of its class.
 };
-#define WORD_OFFSET(b) ((b) / BITS_PER_WORD)
-#define BIT_OFFSET(b) ((b) % BITS_PER_WORD)
 
-__attribute__((unused)) static void
-set_bit(uint8_t* bitmap, int n)
+static DEFINE_ANON_VECTOR(struct CodeExtent) code_extents;
+static DEFINE_ANON_VECTOR(uint32_t) free_extent_ids;
+
+static struct ExtentClass
+{
+  DEFINE_ANON_VECTOR(uint32_t) ids;
+  uint64_t units;
+} extent_classes[N_EXTENT_CLASSES];
+
+static uint32_t total_units;
+static struct CodeRegionStats code_region_stats;
+
+// Random numbers are drawn in batches to amortize RDRAND (SGX) calls.
+#define ENTROPY_POOL_SIZE 64
+static uint64_t entropy_pool[ENTROPY_POOL_SIZE];
+static size_t entropy_left;
+
+static uint64_t
+generate_rand()
 {
-  bitmap[WORD_OFFSET(n)] |= (1 << BIT_OFFSET(n));
+  if (entropy_left == 0) {
+#if __SGX__
+    if (sgx_read_rand((unsigned char*)entropy_pool, sizeof(entropy_pool)) !=
+        SGX_SUCCESS) {
+      assert(0);
+    }
+#else
+    size_t i;
+    for (i = 0; i < ENTROPY_POOL_SIZE; i++) {
+      entropy_pool[i] = ((uint64_t)rand() << 42) ^ ((uint64_t)rand() << 21) ^
+                        (uint64_t)rand();
+    }
+#endif
+    entropy_left = ENTROPY_POOL_SIZE;
+    code_region_stats.n_entropy_batches++;
+  }
+  return entropy_pool[--entropy_left];
 }
 
-__attribute__((unused)) static void
-clear_bit(uint8_t* bitmap, int n)
+static int
+extent_class(uint32_t length)
+{
+  assert(length > 0);
+  return 31 - __builtin_clz(length);
+}
+
+static void
+class_insert(uint32_t id)
+{
+  struct CodeExtent* extent = &code_extents.data[id];
+  struct ExtentClass* class = &extent_classes[extent_class(extent->length)];
+  if (!VECTOR_GROW(&class->ids)) {
+    assert(0);
+  }
+  extent->slot = class->ids.size - 1;
+  class->ids.data[extent->slot] = id;
+  class->units += extent->length;
+  code_region_stats.n_extents++;
+  code_region_stats.free_units += extent->length;
+}
+
+static void
+class_remove(uint32_t id)
+{
+  struct CodeExtent* extent = &code_extents.data[id];
+  struct ExtentClass* class = &extent_classes[extent_class(extent->length)];
+  uint32_t last = class->ids.data[class->ids.size - 1];
+  class->ids.data[extent->slot] = last;
+  code_extents.data[last].slot = extent->slot;
+  class->ids.size--;
+  class->units -= extent->length;
+  code_region_stats.n_extents--;
+  code_region_stats.free_units -= extent->length;
+}
+
+static void
+add_extent(uint32_t start, uint32_t length)
+{
+  uint32_t id;
+  if (length == 0) {
+    return;
+  }
+  if (free_extent_ids.size > 0) {
+    id = free_extent_ids.data[--free_extent_ids.size];
+  } else {
+    if (!VECTOR_GROW(&code_extents)) {
+      assert(0);
+    }
+    id = code_extents.size - 1;
+  }
+  code_extents.data[id].start = start;
+  code_extents.data[id].length = length;
+  class_insert(id);
+}
+
+// Take [start, start + length) out of extent id.
+static void
+split_extent(uint32_t id, uint32_t start, uint32_t length)
+{
+  struct CodeExtent extent = code_extents.data[id];
+  assert(start >= extent.start);
+  assert(start + length <= extent.start + extent.length);
+  class_remove(id);
+  if (!VECTOR_GROW(&free_extent_ids)) {
+    assert(0);
+  }
+  free_extent_ids.data[free_extent_ids.size - 1] = id;
+  add_extent(extent.start, start - extent.start);
+  add_extent(start + length,
+             extent.start + extent.length - (start + length));
+}
+
+static uint32_t
+align_unit(uint32_t index, uint32_t factor)
 {
-  bitmap[WORD_OFFSET(n)] &= ~(1 << BIT_OFFSET(n));
+  return (index + factor - 1) / factor * factor;
 }
 
-__attribute__((unused)) static int
-get_bit(uint8_t* bitmap, int n)
+// Lowest-address fit at or after the sequential pointer. Sequential
+// allocations (springboard, Varys checks, non-randomized code) come
+// before the randomized ones, so this only sees a few extents.
+static int
+find_sequential(uint32_t from, uint32_t units, uint32_t factor,
+                uint32_t* id_out, uint32_t* start_out)
 {
-  uint8_t bit = bitmap[WORD_OFFSET(n)] & (1 << BIT_OFFSET(n));
-  return bit != 0;
+  int found = 0;
+  size_t k, i;
+  for (k = 0; k < N_EXTENT_CLASSES; k++) {
+    struct ExtentClass* class = &extent_classes[k];
+    for (i = 0; i < class->ids.size; i++) {
+      uint32_t id = class->ids.data[i];
+      struct CodeExtent* extent = &code_extents.data[id];
+      uint32_t end = extent->start + extent->length;
+      uint32_t start = extent->start > from ? extent->start : from;
+      start = align_unit(start, factor);
+      if (start >= end || end - start < units) {
+        continue;
+      }
+      if (!found || start < *start_out) {
+        *id_out = id;
+        *start_out = start;
+        found = 1;
+      }
+    }
+  }
+  return found;
 }
 
-__attribute__((unused)) static int
-debug_bitmap(uint8_t* bitmap)
+static int
+pick_extent(uint32_t need, uint32_t* id_out)
 {
-  int i;
-  int avail = 0;
-  int unavail = 0;
-  int longest = 0;
-  int count = 0;
-  int last_avail;
-  for (i = 0; i < TotalUnits; i++) {
-    if (!get_bit(bitmap, i)) {
-      avail++;
-      if (count == 0) {
-        count = 1;
-      } else {
-        if (i == last_avail + 1) {
-	  count++;
-	} else {
-	  if (longest < count) {
-	    longest = count;
-	  }
-	  count = 1;
-	}
+  uint64_t weights[N_EXTENT_CLASSES];
+  uint64_t total = 0, r;
+  int lowest = extent_class(need);
+  int k, t;
+  size_t i;
+
+  // Every extent in a class above the one of need fits.
+  for (k = lowest + 1; k < N_EXTENT_CLASSES; k++) {
+    struct ExtentClass* class = &extent_classes[k];
+    weights[k] = class->units - (uint64_t)(need - 1) * class->ids.size;
+    total += weights[k];
+  }
+
+  if (total > 0) {
+    r = generate_rand() % total;
+    for (k = lowest + 1; r >= weights[k]; k++) {
+      r -= weights[k];
+    }
+    struct ExtentClass* class = &extent_classes[k];
+    uint64_t max_weight = ((uint64_t)1 << (k + 1)) - need;
+    uint32_t id = 0;
+    for (t = 0; t < EXTENT_PICK_TRIES; t++) {
+      id = class->ids.data[generate_rand() % class->ids.size];
+      if (generate_rand() % max_weight <
+          code_extents.data[id].length - need + 1) {
+        break;
       }
-      last_avail = i;
-    } else {
-      unavail++;
+      code_region_stats.n_rejections++;
     }
+    *id_out = id;
+    return 1;
   }
-  if (longest < count) {
-    longest = count;
+
+  // Only extents of the same class as need are left, and some of them
+  // may be too short. The region is almost full at this point.
+  struct ExtentClass* class = &extent_classes[lowest];
+  for (t = 0; t < EXTENT_PICK_TRIES && class->ids.size > 0; t++) {
+    uint32_t id = class->ids.data[generate_rand() % class->ids.size];
+    if (code_extents.data[id].length >= need) {
+      *id_out = id;
+      return 1;
+    }
+    code_region_stats.n_rejections++;
+  }
+  for (i = 0; i < class->ids.size; i++) {
+    if (code_extents.data[class->ids.data[i]].length >= need) {
+      *id_out = class->ids.data[i];
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static void
+reset_extents(uint32_t from)
+{
+  size_t k;
+  code_extents.size = 0;
+  free_extent_ids.size = 0;
+  for (k = 0; k < N_EXTENT_CLASSES; k++) {
+    extent_classes[k].ids.size = 0;
+    extent_classes[k].units = 0;
   }
-  printf("[debug_bitmap] avail: %d (largest chunk: %d), unavail: %d\n", avail, longest, unavail);
+  memset(&code_region_stats, 0, sizeof(code_region_stats));
+  code_region_stats.total_units = total_units;
+  add_extent(from, total_units - from);
 }
+
+__attribute__((unused)) static void
+debug_code_region(void)
+{
+  struct CodeRegionStats stats;
+  sgxwasm_code_region_stats(&stats);
+  printf("[debug_code_region] avail: %zu (largest chunk: %zu, chunks: %zu), "
+         "unavail: %zu\n",
+         stats.free_units,
+         stats.largest_extent,
+         stats.n_extents,
+         stats.total_units - stats.free_units);
+}
+
 void
 sgxwasm_init_code_region(size_t size)
 {
-  size_t bitmap_size = BitmapSize;
 #if !__SGX__
   void* code_region;
   time_t t;
@@ -125,17 +316,24 @@ sgxwasm_init_code_region(size_t size)
 
   // Initialize random number generator.
   srand((unsigned)time(&t));
+  entropy_left = 0;
+#else
+  // The region is static: set it up once and keep the code of the
+  // modules instantiated before.
+  if (sgxwasm_code_base != 0) {
+    return;
+  }
 #endif
-  //sgxwasm_code_base = sgxwasm_code_pointer;
   // Ensure page alignment.
-  int adjust = 4096 - sgxwasm_code_pointer % 4096;
+  int adjust = (4096 - sgxwasm_code_pointer % 4096) % 4096;
   sgxwasm_code_base = sgxwasm_code_pointer + adjust;
-  sgxwasm_code_end = sgxwasm_code_pointer + size;
-  sgxwasm_code_size = size;
+  sgxwasm_code_pointer = sgxwasm_code_base;
+  sgxwasm_code_end = sgxwasm_code_base + size - adjust;
+  sgxwasm_code_size = size - adjust;
   //printf("[init_code_region] range: %lx - %lx (size: %zu)\n",
   //       sgxwasm_code_base, sgxwasm_code_end, sgxwasm_code_size);
-  // Initialize bitmap.
-  memset(sgxwasm_code_bitmap, 0, bitmap_size);
+  total_units = sgxwasm_code_size / UnitSize;
+  reset_extents(0);
 }
 
 int
@@ -154,46 +352,25 @@ sgxwasm_get_code_base()
   return sgxwasm_code_base;
 }
 
-
-__attribute__((unused)) static int
-check_and_set(uint8_t* bitmap, int base, size_t size)
+void
+sgxwasm_code_region_stats(struct CodeRegionStats* stats)
 {
-  int range = base + size / UnitSize + 1;
-  int is_available = 1;
-  int i;
-  if (range >= TotalUnits) {
-    return 0;
-  }
-  for (i = base; i < range; i++) {
-    if (get_bit(bitmap, i)) {
-      is_available = 0;
+  int k;
+  size_t i;
+  *stats = code_region_stats;
+  stats->largest_extent = 0;
+  for (k = N_EXTENT_CLASSES - 1; k >= 0; k--) {
+    struct ExtentClass* class = &extent_classes[k];
+    for (i = 0; i < class->ids.size; i++) {
+      uint32_t length = code_extents.data[class->ids.data[i]].length;
+      if (length > stats->largest_extent) {
+        stats->largest_extent = length;
+      }
+    }
+    if (class->ids.size > 0) {
       break;
     }
   }
-  if (!is_available) {
-    return 0;
-  }
-  for (i = base; i < range; i++) {
-    set_bit(bitmap, i);
-  }
-  return 1;
-}
-
-
-__attribute__((unused)) static uint64_t
-generate_rand()
-{
-  return rand();
-}
-
-__attribute__((unused)) static int
-generate_rand_index(int align)
-{
-  assert(align % 2 == 0);
-  int factor = align / UnitSize;
-  int bound = TotalUnits / factor;
-  int index = (generate_rand() % bound) * factor;
-  return index;
 }
 
 void*
@@ -201,42 +378,45 @@ sgxwasm_allocate_code(size_t code_size, int align, int rand)
 {
   assert(align % 2 == 0);
   uint64_t code_start;
-  int index;
+  uint32_t factor = align > UnitSize ? align / UnitSize : 1;
+  uint32_t units, id, index;
 
   if (rand == 0) {
-    code_start = sgxwasm_code_pointer;
-    index = (code_start - sgxwasm_code_base) / UnitSize;
     if (code_size < (size_t)align) {
       code_size = align;
     }
-    if (!check_and_set(sgxwasm_code_bitmap, index, code_size)) {
+    units = code_size / UnitSize + 1;
+    if (!find_sequential((sgxwasm_code_pointer - sgxwasm_code_base) /
+                           UnitSize,
+                         units, factor, &id, &index)) {
       assert(0); // sgxwasm_code is full.
       return NULL;
     }
-    //sgxwasm_code_pointer = code_start + (code_size / UnitSize + 1) * UnitSize;
-    sgxwasm_code_pointer += (code_size / UnitSize + 1) * UnitSize;
-
-#if DEBUG_RELOCATE
-    debug_bitmap(sgxwasm_code_bitmap);
-#endif
+    sgxwasm_code_pointer = sgxwasm_code_base + (uint64_t)(index + units) *
+                                                 UnitSize;
   } else {
-#if DEBUG_RELOCATE
-    int t = 0;
-#endif
-    do {
-      index = generate_rand_index(align);
-#if DEBUG_RELOCATE
-      printf("check #%d: %d, size: %zu\n", t, index, code_size);
-      debug_bitmap(sgxwasm_code_bitmap);
-      t++;
-#endif
-    } while (!check_and_set(sgxwasm_code_bitmap, index, code_size));
-
-    code_start = index * UnitSize + sgxwasm_code_base;
-    assert(code_start + code_size < sgxwasm_code_end);
+    // Pad the request so that any start in the extent can be aligned.
+    uint32_t need;
+    struct CodeExtent* extent;
+    units = code_size / UnitSize + 1;
+    need = units + factor - 1;
+    if (!pick_extent(need, &id)) {
+      assert(0); // sgxwasm_code is full.
+      return NULL;
+    }
+    extent = &code_extents.data[id];
+    index = extent->start + generate_rand() % (extent->length - need + 1);
+    index = align_unit(index, factor);
+    code_region_stats.n_rand_allocs++;
   }
+  split_extent(id, index, units);
+  code_region_stats.n_allocs++;
+
+  code_start = (uint64_t)index * UnitSize + sgxwasm_code_base;
+  assert(code_start + code_size < sgxwasm_code_end);
 
 #if DEBUG_RELOCATE
+  debug_code_region();
 #if __linux__
   printf("[sgxwasm_allocate_code] base: %lx (+%lu)\n", code_start, code_size);
 #else
@@ -267,6 +447,162 @@ sgxwasm_unmap_code_segment(void* code, size_t code_size)
 #endif
 }
 
+// Linear memory.
+//
+// The whole range a memory can grow to is reserved up front, so data
+// never moves and the compiled code, which embeds it, stays valid.
+// Only the first size bytes are accessible; the rest of the range and
+// the guard behind it fault. Pages are backed on first touch: by the
+// kernel outside SGX, by EAUG with SGX2. Without SGX2, the reserved
+// memory of the enclave is committed when it is loaded.
+
+// With SGXWASM_MEMORY_BOUNDS_CHECK, a page in front of the data holds
+// the size that the compiled code checks accesses against
+// (MEMORY_BOUND_OFFSET). Without it, the mapping covers every address an
+// access can form (SGXWASM_MEMORY_ACCESS_RANGE), whatever the maximum of
+// the memory.
+#if SGXWASM_MEMORY_BOUNDS_CHECK
+#define MEMORY_HEADER PageSize
+#else
+#define MEMORY_HEADER 0
+#endif
+
+static size_t
+memory_map_size(const struct Memory* mem)
+{
+#if SGXWASM_MEMORY_BOUNDS_CHECK
+  return MEMORY_HEADER + mem->reserved + SGXWASM_MEMORY_GUARD;
+#else
+  return (mem->reserved < SGXWASM_MEMORY_RESERVE ? SGXWASM_MEMORY_RESERVE
+                                                 : mem->reserved) +
+         SGXWASM_MEMORY_GUARD;
+#endif
+}
+
+// Make [start, start + size) accessible.
+static int
+commit_pages(char* start, size_t size)
+{
+  assert((uintptr_t)start % PageSize == 0 && size % PageSize == 0);
+  if (size == 0) {
+    return 1;
+  }
+#if __SGX__
+  return sgx_tprotect_rsrv_mem(start, size, SGX_PROT_READ | SGX_PROT_WRITE) ==
+         SGX_SUCCESS;
+#else
+  return !mprotect(start, size, PROT_READ | PROT_WRITE);
+#endif
+}
+
+// Make [from, to) of the memory accessible.
+static int
+commit_memory(struct Memory* mem, size_t from, size_t to)
+{
+  assert(from <= to);
+  return commit_pages(mem->data + from, to - from);
+}
+
+static void
+set_memory_size(struct Memory* mem, size_t size)
+{
+  mem->size = size;
+#if SGXWASM_MEMORY_BOUNDS_CHECK
+  *(size_t*)(mem->data + MEMORY_BOUND_OFFSET) = size;
+#endif
+}
+
+int
+sgxwasm_memory_init(struct Memory* mem, size_t size, size_t max)
+{
+  // Growing past the reservation fails, which memory.grow may do.
+  size_t reserved =
+    (max && max < SGXWASM_MEMORY_RESERVE) ? max : SGXWASM_MEMORY_RESERVE;
+  void* data;
+
+  mem->data = NULL;
+  mem->size = 0;
+  mem->max = max;
+  mem->reserved = 0;
+
+  if (reserved < size) {
+    reserved = size;
+  }
+  if (reserved == 0) {
+    return 1;
+  }
+
+  mem->reserved = reserved;
+#if __SGX__
+  data = sgx_alloc_rsrv_mem(memory_map_size(mem));
+  if (!data) {
+    mem->reserved = 0;
+    return 0;
+  }
+  mem->data = (char*)data + MEMORY_HEADER;
+  if (sgx_tprotect_rsrv_mem(data, memory_map_size(mem), SGX_PROT_NONE) !=
+      SGX_SUCCESS) {
+    goto error;
+  }
+#else
+  data = mmap(NULL, memory_map_size(mem), PROT_NONE,
+              MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (data == MAP_FAILED) {
+    mem->reserved = 0;
+    return 0;
+  }
+  mem->data = (char*)data + MEMORY_HEADER;
+#endif
+
+  if (!commit_pages(data, MEMORY_HEADER) || !commit_memory(mem, 0, size)) {
+    goto error;
+  }
+  set_memory_size(mem, size);
+  return 1;
+
+error:
+  sgxwasm_memory_free(mem);
+  return 0;
+}
+
+void
+sgxwasm_memory_free(struct Memory* mem)
+{
+  if (!mem->data) {
+    return;
+  }
+#if __SGX__
+  // Reserved memory is handed out again as it is. The header is only
+  // written once the memory is set up, with its size.
+  if (mem->size) {
+    memset(mem->data - MEMORY_HEADER, 0, MEMORY_HEADER + mem->size);
+  }
+  sgx_free_rsrv_mem(mem->data - MEMORY_HEADER, memory_map_size(mem));
+#else
+  munmap(mem->data - MEMORY_HEADER, memory_map_size(mem));
+#endif
+  mem->data = NULL;
+  mem->size = 0;
+  mem->reserved = 0;
+}
+
+uint32_t
+sgxwasm_memory_grow(struct Memory* mem, uint32_t pages)
+{
+  size_t old_pages = mem->size / WASM_PAGE_SIZE;
+  size_t size;
+
+  if (pages > (mem->reserved - mem->size) / WASM_PAGE_SIZE) {
+    return (uint32_t)-1;
+  }
+  size = mem->size + pages * WASM_PAGE_SIZE;
+  if (!commit_memory(mem, mem->size, size)) {
+    return (uint32_t)-1;
+  }
+  set_memory_size(mem, size);
+  return old_pages;
+}
+
 void
 sgxwasm_trap(int reason)
 {
@@ -2,8 +2,10 @@
 
 #include <sgxwasm/emscripten.h>
 #include <sgxwasm/emscripten_runtime_sys.h>
+#include <sgxwasm/iobridge.h>
 #include <sgxwasm/runtime.h>
 #include <sgxwasm/sys.h>
+#include <sgxwasm/timesrc.h>
 #if !__SGX__
 #include <arpa/inet.h>
 #include <netinet/in.h>
@@ -24,8 +26,8 @@
 // TODO: make three paramters as part of EmscriptenContext,
 //       and pass the pointer of ctx to WASM program.
 static uint64_t emscripten_mem_base = 0;
-static uint32_t emscripten_mem_max_size = 0;
-static uint32_t emscripten_total_memory = 16777216;
+static struct Memory* emscripten_memory = NULL;
+static uint32_t emscripten_dynamictop_ptr = 0;
 static uint32_t (*emscripten_stack_alloc)(uint32_t) = NULL;
 static struct Module* module_ref = NULL;
 
@@ -171,9 +173,11 @@ emscripten_debug_global(uint32_t index)
       break;
   }
 }
-#define emscripten_check_mem_range(addr, size)                                 \
-  (((uint64_t)addr >= emscripten_mem_base) &&                                  \
-   (((uint64_t)addr + size) < emscripten_mem_base + emscripten_mem_max_size))
+// Fails until emscripten_setMemory has run.
+#define emscripten_check_mem_range(addr, len)                                  \
+  ((emscripten_memory != NULL) &&                                              \
+   ((uint64_t)addr >= emscripten_mem_base) &&                                  \
+   (((uint64_t)addr + len) < emscripten_mem_base + emscripten_memory->size))
 
 #define emscripten_check_mem(addr) emscripten_check_mem_range(addr, 0)
 
@@ -436,11 +440,12 @@ emscripten_cleanup(struct Module* module)
 }
 
 void
-emscripten_setMemBase(uint64_t addr, uint64_t max_size)
+emscripten_setMemory(struct Memory* mem)
 {
-  emscripten_mem_base = addr;
-  emscripten_mem_max_size = max_size;
-  // sgxwasm_log("[setMemBase] base: %lx, size: %zu\n", addr, max_size);
+  // The data of the memory does not move when it grows.
+  emscripten_mem_base = (uint64_t)mem->data;
+  emscripten_memory = mem;
+  // sgxwasm_log("[setMemory] base: %lx, size: %zu\n", mem->data, mem->size);
 }
 
 uint64_t
@@ -459,6 +464,8 @@ emscripten_setDynamicBase(struct EmscriptenContext* ctx)
   uint32_t dynamic_base;
   int ret;
 
+  emscripten_dynamictop_ptr = dyamictop_ptr;
+
   dynamic_base = alignMemory(stack_max, 16);
   // Hold the same on X86.
   dynamic_base = uint32_t_swap_bytes(dynamic_base);
@@ -489,9 +496,14 @@ void
 memory_preloading()
 {
   uint64_t mem_start = emscripten_mem_base & 0xfffffffffffff000;
-  uint64_t mem_end = (mem_start + emscripten_total_memory) & 0xfffffffffffff000;
+  uint64_t mem_end;
   uint8_t access;
 
+  if (emscripten_memory == NULL) {
+    return;
+  }
+  mem_end = (mem_start + emscripten_memory->size) & 0xfffffffffffff000;
+
 #if __DEBUG_TSGX__
   sgxwasm_log("memory_preloading (@0x%llx - @0x%llx)\n", mem_start, mem_end);
 #endif
@@ -529,11 +541,11 @@ emscripten_invoke_main(struct Function* em_stack_alloc,
 // invoke main.
 #if SGXWASM_BENCH
     uint64_t t1, t2;
-    ocall_sgx_rdtsc(&t1);
+    t1 = sgxwasm_cycles();
 #endif
     ret = _main();
 #if SGXWASM_BENCH
-    ocall_sgx_rdtsc(&t2);
+    t2 = sgxwasm_cycles();
     printf("%lu\n", t2 - t1);
 #endif
   } else if (parameter_count(&em_main->type) ==
@@ -575,11 +587,11 @@ emscripten_invoke_main(struct Function* em_stack_alloc,
 // invoke main
 #if SGXWASM_BENCH
     uint64_t t1, t2;
-    ocall_sgx_rdtsc(&t1);
+    t1 = sgxwasm_cycles();
 #endif
     ret = _main(argc, argv_index);
 #if SGXWASM_BENCH
-    ocall_sgx_rdtsc(&t2);
+    t2 = sgxwasm_cycles();
     printf("%lu\n", t2 - t1);
 #endif
   }
@@ -589,21 +601,41 @@ done:
 
 // Implementation of imported functions from emscripten.
 
+// Called by sbrk when DYNAMICTOP passed the size of the memory. Like
+// emscripten, the memory is doubled, or grown to DYNAMICTOP if that is
+// not possible. Returns 0 if it cannot grow.
 uint32_t
 emscripten_enlargeMemory()
 {
-  sgxwasm_log("[enlargeMemory]\n");
-  emscripten_debug_global(8);
-  emscripten_debug_mem(7040);
-  emscripten_debug_global(9);
-  emscripten_debug_mem(7024);
-  return 0;
+  uint32_t dynamic_top;
+  size_t pages, needed;
+
+  if (emscripten_copy_from_wasm(
+        &dynamic_top, (void*)(emscripten_mem_base + emscripten_dynamictop_ptr),
+        sizeof(dynamic_top))) {
+    return 0;
+  }
+  dynamic_top = uint32_t_swap_bytes(dynamic_top);
+  pages = emscripten_memory->size / WASM_PAGE_SIZE;
+  needed = (dynamic_top + WASM_PAGE_SIZE - 1) / WASM_PAGE_SIZE;
+  if (needed <= pages) {
+    return 1;
+  }
+#if DEBUG_EM_CALLS
+  sgxwasm_log("[enlargeMemory] %zu -> %zu pages\n", pages, needed);
+#endif
+  if (needed < 2 * pages &&
+      sgxwasm_memory_grow(emscripten_memory, pages) != (uint32_t)-1) {
+    return 1;
+  }
+  return sgxwasm_memory_grow(emscripten_memory, needed - pages) !=
+         (uint32_t)-1;
 }
 
 uint32_t
 emscripten_getTotalMemory()
 {
-  return emscripten_total_memory;
+  return emscripten_memory != NULL ? emscripten_memory->size : 0;
 }
 
 uint32_t
@@ -819,6 +851,9 @@ emscripten____map_file(uint32_t arg1, uint32_t arg2)
 
 // Helper functions for syscalls support
 
+// UIO_MAXIOV of Linux.
+#define EMSCRIPTEN_IOV_MAX 1024
+
 static void
 read_iov(struct iovec* iov, uint32_t iovp, uint32_t iovcnt)
 {
@@ -843,6 +878,30 @@ read_iov(struct iovec* iov, uint32_t iovp, uint32_t iovcnt)
   }
 }
 
+// Point iov at the buffers in the linear memory, without copying them.
+// Returns 0 if one of them is out of the memory.
+static int
+map_iov(struct iovec* iov, uint32_t iovp, uint32_t iovcnt)
+{
+  size_t i;
+  assert(iov != NULL);
+
+  for (i = 0; i < iovcnt; i++) {
+    // Fix size of struct iovec to 8.
+    uint32_t base = iovp + 8 * i;
+    uint32_t ptr;
+    uint32_t len;
+    emscripten_get_value((void*)&ptr, base, 0, sizeof(uint32_t));
+    emscripten_get_value((void*)&len, base, 4, sizeof(uint32_t));
+    if (!emscripten_check_mem_range(emscripten_mem_base + ptr, len)) {
+      return 0;
+    }
+    iov[i].iov_base = (void*)(emscripten_mem_base + ptr);
+    iov[i].iov_len = len;
+  }
+  return 1;
+}
+
 static void
 init_iov(struct iovec* iov, uint32_t iovp, uint32_t iovcnt)
 {
@@ -1278,16 +1337,18 @@ emscripten____syscall102(uint32_t which, uint32_t varargs)
       uint32_t addrlen = emscripten_get(&socketvararg);
       struct sockaddr_storage* dest =
         emscripten_get_socket_address(addrp, addrlen, 1);
-      void* buf = malloc(length);
-      emscripten_get_value(buf, message, 0, length);
+      void* buf = (void*)(emscripten_mem_base + message);
+      if (!emscripten_check_mem_range(buf, length)) {
+        ret = -EFAULT;
+        break;
+      }
       if (!dest) {
         // send, no address provided.
-        ret = sys_send(fd, (void*)buf, length, flags);
+        ret = sgxwasm_io_send(fd, buf, length, flags);
       } else {
-        ret = sys_sendto(fd, (void*)buf, length, flags, (struct sockaddr*)dest,
+        ret = sys_sendto(fd, buf, length, flags, (struct sockaddr*)dest,
                          addrlen);
       }
-      free(buf);
       break;
     }
     case 12: { // recvfrom
@@ -1297,19 +1358,20 @@ emscripten____syscall102(uint32_t which, uint32_t varargs)
       uint32_t flags = emscripten_get(&socketvararg);
       uint32_t addrp = emscripten_get(&socketvararg);
       uint32_t addrlenp = emscripten_get(&socketvararg);
-      char* buf = calloc(1, len);
+      void* buf = (void*)(emscripten_mem_base + bufp);
       struct sockaddr addr;
       uint32_t addrlen;
-      emscripten_get_value((void*)&addrlen, addrlenp, 0, sizeof(uint32_t));
+      if (!emscripten_check_mem_range(buf, len)) {
+        ret = -EFAULT;
+        break;
+      }
       if (!addrp) {
-        ret = sys_recv(fd, (void*)buf, len, flags);
+        ret = sgxwasm_io_recv(fd, buf, len, flags);
       } else {
-        ret = sys_recvfrom(fd, (void*)buf, len, flags, &addr, &addrlen);
+        emscripten_get_value((void*)&addrlen, addrlenp, 0, sizeof(uint32_t));
+        ret = sys_recvfrom(fd, buf, len, flags, &addr, &addrlen);
         write_sockaddr(addrp, addrlenp, &addr, &addrlen);
       }
-      // Copy the received data back to wasm memory.
-      emscripten_set_value(buf, bufp, 0, len);
-      free(buf);
       break;
     }
     case 13: { // shutdown
@@ -1647,16 +1709,22 @@ emscripten____syscall145(uint32_t which, uint32_t varargs)
   uint32_t iovp = emscripten_get(&varargs);
   uint32_t iovcnt = emscripten_get(&varargs);
   struct iovec* iov = NULL;
+  if (iovcnt > EMSCRIPTEN_IOV_MAX) {
+    rret = -EINVAL;
+    goto error;
+  }
   iov = malloc(sizeof(struct iovec) * iovcnt);
-  if (iov == NULL)
+  if (iov == NULL) {
+    rret = -ENOMEM;
     goto error;
-  init_iov(iov, iovp, iovcnt);
-  rret = sys_readv(fd, iov, iovcnt);
-  if (rret >= 0) {
-    write_iov(iovp, iovcnt, iov);
   }
-  free(iov);
+  if (!map_iov(iov, iovp, iovcnt)) {
+    rret = -EFAULT;
+    goto error;
+  }
+  rret = sgxwasm_io_readv(fd, iov, iovcnt);
 error:
+  free(iov);
 #endif
 #if DEBUG_EM_CALLS
   sgxwasm_log("[syscall 145] readv(%u, %u, %u)\n", fd, iovp, iovcnt);
@@ -1677,15 +1745,22 @@ emscripten____syscall146(uint32_t which, uint32_t varargs)
   uint32_t iovcnt = emscripten_get(&varargs);
   struct iovec* iov = NULL;
 
+  if (iovcnt > EMSCRIPTEN_IOV_MAX) {
+    rret = -EINVAL;
+    goto error;
+  }
   iov = malloc(sizeof(struct iovec) * iovcnt);
-  if (iov == NULL)
+  if (iov == NULL) {
+    rret = -ENOMEM;
     goto error;
-  read_iov(iov, iovp, iovcnt);
-  rret = sys_writev(fd, iov, iovcnt);
-  if (rret)
+  }
+  if (!map_iov(iov, iovp, iovcnt)) {
+    rret = -EFAULT;
     goto error;
-  free(iov);
+  }
+  rret = sgxwasm_io_writev(fd, iov, iovcnt);
 error:
+  free(iov);
 #if DEBUG_EM_CALLS
   sgxwasm_log("[syscall 146] writev %u, %u\n", which, varargs);
 #endif
@@ -2675,11 +2750,24 @@ emscripten___exit(uint32_t arg)
   sgxwasm_log("[__exit] arg: %u\n", arg);
 }
 
-uint32_t
-emscripten__gettimeofday(uint32_t arg1, uint32_t arg2)
+// Store ns as two i32 (seconds and units of unit_ns) at ptr.
+static void
+emscripten_set_time(uint32_t ptr, uint64_t ns, uint32_t unit_ns)
 {
-  sgxwasm_log("[_gettimeofday] arg1: %u, arg2: %u\n", arg1, arg2);
+  uint32_t value[2];
+  value[0] = ns / 1000000000;
+  value[1] = ns % 1000000000 / unit_ns;
+  emscripten_set_value(value, ptr, 0, sizeof(value));
+}
 
+uint32_t
+emscripten__gettimeofday(uint32_t tv, uint32_t tz)
+{
+  (void)tz;
+#if DEBUG_EM_CALLS
+  sgxwasm_log("[_gettimeofday] tv: %u, tz: %u\n", tv, tz);
+#endif
+  emscripten_set_time(tv, sgxwasm_time_get(SGXWASM_CLOCK_REALTIME, 0), 1000);
   return 0;
 }
 
@@ -2746,15 +2834,21 @@ emscripten____buildEnvironment(uint32_t arg)
 uint32_t
 emscripten__clock_gettime(uint32_t clk_id, uint32_t tp)
 {
-  sgxwasm_log("[__clock_gettime] arg1: %u, arg2: %u\n", clk_id, tp);
+#if DEBUG_EM_CALLS
+  sgxwasm_log("[_clock_gettime] clk_id: %u, tp: %u\n", clk_id, tp);
+#endif
+  // CLOCK_REALTIME and CLOCK_MONOTONIC, as in the JS runtime.
+  if (clk_id != SGXWASM_CLOCK_REALTIME && clk_id != SGXWASM_CLOCK_MONOTONIC) {
+    return -1;
+  }
+  emscripten_set_time(tp, sgxwasm_time_get(clk_id, 0), 1);
   return 0;
 }
 
 uint32_t
 emscripten____clock_gettime(uint32_t clk_id, uint32_t tp)
 {
-  sgxwasm_log("[___clock_gettime] arg1: %u, arg2: %u\n", clk_id, tp);
-  return 0;
+  return emscripten__clock_gettime(clk_id, tp);
 }
 
 double
@@ -3036,8 +3130,10 @@ emscripten__strptime(uint32_t arg1, uint32_t arg2, uint32_t arg3)
 uint32_t
 emscripten__time(uint32_t arg)
 {
-  uint32_t ret = (time(NULL) / 1000) | 0;
-  (void)arg;
+  uint32_t ret = sgxwasm_time_get(SGXWASM_CLOCK_REALTIME, 0) / 1000000000;
+  if (arg) {
+    emscripten_set_value(&ret, arg, 0, sizeof(uint32_t));
+  }
 #if DEBUG_EM_CALLS
   sgxwasm_log("[_time]: ret - %u\n", ret);
 #endif
@@ -52,9 +52,15 @@ struct EmscriptenContext*
 emscripten_get_context(struct Module*);
 void
 emscripten_cleanup(struct Module*);
-void emscripten_setMemBase(uint64_t, uint64_t);
+void
+emscripten_setMemory(struct Memory*);
 uint64_t
 emscripten_getMemBase();
+// Return non-zero if the wasm side of the copy is out of the memory.
+int
+emscripten_copy_from_wasm(void*, void*, size_t);
+int
+emscripten_copy_to_wasm(void*, void*, size_t);
 int
 emscripten_setDynamicBase(struct EmscriptenContext*);
 void
@@ -87,7 +87,9 @@ DEFINE_EXTERNAL_WASM_TABLE(table)
 END_TABLE_DEFS()
 
 START_MEMORY_DEFS()
-DEFINE_WASM_MEMORY(memory, 256, 256)
+DEFINE_WASM_MEMORY(memory,
+                   SGXWASM_EMSCRIPTEN_PAGES,
+                   SGXWASM_EMSCRIPTEN_MAX_PAGES)
 END_MEMORY_DEFS()
 
 START_GLOBAL_DEFS()
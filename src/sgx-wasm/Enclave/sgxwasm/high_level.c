@@ -26,8 +26,10 @@
 
 #include <sgxwasm/dynamic_emscripten_runtime.h>
 #include <sgxwasm/instantiate.h>
+#include <sgxwasm/loadtime.h>
 #include <sgxwasm/parse.h>
 #include <sgxwasm/sys.h>
+#include <sgxwasm/timesrc.h>
 #include <sgxwasm/util.h>
 
 static int
@@ -96,26 +98,38 @@ sgxwasm_high_instantiate_buf(struct WasmJITHigh* self,
   struct ParseState pstate;
   struct WASMModule wasm_module;
   struct Module* module = NULL;
+  const struct CodeCacheKey* cache_key_ptr = NULL;
+  struct HardeningProfile profile;
+  const struct HardeningProfile* profile_ptr = NULL;
 
   (void)flags;
 
   sgxwasm_init_wasm_module(&wasm_module);
+  sgxwasm_profile_init(&profile);
 
   if (!init_pstate(&pstate, buf, size)) {
     printf("failed to init pstate\n");
     goto error;
   }
 
+#if SGXWASM_LOADTIME_PROFILE
+  struct LoadTimeSpan span;
+  sgxwasm_loadtime_reset();
+  sgxwasm_loadtime_start(&span, 0);
+#endif
 #if SGXWASM_LOADTIME_BENCH
   uint64_t t1, t2;
-  ocall_sgx_rdtsc(&t1);
+  t1 = sgxwasm_cycles();
 #endif
   if (!read_wasm_module(&pstate, &wasm_module, NULL, 0)) {
     printf("failed to read wasm module\n");
     goto error;
   }
+#if SGXWASM_LOADTIME_PROFILE
+  sgxwasm_loadtime_phase(LOADTIME_PARSE, &span, 0);
+#endif
 #if SGXWASM_LOADTIME_BENCH
-  ocall_sgx_rdtsc(&t2);
+  t2 = sgxwasm_cycles();
   //printf("parsing time: %lu\n", t2 - t1);
   printf("%lu\t", t2 - t1);
 #endif
@@ -129,17 +143,29 @@ sgxwasm_high_instantiate_buf(struct WasmJITHigh* self,
   /* TODO: validate module */
 
 #if SGXWASM_LOADTIME_BENCH
-  ocall_sgx_rdtsc(&t1);
+  t1 = sgxwasm_cycles();
+#endif
+  if (sgxwasm_profile_load(&profile, SGXWASM_PROFILE_PATH)) {
+    profile_ptr = &profile;
+  }
+  // Profiling code refers to the counters of this instance.
+#if SGXWASM_CODE_CACHE && !__PROFILE__
+  struct CodeCacheKey cache_key;
+  if (sgxwasm_cache_key(&cache_key, buf, size, pm, config, profile_ptr)) {
+    cache_key_ptr = &cache_key;
+  }
 #endif
   module = sgxwasm_instantiate(&wasm_module,
                                pm,
                                config,
+                               cache_key_ptr,
+                               profile_ptr,
                                self->n_modules,
                                self->modules,
                                self->error_buffer,
                                sizeof(self->error_buffer));
 #if SGXWASM_LOADTIME_BENCH
-  ocall_sgx_rdtsc(&t2);
+  t2 = sgxwasm_cycles();
   //printf("compilation time: %lu\n", t2 - t1);
   printf("%lu\n", t2 - t1);
 #endif
@@ -164,7 +190,15 @@ sgxwasm_high_instantiate_buf(struct WasmJITHigh* self,
     ret = 0;
   }
 
+#if SGXWASM_LOADTIME_PROFILE
+  if (ret == 0) {
+    sgxwasm_loadtime_report(module_name);
+  }
+  sgxwasm_loadtime_reset();
+#endif
+
   sgxwasm_free_wasm_module(&wasm_module);
+  sgxwasm_profile_free(&profile);
 
   if (module) {
     sgxwasm_free_module(module);
@@ -248,7 +282,7 @@ sgxwasm_high_instantiate_emscripten_runtime(struct WasmJITHigh* self,
 
   // TODO: Find better way to do this.
   mem = self->emscripten_env_module->mems.data[0];
-  emscripten_setMemBase((uint64_t)mem->data, mem->size);
+  emscripten_setMemory(mem);
 
   if (emscripten_setDynamicBase(ctx) != 0) {
     printf("emscripten_setDynamicBase failed\n");
@@ -368,6 +402,39 @@ error:
   return ret;
 }
 
+int
+sgxwasm_high_dump_profile(struct WasmJITHigh* self,
+                          const char* module_name,
+                          const char* path)
+{
+  size_t i;
+
+  for (i = 0; i < self->n_modules; ++i) {
+    if (!strcmp(self->modules[i].name, module_name)) {
+      return sgxwasm_profile_dump(self->modules[i].module, path) ? 0 : -1;
+    }
+  }
+  return -1;
+}
+
+int
+sgxwasm_high_format_profile(struct WasmJITHigh* self,
+                            const char* module_name,
+                            char* buf,
+                            size_t size,
+                            size_t* len)
+{
+  size_t i;
+
+  for (i = 0; i < self->n_modules; ++i) {
+    if (!strcmp(self->modules[i].name, module_name)) {
+      *len = sgxwasm_profile_format(self->modules[i].module, buf, size);
+      return 0;
+    }
+  }
+  return -1;
+}
+
 void
 sgxwasm_high_close(struct WasmJITHigh* self)
 {
@@ -68,6 +68,19 @@ sgxwasm_high_emscripten_invoke_main(struct WasmJITHigh* self,
                                     char** argv,
                                     char** envp,
                                     uint32_t flags);
+// Write the hardening profile collected by a __PROFILE__ build.
+int
+sgxwasm_high_dump_profile(struct WasmJITHigh* self,
+                          const char* module_name,
+                          const char* path);
+// Format the same profile into buf (see sgxwasm_profile_format) and
+// set *len to its full length.
+int
+sgxwasm_high_format_profile(struct WasmJITHigh* self,
+                            const char* module_name,
+                            char* buf,
+                            size_t size,
+                            size_t* len);
 void
 sgxwasm_high_close(struct WasmJITHigh* self);
 int
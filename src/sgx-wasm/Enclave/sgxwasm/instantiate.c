@@ -26,6 +26,8 @@
 #include <sgxwasm/instantiate.h>
 
 #include <sgxwasm/compile.h>
+#include <sgxwasm/loadtime.h>
+#include <sgxwasm/parallel.h>
 #include <sgxwasm/parse.h>
 #include <sgxwasm/relocate.h>
 #include <sgxwasm/runtime.h>
@@ -408,10 +410,66 @@ error:
   return 0;
 }
 
+struct CompileJobs
+{
+  const struct WASMModule* wasm_module;
+  struct Module* module;
+  struct PassManager* pm;
+  const struct ModuleTypes* module_types;
+  size_t number_funs;
+  unsigned global_compile_flags;
+  struct CompileResult* results;
+};
+
+// Compile the i-th function of the code section. May run on any
+// compile thread, so it only touches the function's own state.
+static int
+compile_job(void* arg, size_t i)
+{
+  struct CompileJobs* jobs = arg;
+  const struct WASMModule* wasm_module = jobs->wasm_module;
+  struct Module* module = jobs->module;
+  struct CompileResult* result = &jobs->results[i];
+  struct CodeSectionCode* code = &wasm_module->code_section.codes[i];
+  struct Memory* memory = NULL;
+  size_t fun_index = i + module->n_imported_funcs;
+  struct Function* func = module->funcs.data[fun_index];
+  unsigned compile_flags = jobs->global_compile_flags;
+#if SGXWASM_LOADTIME_PROFILE
+  struct LoadTimeSpan span;
+#endif
+
+  // assert(module->mems.size > 0);
+  // XXX: Current spec supports only one memory.
+  if (module->mems.size > 0) {
+    memory = module->mems.data[0];
+    if (func->name || (wasm_module->start_section.has_start &&
+                       wasm_module->start_section.funcidx == fun_index)) {
+      compile_flags |= SGXWASM_COMPILE_FLAG_ENTRY;
+    }
+  }
+
+#if SGXWASM_LOADTIME_PROFILE
+  sgxwasm_loadtime_start(&span, 0);
+#endif
+  result->unmapped = sgxwasm_compile_function(
+    jobs->pm, &module->types, jobs->module_types, func, memory,
+    jobs->number_funs, code, &result->memrefs, &result->code_size,
+    &func->stack_usage, compile_flags);
+#if SGXWASM_LOADTIME_PROFILE
+  sgxwasm_loadtime_function(fun_index, LOADTIME_COMPILE, &span,
+                            result->code_size);
+#endif
+
+  return result->unmapped != NULL;
+}
+
 struct Module*
 sgxwasm_instantiate(const struct WASMModule* wasm_module,
                     struct PassManager* pm, struct SystemConfig* config,
-                    size_t n_imports, const struct NamedModule* imports,
+                    const struct CodeCacheKey* cache_key,
+                    const struct HardeningProfile* profile, size_t n_imports,
+                    const struct NamedModule* imports,
                     char* why, size_t why_size)
 {
   uint32_t i;
@@ -421,9 +479,9 @@ sgxwasm_instantiate(const struct WASMModule* wasm_module,
   struct Table* tmp_table = NULL;
   struct Memory* tmp_mem = NULL;
   struct Global* tmp_global = NULL;
-  void *unmapped = NULL, *mapped = NULL;
-  struct MemoryReferences memrefs = { 0, 0, NULL };
-  size_t code_size;
+  void* mapped = NULL;
+  struct CompileJobs jobs;
+  struct CompileResult* results = NULL;
   unsigned global_compile_flags;
   struct RelocationTable relo_table = { 0, NULL };
   size_t number_funs = 0;
@@ -436,6 +494,9 @@ sgxwasm_instantiate(const struct WASMModule* wasm_module,
   // Relocation at code-unit level.
   int use_code_unit = 0;
   int enable_aslr = 0;
+#if SGXWASM_LOADTIME_PROFILE
+  struct LoadTimeSpan span;
+#endif
 
   sgxwasm_init_code_region(CodeSize);
 
@@ -451,6 +512,14 @@ sgxwasm_instantiate(const struct WASMModule* wasm_module,
     use_code_unit = 1;
   }
 
+  // An indirect jmp would bypass the instrumentation of branches, and
+  // a table must not be split across code units.
+  if (__BR_JUMP_TABLE__ && !FIX_SIZE_ASLR && !pass_is_enabled(pm, "aslr") &&
+      !pass_is_enabled(pm, "tsgx") && !pass_is_enabled(pm, "varys") &&
+      !pass_is_enabled(pm, "lspectre")) {
+    global_compile_flags |= SGXWASM_COMPILE_FLAG_JUMP_TABLE;
+  }
+
   memset(&module_types, 0, sizeof(module_types));
   module = calloc(1, sizeof(*module));
   if (!module)
@@ -540,9 +609,9 @@ if (!sgxwasm_typecheck_func(type, func)) {
           // Allow referencing module using func.
           func->module = module;
 
-          /* add func to func table */
-          size_t type_index =
-            dedup_type(&module->types, import->desc.functypeidx);
+          /* add func to func table, types are interned by the parser */
+          size_t type_index = import->desc.functypeidx;
+          assert(type_index < module->types.size);
           LVECTOR_GROW(&module->funcs);
           module->funcs.data[module->funcs.size - 1] = func;
           // module->funcs.data[module->funcs.size - 1]->type_index =
@@ -720,9 +789,9 @@ if (!sgxwasm_typecheck_func(type, func)) {
     if (!tmp_func)
       goto error;
 
-    // size_t type_index = wasm_module->function_section.typeidxs[i];
-    size_t type_index =
-      dedup_type(&module->types, wasm_module->function_section.typeidxs[i]);
+    // Types are interned by the parser.
+    size_t type_index = wasm_module->function_section.typeidxs[i];
+    assert(type_index < module->types.size);
     tmp_func->module = module;
     tmp_func->code = NULL;
     tmp_func->size = 0;
@@ -788,17 +857,12 @@ if (!sgxwasm_typecheck_func(type, func)) {
     if (!tmp_mem)
       goto error;
 
-    if (size) {
-      tmp_mem->data = calloc(size, 1);
-      if (!tmp_mem->data) {
-        free(tmp_mem);
-        goto error;
-      }
+    if (!sgxwasm_memory_init(tmp_mem, size, max)) {
+      free(tmp_mem);
+      tmp_mem = NULL;
+      goto error;
     }
 
-    tmp_mem->size = size;
-    tmp_mem->max = max;
-
     // printf(
     //  "Allocate memory: size: 0x%lx, index: %zu\n", size, module->mems.size);
     LVECTOR_GROW(&module->mems);
@@ -991,127 +1055,196 @@ if (!sgxwasm_typecheck_func(type, func)) {
   printf("[sgxwasm_instantiate] code section\n");
 #endif
 
+  results = calloc(wasm_module->code_section.n_codes,
+                   sizeof(struct CompileResult));
+  if (wasm_module->code_section.n_codes > 0 && !results)
+    goto error;
+
   for (i = 0; i < wasm_module->code_section.n_codes; ++i) {
-    struct CodeSectionCode* code = &wasm_module->code_section.codes[i];
-    struct Memory* memory;
-    struct Function* func;
-    size_t j;
     size_t fun_index = i + module->n_imported_funcs;
-
-    func = module->funcs.data[fun_index];
+    struct Function* func = module->funcs.data[fun_index];
     func->fun_index = fun_index;
 
     // Allow referencing module using Function.
     func->module = module;
 
-    if (memrefs.data) {
-      free(memrefs.data);
-      memrefs.capacity = 0;
-      memrefs.size = 0;
-      memrefs.data = NULL;
-    }
+    func->hash = wasm_module->code_section.codes[i].hash;
+    func->hardening = sgxwasm_profile_lookup(profile, func->name, func->hash);
+  }
 
-    // assert(module->mems.size > 0);
-    // XXX: Current spec supports only one memory.
-    if (module->mems.size > 0) {
-      memory = module->mems.data[0];
+  // Compile the functions, possibly in parallel. Everything that
+  // depends on the order (relocation entries, code units and code
+  // placement) is done below, in function order, so the result does
+  // not depend on the number of threads.
+  jobs.wasm_module = wasm_module;
+  jobs.module = module;
+  jobs.pm = pm;
+  jobs.module_types = &module_types;
+  jobs.number_funs = number_funs;
+  jobs.global_compile_flags = global_compile_flags;
+  jobs.results = results;
+#if SGXWASM_LOADTIME_PROFILE
+  if (!sgxwasm_loadtime_functions(module->n_imported_funcs,
+                                  wasm_module->code_section.n_codes, pm)) {
+    printf("[sgxwasm_loadtime_functions] failed\n");
+  }
+  sgxwasm_loadtime_start(&span, 0);
+#endif
+#if SGXWASM_CODE_CACHE
+  if (cache_key && sgxwasm_cache_load(cache_key, results,
+                                      wasm_module->code_section.n_codes)) {
+#if __DEMO__
+    printf("[PRIDWEN] Code cache hit\n");
+#endif
+  } else {
+#endif
+    if (!sgxwasm_parallel_for(SGXWASM_COMPILE_THREADS,
+                              wasm_module->code_section.n_codes, compile_job,
+                              &jobs))
+      goto error;
+#if SGXWASM_CODE_CACHE
+    if (cache_key && !sgxwasm_cache_store(cache_key, results,
+                                          wasm_module->code_section.n_codes)) {
+      printf("[sgxwasm_cache_store] failed\n");
     }
+  }
+#else
+  (void)cache_key;
+#endif
+#if SGXWASM_LOADTIME_PROFILE
+  {
+    size_t code_bytes = 0;
+    for (i = 0; i < wasm_module->code_section.n_codes; ++i) {
+      code_bytes += results[i].code_size;
+    }
+    sgxwasm_loadtime_phase(LOADTIME_COMPILE, &span, code_bytes);
+  }
+#endif
 
-    if (unmapped)
-      free(unmapped);
-
-    assert(mapped == NULL);
-    unmapped = sgxwasm_compile_function(
-      pm, &module->types, &module_types, func, memory, number_funs, code,
-      &memrefs, &code_size, &func->stack_usage, global_compile_flags);
-    if (!unmapped)
-      goto error;
+  for (i = 0; i < wasm_module->code_section.n_codes; ++i) {
+    struct CompileResult* result = &results[i];
+    struct MemoryReferences* memrefs = &result->memrefs;
+    void* unmapped = result->unmapped;
+    size_t code_size = result->code_size;
+    size_t fun_index = i + module->n_imported_funcs;
+    struct Function* func = module->funcs.data[fun_index];
+    size_t j;
 
     // Collect relocation information.
-    for (j = 0; j < memrefs.size; ++j) {
-      switch (memrefs.data[j].type) {
+    for (j = 0; j < memrefs->size; ++j) {
+      switch (memrefs->data[j].type) {
         case MEMREF_FUNC: {
           add_relo_entry(&relo_table, func->fun_index, RELO_CALL,
-                         &memrefs.data[j]);
+                         &memrefs->data[j]);
+          break;
+        }
+        case MEMREF_FUNC_REL: {
+          add_relo_entry(&relo_table, func->fun_index, RELO_CALL_REL,
+                         &memrefs->data[j]);
+          break;
+        }
+        case MEMREF_JUMP_TABLE: {
+          add_relo_entry(&relo_table, func->fun_index, RELO_JUMP_TABLE,
+                         &memrefs->data[j]);
+          break;
+        }
+        case MEMREF_JUMP_TABLE_ENTRY: {
+          add_relo_entry(&relo_table, func->fun_index, RELO_JUMP_TABLE_ENTRY,
+                         &memrefs->data[j]);
+          break;
+        }
+        case MEMREF_JUMP_TABLE_CASE: {
+          add_relo_entry(&relo_table, func->fun_index, RELO_JUMP_TABLE_CASE,
+                         &memrefs->data[j]);
           break;
         }
         case MEMREF_MEM: {
           add_relo_entry(&relo_table, func->fun_index, RELO_MEM,
-                         &memrefs.data[j]);
+                         &memrefs->data[j]);
+          break;
+        }
+        case MEMREF_MEMORY: {
+          add_relo_entry(&relo_table, func->fun_index, RELO_MEMORY,
+                         &memrefs->data[j]);
+          break;
+        }
+        case MEMREF_MEMORY_GROW: {
+          add_relo_entry(&relo_table, func->fun_index, RELO_MEMORY_GROW,
+                         &memrefs->data[j]);
           break;
         }
         case MEMREF_GLOBAL: {
           add_relo_entry(&relo_table, func->fun_index, RELO_GLOBAL,
-                         &memrefs.data[j]);
+                         &memrefs->data[j]);
           break;
         }
         case MEMREF_TABLE: {
           add_relo_entry(&relo_table, func->fun_index, RELO_TABLE_REFS,
-                         &memrefs.data[j]);
+                         &memrefs->data[j]);
           break;
         }
         case MEMREF_TABLE_SIGS: {
           add_relo_entry(&relo_table, func->fun_index, RELO_TABLE_SIGS,
-                         &memrefs.data[j]);
+                         &memrefs->data[j]);
           break;
         }
         case MEMREF_TABLE_SIZE: {
           add_relo_entry(&relo_table, func->fun_index, RELO_TABLE_SIZE,
-                         &memrefs.data[j]);
+                         &memrefs->data[j]);
           break;
         }
         case MEMREF_SPRINGBOARD_BEGIN: {
           add_relo_entry(&relo_table, func->fun_index, RELO_SPRINGBOARD_BEGIN,
-                         &memrefs.data[j]);
+                         &memrefs->data[j]);
           break;
         }
         case MEMREF_SPRINGBOARD_NEXT: {
           add_relo_entry(&relo_table, func->fun_index, RELO_SPRINGBOARD_NEXT,
-                         &memrefs.data[j]);
+                         &memrefs->data[j]);
           break;
         }
         case MEMREF_SPRINGBOARD_END: {
           add_relo_entry(&relo_table, func->fun_index, RELO_SPRINGBOARD_END,
-                         &memrefs.data[j]);
+                         &memrefs->data[j]);
           break;
         }
         case MEMREF_SSA_POLLING: {
           add_relo_entry(&relo_table, func->fun_index, RELO_SSA_POLLING,
-                         &memrefs.data[j]);
+                         &memrefs->data[j]);
           break;
         }
         case MEMREF_JMP_NEXT: {
           add_relo_entry(&relo_table, func->fun_index, RELO_JMP_NEXT,
-                         &memrefs.data[j]);
+                         &memrefs->data[j]);
           break;
         }
         case MEMREF_LEA_NEXT: {
           add_relo_entry(&relo_table, func->fun_index, RELO_LEA_NEXT,
-                         &memrefs.data[j]);
+                         &memrefs->data[j]);
           break;
         }
         case MEMREF_BR_TABLE_JMP: {
           add_relo_entry(&relo_table, func->fun_index, RELO_BR_TABLE_JMP,
-                         &memrefs.data[j]);
+                         &memrefs->data[j]);
           break;
         }
         case MEMREF_BR_CASE_JMP: {
           add_relo_entry(&relo_table, func->fun_index, RELO_BR_CASE_JMP,
-                         &memrefs.data[j]);
+                         &memrefs->data[j]);
           break;
         }
         case MEMREF_BR_TABLE_TARGET: {
           add_relo_entry(&relo_table, func->fun_index, RELO_BR_TABLE_TARGET,
-                         &memrefs.data[j]);
+                         &memrefs->data[j]);
           break;
         }
         case MEMREF_BR_CASE_TARGET: {
           add_relo_entry(&relo_table, func->fun_index, RELO_BR_CASE_TARGET,
-                         &memrefs.data[j]);
+                         &memrefs->data[j]);
           break;
         }
         case MEMREF_CODE_UNIT: {
-          add_code_unit(&code_table, func->fun_index, &memrefs.data[j]);
+          add_code_unit(&code_table, func->fun_index, &memrefs->data[j]);
           break;
         }
         case MEMREF_TRAP:
@@ -1123,6 +1256,9 @@ if (!sgxwasm_typecheck_func(type, func)) {
 
     // enable_aslr = 0;
 
+#if SGXWASM_LOADTIME_PROFILE
+    sgxwasm_loadtime_start(&span, 0);
+#endif
     if (use_code_unit) {
       convert_to_unit_relo_info(fun_index, &relo_table, &code_table);
       mapped =
@@ -1133,11 +1269,20 @@ if (!sgxwasm_typecheck_func(type, func)) {
         goto error;
       memcpy(mapped, unmapped, code_size);
     }
+#if SGXWASM_LOADTIME_PROFILE
+    sgxwasm_loadtime_function(fun_index, LOADTIME_LAYOUT, &span, code_size);
+    sgxwasm_loadtime_phase(LOADTIME_LAYOUT, &span, code_size);
+#endif
     func->code = mapped;
     func->size = code_size;
     set_code_entry_offset(&code_table, func->fun_index, (uint64_t)func->code);
     mapped = NULL;
 
+    free(result->unmapped);
+    result->unmapped = NULL;
+    free(memrefs->data);
+    memrefs->data = NULL;
+
 //#if DEBUG_INSTANTIATE
     if (func->fun_index == 17) {
     dump_compile_code(func->code, func->size, func->fun_index);
@@ -1178,14 +1323,35 @@ if (!sgxwasm_typecheck_func(type, func)) {
   }
 
   // Relocation
+#if SGXWASM_LOADTIME_PROFILE
+  sgxwasm_loadtime_start(&span, 0);
+#endif
   relocate(module, &relo_table, &indirect_table, &code_table, &springboard,
            ssa_polling_addr, use_code_unit);
+#if SGXWASM_LOADTIME_PROFILE
+  sgxwasm_loadtime_phase(LOADTIME_RELOCATE, &span, 0);
+#endif
 
 #if __PASS__
+#if SGXWASM_LOADTIME_PROFILE
+  sgxwasm_loadtime_start(&span, 0);
+#endif
   passes_validation(pm, &code_table);
+#if SGXWASM_LOADTIME_PROFILE
+  sgxwasm_loadtime_phase(LOADTIME_VALIDATION, &span, 0);
+#endif
 #endif
 #if DEBUG_RELOCATE
   dump_code_units(&code_table);
+  {
+    struct CodeRegionStats stats;
+    sgxwasm_code_region_stats(&stats);
+    printf("[code_region] units: %zu/%zu free, extents: %zu (largest: %zu), "
+           "allocs: %zu (%zu randomized, %zu retries), entropy batches: %zu\n",
+           stats.free_units, stats.total_units, stats.n_extents,
+           stats.largest_extent, stats.n_allocs, stats.n_rand_allocs,
+           stats.n_rejections, stats.n_entropy_batches);
+  }
 #endif
 
 #if 0
@@ -1225,6 +1391,9 @@ if (!sgxwasm_typecheck_func(type, func)) {
 #endif
 
   // Initialize data.
+#if SGXWASM_LOADTIME_PROFILE
+  sgxwasm_loadtime_start(&span, 0);
+#endif
   for (i = 0; i < wasm_module->data_section.n_datas; ++i) {
     struct DataSectionData* data = &wasm_module->data_section.datas[i];
     struct Memory* memory = module->mems.data[data->memidx];
@@ -1249,6 +1418,9 @@ if (!sgxwasm_typecheck_func(type, func)) {
     dump_mem_bytes(memory->data, value.data.i32 + data->buf_size);
 #endif
   }
+#if SGXWASM_LOADTIME_PROFILE
+  sgxwasm_loadtime_phase(LOADTIME_DATA_INIT, &span, 0);
+#endif
 
 #if SGXWASM_BINARY_SIZE
   uint64_t binary_size;
@@ -1298,16 +1470,20 @@ if (!sgxwasm_typecheck_func(type, func)) {
     free(tmp_table);
   }
   if (tmp_mem) {
-    if (tmp_mem->data)
-      free(tmp_mem->data);
+    sgxwasm_memory_free(tmp_mem);
     free(tmp_mem);
   }
   if (tmp_global)
     free(tmp_global);
-  if (unmapped)
-    free(unmapped);
-  if (memrefs.data)
-    free(memrefs.data);
+  if (results) {
+    for (i = 0; i < wasm_module->code_section.n_codes; ++i) {
+      if (results[i].unmapped)
+        free(results[i].unmapped);
+      if (results[i].memrefs.data)
+        free(results[i].memrefs.data);
+    }
+    free(results);
+  }
   if (module_types.functypes)
     free(module_types.functypes);
   if (module_types.tabletypes)
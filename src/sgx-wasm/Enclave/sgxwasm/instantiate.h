@@ -27,8 +27,10 @@
 
 #include <sgxwasm/config.h>
 #include <sgxwasm/ast.h>
+#include <sgxwasm/cache.h>
 #include <sgxwasm/runtime.h>
 #include <sgxwasm/pass.h>
+#include <sgxwasm/profile.h>
 #include <sgxwasm/config.h>
 #include <sgxwasm/sense.h>
 
@@ -36,6 +38,8 @@ struct Module*
 sgxwasm_instantiate(const struct WASMModule* module,
                     struct PassManager *pm,
                     struct SystemConfig *config,
+                    const struct CodeCacheKey *cache_key,
+                    const struct HardeningProfile *profile,
                     size_t n_imports,
                     const struct NamedModule* imports,
                     char* why,
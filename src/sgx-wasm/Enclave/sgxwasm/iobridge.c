@@ -0,0 +1,195 @@
+#include <sgxwasm/emscripten.h>
+#include <sgxwasm/iobridge.h>
+#include <sgxwasm/sys.h>
+
+#if __SGX__
+#include "common.h"
+#include "sgx_trts.h"
+
+#define WINDOW_SIZE (sizeof(struct io_request) + SGXWASM_IO_WINDOW_SIZE)
+
+// Wasm code runs on a single thread, so one window is enough.
+static struct io_request* window = NULL;
+
+static struct io_request*
+get_window(void)
+{
+  void* p;
+  if (window) {
+    return window;
+  }
+  p = sgxwasm_io_window(WINDOW_SIZE);
+  if (p && sgx_is_outside_enclave(p, WINDOW_SIZE)) {
+    window = p;
+  }
+  return window;
+}
+
+static char*
+window_data(struct io_request* req)
+{
+  return (char*)(req + 1);
+}
+
+static long
+submit(struct io_request* req, int op, int fd, int flags, size_t len)
+{
+  long ret;
+  int err;
+
+  req->op = op;
+  req->fd = fd;
+  req->flags = flags;
+  req->len = len;
+  req->err = 0;
+  ret = sgxwasm_io_submit(req);
+  if (ret < 0) {
+    err = req->err;
+    return err > 0 ? -err : -EIO;
+  }
+  if ((size_t)ret > len) {
+    return -EIO;
+  }
+  return ret;
+}
+
+// Gather the iovecs into the window and write them in chunks of at most
+// SGXWASM_IO_WINDOW_SIZE bytes, until one is short.
+static long
+write_chunks(int op, int fd, const struct iovec* iov, int iovcnt, int flags)
+{
+  struct io_request* req = get_window();
+  char* data;
+  long total = 0, ret;
+  size_t len, off = 0, n;
+  int i = 0;
+
+  if (!req) {
+    return -ENOMEM;
+  }
+  data = window_data(req);
+
+  while (i < iovcnt) {
+    len = 0;
+    while (i < iovcnt && len < SGXWASM_IO_WINDOW_SIZE) {
+      n = iov[i].iov_len - off;
+      if (n > SGXWASM_IO_WINDOW_SIZE - len) {
+        n = SGXWASM_IO_WINDOW_SIZE - len;
+      }
+      if (emscripten_copy_from_wasm(data + len,
+                                    (char*)iov[i].iov_base + off, n)) {
+        return total ? total : -EFAULT;
+      }
+      len += n;
+      off += n;
+      if (off == iov[i].iov_len) {
+        i++;
+        off = 0;
+      }
+    }
+    if (len == 0) {
+      break;
+    }
+    ret = submit(req, op, fd, flags, len);
+    if (ret < 0) {
+      return total ? total : ret;
+    }
+    total += ret;
+    if ((size_t)ret < len) {
+      break;
+    }
+  }
+  return total;
+}
+
+// A single read of at most SGXWASM_IO_WINDOW_SIZE bytes, scattered over
+// the iovecs.
+static long
+read_once(int op, int fd, const struct iovec* iov, int iovcnt, int flags)
+{
+  struct io_request* req = get_window();
+  char* data;
+  long ret;
+  size_t len = 0, off = 0, n;
+  int i;
+
+  if (!req) {
+    return -ENOMEM;
+  }
+  data = window_data(req);
+
+  for (i = 0; i < iovcnt && len < SGXWASM_IO_WINDOW_SIZE; i++) {
+    n = iov[i].iov_len;
+    len += n < SGXWASM_IO_WINDOW_SIZE - len ? n : SGXWASM_IO_WINDOW_SIZE - len;
+  }
+  ret = submit(req, op, fd, flags, len);
+  if (ret <= 0) {
+    return ret;
+  }
+
+  for (i = 0; off < (size_t)ret; i++) {
+    n = iov[i].iov_len;
+    if (n > (size_t)ret - off) {
+      n = (size_t)ret - off;
+    }
+    if (emscripten_copy_to_wasm(iov[i].iov_base, data + off, n)) {
+      return -EFAULT;
+    }
+    off += n;
+  }
+  return ret;
+}
+
+long
+sgxwasm_io_writev(int fd, const struct iovec* iov, int iovcnt)
+{
+  return write_chunks(IO_REQUEST_WRITE, fd, iov, iovcnt, 0);
+}
+
+long
+sgxwasm_io_readv(int fd, const struct iovec* iov, int iovcnt)
+{
+  return read_once(IO_REQUEST_READ, fd, iov, iovcnt, 0);
+}
+
+long
+sgxwasm_io_send(int fd, const void* buf, size_t len, int flags)
+{
+  struct iovec iov = { (void*)buf, len };
+  return write_chunks(IO_REQUEST_SEND, fd, &iov, 1, flags);
+}
+
+long
+sgxwasm_io_recv(int fd, void* buf, size_t len, int flags)
+{
+  struct iovec iov = { buf, len };
+  return read_once(IO_REQUEST_RECV, fd, &iov, 1, flags);
+}
+
+#else
+
+long
+sgxwasm_io_writev(int fd, const struct iovec* iov, int iovcnt)
+{
+  return sys_writev(fd, iov, iovcnt);
+}
+
+long
+sgxwasm_io_readv(int fd, const struct iovec* iov, int iovcnt)
+{
+  return sys_readv(fd, iov, iovcnt);
+}
+
+long
+sgxwasm_io_send(int fd, const void* buf, size_t len, int flags)
+{
+  return sys_send(fd, buf, len, flags);
+}
+
+long
+sgxwasm_io_recv(int fd, void* buf, size_t len, int flags)
+{
+  return sys_recv(fd, buf, len, flags);
+}
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef __SGXWASM__IOBRIDGE_H__
+#define __SGXWASM__IOBRIDGE_H__
+
+#include <sgxwasm/config.h>
+#include <sgxwasm/emscripten_runtime_sys.h>
+
+// I/O bridge for the emscripten syscalls that move buffers.
+//
+// The buffers point into the linear memory and must have been checked
+// by the caller. Without SGX they are handed to the host as they are.
+// For SGX, the data is copied once between the linear memory and a
+// window of untrusted memory (SGXWASM_IO_WINDOW_SIZE bytes, allocated
+// on first use), and each call is submitted with a single switchless
+// ocall whatever the number of iovecs. Results are never trusted beyond
+// the length that was asked for.
+//
+// All return the result of the syscall or -errno, like sys_*().
+
+long
+sgxwasm_io_writev(int fd, const struct iovec* iov, int iovcnt);
+long
+sgxwasm_io_readv(int fd, const struct iovec* iov, int iovcnt);
+long
+sgxwasm_io_send(int fd, const void* buf, size_t len, int flags);
+long
+sgxwasm_io_recv(int fd, void* buf, size_t len, int flags);
+
+#endif
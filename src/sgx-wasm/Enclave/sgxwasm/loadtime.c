@@ -0,0 +1,232 @@
+#include <sgxwasm/loadtime.h>
+#include <sgxwasm/timesrc.h>
+
+#if SGXWASM_LOADTIME_PROFILE
+
+static const char* phase_names[LOADTIME_N_PHASES] = {
+  "parse", "compile", "layout", "relocate", "validation", "data_init",
+};
+
+#if SGXWASM_LOADTIME_PROFILE > 1
+static const char* hook_names[LOADTIME_N_HOOKS] = {
+  "function_start",     "function_end",      "control_start",
+  "control_end",        "instruction_start", "instruction_end",
+  "machine_inst_start", "machine_inst_end",
+};
+#endif
+
+// Counters of one defined function.
+struct LoadTimeFunction
+{
+  struct LoadTimeCounter compile;
+  struct LoadTimeCounter layout;
+#if SGXWASM_LOADTIME_PROFILE > 1
+  // n_passes * LOADTIME_N_HOOKS, indexed by pass, then hook.
+  struct LoadTimeCounter* hooks;
+#endif
+};
+
+static struct LoadTimeState
+{
+  struct LoadTimeCounter phases[LOADTIME_N_PHASES];
+  const struct PassManager* pm;
+  size_t n_passes;
+  size_t first_index;
+  size_t n_funcs;
+  struct LoadTimeFunction* funcs;
+} state;
+
+static SGXWASM_TLS uint64_t thread_alloc_bytes;
+
+static void
+count(struct LoadTimeCounter* counter, const struct LoadTimeSpan* span,
+      size_t code_size)
+{
+  counter->calls++;
+  counter->cycles += sgxwasm_cycles() - span->cycles;
+  counter->alloc_bytes += thread_alloc_bytes - span->alloc_bytes;
+  if (code_size > span->code_size) {
+    counter->code_bytes += code_size - span->code_size;
+  }
+}
+
+static struct LoadTimeFunction*
+lookup_function(size_t fun_index)
+{
+  if (fun_index < state.first_index ||
+      fun_index - state.first_index >= state.n_funcs) {
+    return NULL;
+  }
+  return &state.funcs[fun_index - state.first_index];
+}
+
+void
+sgxwasm_loadtime_reset(void)
+{
+#if SGXWASM_LOADTIME_PROFILE > 1
+  size_t i;
+  for (i = 0; i < state.n_funcs; i++) {
+    free(state.funcs[i].hooks);
+  }
+#endif
+  free(state.funcs);
+  memset(&state, 0, sizeof(state));
+}
+
+int
+sgxwasm_loadtime_functions(size_t first_index, size_t n_funcs,
+                           const struct PassManager* pm)
+{
+  struct LoadTimeFunction* funcs;
+
+  assert(state.funcs == NULL);
+  if (n_funcs == 0) {
+    return 1;
+  }
+  funcs = calloc(n_funcs, sizeof(struct LoadTimeFunction));
+  if (!funcs) {
+    return 0;
+  }
+  state.pm = pm;
+  state.n_passes = pm ? pm->size : 0;
+  state.first_index = first_index;
+  state.n_funcs = n_funcs;
+  state.funcs = funcs;
+#if SGXWASM_LOADTIME_PROFILE > 1
+  if (state.n_passes > 0) {
+    size_t i;
+    for (i = 0; i < n_funcs; i++) {
+      funcs[i].hooks = calloc(state.n_passes * LOADTIME_N_HOOKS,
+                              sizeof(struct LoadTimeCounter));
+      if (!funcs[i].hooks) {
+        sgxwasm_loadtime_reset();
+        return 0;
+      }
+    }
+  }
+#endif
+  return 1;
+}
+
+void
+sgxwasm_loadtime_alloc(uint64_t n)
+{
+  thread_alloc_bytes += n;
+}
+
+void
+sgxwasm_loadtime_start(struct LoadTimeSpan* span, size_t code_size)
+{
+  span->alloc_bytes = thread_alloc_bytes;
+  span->code_size = code_size;
+  span->cycles = sgxwasm_cycles();
+}
+
+void
+sgxwasm_loadtime_phase(enum LoadTimePhase phase,
+                       const struct LoadTimeSpan* span, size_t code_size)
+{
+  assert(phase < LOADTIME_N_PHASES);
+  count(&state.phases[phase], span, code_size);
+}
+
+void
+sgxwasm_loadtime_function(size_t fun_index, enum LoadTimePhase phase,
+                          const struct LoadTimeSpan* span, size_t code_size)
+{
+  struct LoadTimeFunction* func = lookup_function(fun_index);
+  if (!func) {
+    return;
+  }
+  switch (phase) {
+    case LOADTIME_COMPILE:
+      count(&func->compile, span, code_size);
+      break;
+    case LOADTIME_LAYOUT:
+      count(&func->layout, span, code_size);
+      break;
+    default:
+      assert(0);
+      break;
+  }
+}
+
+#if SGXWASM_LOADTIME_PROFILE > 1
+void
+sgxwasm_loadtime_hook(size_t fun_index, size_t pass_index,
+                      enum LoadTimeHook hook, const struct LoadTimeSpan* span,
+                      size_t code_size)
+{
+  struct LoadTimeFunction* func = lookup_function(fun_index);
+  if (!func || !func->hooks || pass_index >= state.n_passes) {
+    return;
+  }
+  assert(hook < LOADTIME_N_HOOKS);
+  count(&func->hooks[pass_index * LOADTIME_N_HOOKS + hook], span, code_size);
+}
+#endif
+
+static void
+print_counter(const char* module_name, const char* scope, const char* name,
+              const char* hook, size_t fun_index, int has_index,
+              const struct LoadTimeCounter* counter)
+{
+  printf("loadtime\t%s\t%s\t%s%s%s\t", module_name, scope, name,
+         hook ? "/" : "", hook ? hook : "");
+  if (has_index) {
+    printf("%zu", fun_index);
+  } else {
+    printf("-");
+  }
+  printf("\t%lu\t%lu\t%lu\t%lu\n", counter->calls, counter->cycles,
+         counter->alloc_bytes, counter->code_bytes);
+}
+
+void
+sgxwasm_loadtime_report(const char* module_name)
+{
+  size_t i;
+
+  if (!module_name) {
+    module_name = "-";
+  }
+  printf("loadtime\tmodule\tscope\tname\tfunc\tcalls\tcycles\talloc\tcode\n");
+  for (i = 0; i < LOADTIME_N_PHASES; i++) {
+    if (state.phases[i].calls == 0) {
+      continue;
+    }
+    print_counter(module_name, "phase", phase_names[i], NULL, 0, 0,
+                  &state.phases[i]);
+  }
+  for (i = 0; i < state.n_funcs; i++) {
+    struct LoadTimeFunction* func = &state.funcs[i];
+    size_t fun_index = state.first_index + i;
+    if (func->compile.calls) {
+      print_counter(module_name, "function", phase_names[LOADTIME_COMPILE],
+                    NULL, fun_index, 1, &func->compile);
+    }
+    if (func->layout.calls) {
+      print_counter(module_name, "function", phase_names[LOADTIME_LAYOUT],
+                    NULL, fun_index, 1, &func->layout);
+    }
+#if SGXWASM_LOADTIME_PROFILE > 1
+    size_t j, k;
+    if (!func->hooks) {
+      continue;
+    }
+    for (j = 0; j < state.n_passes; j++) {
+      for (k = 0; k < LOADTIME_N_HOOKS; k++) {
+        struct LoadTimeCounter* counter =
+          &func->hooks[j * LOADTIME_N_HOOKS + k];
+        if (counter->calls == 0) {
+          continue;
+        }
+        print_counter(module_name, "hook", state.pm->data[j].name,
+                      hook_names[k], fun_index, 1, counter);
+      }
+    }
+#endif
+  }
+}
+
+#endif
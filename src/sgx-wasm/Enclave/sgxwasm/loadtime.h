@@ -0,0 +1,110 @@
+#ifndef __SGXWASM__LOADTIME_H__
+#define __SGXWASM__LOADTIME_H__
+
+#include <sgxwasm/config.h>
+#include <sgxwasm/pass.h>
+#include <sgxwasm/sys.h>
+
+// Load-time profile.
+//
+// Every phase of loading a module (parse, compile, code placement,
+// relocation, validation and data initialization) is measured in
+// cycles, bytes allocated and bytes of code emitted. Compilation and
+// code placement are also kept per function and, with
+// SGXWASM_LOADTIME_PROFILE > 1, per function, pass and hook. The
+// function counters include the hooks run while compiling it.
+//
+// Allocations are counted per thread, as the bytes by which vectors
+// and the parsed sections grow, so spans on the compile threads do not
+// see each other. sgxwasm_loadtime_report() prints one line per counter
+// with a fixed set of tab-separated fields:
+//
+//   loadtime <module> <scope> <name> <func> <calls> <cycles> <alloc> <code>
+//
+// where scope is phase, function or hook, name is the phase, or
+// <pass>/<hook> for hooks, and func is the function index ("-" for the
+// phases).
+
+#if SGXWASM_LOADTIME_PROFILE
+
+enum LoadTimePhase
+{
+  LOADTIME_PARSE,
+  LOADTIME_COMPILE,
+  LOADTIME_LAYOUT,
+  LOADTIME_RELOCATE,
+  LOADTIME_VALIDATION,
+  LOADTIME_DATA_INIT,
+  LOADTIME_N_PHASES,
+};
+
+enum LoadTimeHook
+{
+  LOADTIME_FUNCTION_START,
+  LOADTIME_FUNCTION_END,
+  LOADTIME_CONTROL_START,
+  LOADTIME_CONTROL_END,
+  LOADTIME_INSTRUCTION_START,
+  LOADTIME_INSTRUCTION_END,
+  LOADTIME_MACHINE_INST_START,
+  LOADTIME_MACHINE_INST_END,
+  LOADTIME_N_HOOKS,
+};
+
+struct LoadTimeCounter
+{
+  uint64_t calls;
+  uint64_t cycles;
+  uint64_t alloc_bytes;
+  uint64_t code_bytes;
+};
+
+// Start of a measured span, taken on the thread that ends it.
+struct LoadTimeSpan
+{
+  uint64_t cycles;
+  uint64_t alloc_bytes;
+  size_t code_size;
+};
+
+// Drop the counters of the previous module.
+void
+sgxwasm_loadtime_reset(void);
+
+// Set up the function counters of a module whose defined functions
+// are first_index .. first_index + n_funcs - 1. Returns 0 on failure,
+// in which case only the phases are kept.
+int
+sgxwasm_loadtime_functions(size_t first_index, size_t n_funcs,
+                           const struct PassManager*);
+
+// Count bytes allocated by the calling thread.
+void
+sgxwasm_loadtime_alloc(uint64_t);
+
+// code_size is the size of the code the span emits into, if any.
+void
+sgxwasm_loadtime_start(struct LoadTimeSpan*, size_t code_size);
+
+void
+sgxwasm_loadtime_phase(enum LoadTimePhase, const struct LoadTimeSpan*,
+                       size_t code_size);
+
+// Only LOADTIME_COMPILE and LOADTIME_LAYOUT are kept per function.
+void
+sgxwasm_loadtime_function(size_t fun_index, enum LoadTimePhase,
+                          const struct LoadTimeSpan*, size_t code_size);
+
+#if SGXWASM_LOADTIME_PROFILE > 1
+void
+sgxwasm_loadtime_hook(size_t fun_index, size_t pass_index,
+                      enum LoadTimeHook, const struct LoadTimeSpan*,
+                      size_t code_size);
+#endif
+
+void
+sgxwasm_loadtime_report(const char* module_name);
+
+#endif
+
+#endif
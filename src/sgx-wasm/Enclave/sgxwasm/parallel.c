@@ -0,0 +1,81 @@
+#include <sgxwasm/parallel.h>
+
+#if !__SGX__
+#include <pthread.h>
+#endif
+
+// Only one parallel_for runs at a time (instantiation is serial).
+static struct ParallelState
+{
+  parallel_job_t job;
+  void* arg;
+  size_t n_jobs;
+  size_t next;
+  int failed;
+} state;
+
+void
+sgxwasm_parallel_worker(void)
+{
+  size_t i;
+  while ((i = __sync_fetch_and_add(&state.next, 1)) < state.n_jobs) {
+    if (!state.job(state.arg, i)) {
+      __sync_lock_test_and_set(&state.failed, 1);
+    }
+  }
+}
+
+#if !__SGX__
+static void*
+worker_main(void* arg)
+{
+  (void)arg;
+  sgxwasm_parallel_worker();
+  return NULL;
+}
+#endif
+
+int
+sgxwasm_parallel_for(size_t n_threads, size_t n_jobs, parallel_job_t job,
+                     void* arg)
+{
+  state.job = job;
+  state.arg = arg;
+  state.n_jobs = n_jobs;
+  state.next = 0;
+  state.failed = 0;
+
+  if (n_threads > n_jobs) {
+    n_threads = n_jobs;
+  }
+
+  if (n_threads > 1) {
+#if __SGX__
+    // The untrusted side re-enters the enclave from n_threads - 1
+    // threads (one TCS each) and returns once they are done. Whatever
+    // is left, e.g. if the TCSs ran out, is done by the caller below.
+    sgxwasm_spawn_workers(n_threads - 1);
+#else
+    pthread_t* threads = malloc(sizeof(pthread_t) * (n_threads - 1));
+    size_t i, n_started = 0;
+    if (threads) {
+      for (i = 0; i < n_threads - 1; i++) {
+        if (pthread_create(&threads[i], NULL, worker_main, NULL)) {
+          break;
+        }
+        n_started++;
+      }
+    }
+    sgxwasm_parallel_worker();
+    for (i = 0; i < n_started; i++) {
+      pthread_join(threads[i], NULL);
+    }
+    free(threads);
+#endif
+  }
+
+  // Serial path, and the leftovers of the parallel one.
+  sgxwasm_parallel_worker();
+
+  return !state.failed;
+}
@@ -0,0 +1,22 @@
+#ifndef __SGXWASM__PARALLEL_H__
+#define __SGXWASM__PARALLEL_H__
+
+#include <sgxwasm/config.h>
+#include <sgxwasm/sys.h>
+
+// Job callback: returns 0 on failure.
+typedef int((*parallel_job_t)(void*, size_t));
+
+// Run job(arg, i) for every i in [0, n_jobs) on up to n_threads threads.
+// Jobs are handed out in order from a shared counter, so callers must
+// not depend on which thread runs which job.
+int
+sgxwasm_parallel_for(size_t n_threads, size_t n_jobs, parallel_job_t job,
+                     void* arg);
+
+// Entry point of a worker thread (called from enclave_parallel_worker
+// for SGX).
+void
+sgxwasm_parallel_worker(void);
+
+#endif
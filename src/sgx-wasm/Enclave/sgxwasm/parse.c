@@ -215,7 +215,7 @@ read_buf_internal(struct ParseState* pstate, uint32_t* buf_size, int zero_term)
   }
 
   toret = malloc(string_size + as_string);
-#if SGXWASM_LOADTIME_MEMORY
+#if SGXWASM_LOADTIME_MEMORY || SGXWASM_LOADTIME_PROFILE
   sgxwasm_increase_alloc_counter(string_size + as_string);
 #endif
   if (!toret)
@@ -266,7 +266,7 @@ read_type_section(struct ParseState* pstate, struct TypeSection* type_section)
 
   type_section->types =
     calloc(type_section->n_types, sizeof(struct TypeSectionType));
-#if SGXWASM_LOADTIME_MEMORY
+#if SGXWASM_LOADTIME_MEMORY || SGXWASM_LOADTIME_PROFILE
         sgxwasm_increase_alloc_counter(type_section->n_types * sizeof(struct TypeSectionType));
 #endif
   if (!type_section->types)
@@ -411,7 +411,7 @@ read_import_section(struct ParseState* pstate,
 
   import_section->imports =
     calloc(import_section->n_imports, sizeof(struct ImportSectionImport));
-#if SGXWASM_LOADTIME_MEMORY
+#if SGXWASM_LOADTIME_MEMORY || SGXWASM_LOADTIME_PROFILE
   sgxwasm_increase_alloc_counter(import_section->n_imports * sizeof(struct ImportSectionImport));
 #endif
 
@@ -490,7 +490,7 @@ read_function_section(struct ParseState* pstate,
 
     function_section->typeidxs =
       calloc(function_section->n_typeidxs, sizeof(uint32_t));
-#if SGXWASM_LOADTIME_MEMORY
+#if SGXWASM_LOADTIME_MEMORY || SGXWASM_LOADTIME_PROFILE
     sgxwasm_increase_alloc_counter(function_section->n_typeidxs * sizeof(uint32_t));
 #endif
     if (!function_section->typeidxs)
@@ -524,7 +524,7 @@ read_table_section(struct ParseState* pstate,
 
     table_section->tables =
       calloc(table_section->n_tables, sizeof(struct TableSectionTable));
-#if SGXWASM_LOADTIME_MEMORY
+#if SGXWASM_LOADTIME_MEMORY || SGXWASM_LOADTIME_PROFILE
     sgxwasm_increase_alloc_counter(table_section->n_tables * sizeof(struct TableSectionTable));
 #endif
     if (!table_section->tables)
@@ -568,7 +568,7 @@ read_memory_section(struct ParseState* pstate,
 
     memory_section->memories =
       calloc(memory_section->n_memories, sizeof(struct MemorySectionMemory));
-#if SGXWASM_LOADTIME_MEMORY
+#if SGXWASM_LOADTIME_MEMORY || SGXWASM_LOADTIME_PROFILE
     sgxwasm_increase_alloc_counter(memory_section->n_memories * sizeof(struct MemorySectionMemory));
 #endif
     if (!memory_section->memories) {
@@ -590,8 +590,18 @@ error:
   return 0;
 }
 
+// Label indices of the br_table of a function body.
+struct LabelVector
+{
+  size_t capacity;
+  size_t size;
+  uint32_t* data;
+};
+
 int
-read_instruction(struct ParseState* pstate, struct Instr* instr)
+read_instruction(struct ParseState* pstate,
+                 struct Instr* instr,
+                 struct LabelVector* labels)
 {
   int ret;
   struct BlockLoopExtra* block;
@@ -638,19 +648,14 @@ read_instruction(struct ParseState* pstate, struct Instr* instr)
       if (!ret)
         goto error;
 
-      if (instr->data.br_table.n_labelidxs) {
+      // labelidxs is set once all labels of the function are read.
+      {
         uint32_t i;
 
-        instr->data.br_table.labelidxs =
-          calloc(instr->data.br_table.n_labelidxs, sizeof(int));
-#if SGXWASM_LOADTIME_MEMORY
-        sgxwasm_increase_alloc_counter(instr->data.br_table.n_labelidxs * sizeof(int));
-#endif
-        if (!instr->data.br_table.labelidxs)
-          goto error;
-
         for (i = 0; i < instr->data.br_table.n_labelidxs; ++i) {
-          ret = read_uleb_uint32_t(pstate, &instr->data.br_table.labelidxs[i]);
+          if (!VECTOR_GROW(labels))
+            goto error;
+          ret = read_uleb_uint32_t(pstate, &labels->data[labels->size - 1]);
           if (!ret)
             goto error;
         }
@@ -1057,7 +1062,7 @@ read_init_expr(struct ParseState* pstate,
       goto error;
     }
     next_instructions = realloc(*instructions, size);
-#if SGXWASM_LOADTIME_MEMORY
+#if SGXWASM_LOADTIME_MEMORY || SGXWASM_LOADTIME_PROFILE
     sgxwasm_increase_alloc_counter(sizeof(struct Instr));
 #endif
     if (!next_instructions) {
@@ -1074,231 +1079,127 @@ read_init_expr(struct ParseState* pstate,
     ret = 0;
   }
 
-  free_instruction(&instruction);
   return ret;
 }
 
+// Reads a function body into one array, see struct Instr.
 int
 read_instructions(struct ParseState* pstate,
                   struct Instr** root_instructions,
                   size_t* root_n_instructions,
-                  size_t code_size,
-                  uint64_t start_offset)
+                  uint32_t** root_labels)
 {
-  struct Instr instruction;
+  DEFINE_ANON_VECTOR(struct Instr) instructions;
+  DEFINE_ANON_VECTOR(uint32_t) blocks; // Indices of the open blocks.
+  struct LabelVector labels;
+  struct Instr* instr;
+  struct Instr* block;
+  uint32_t idx;
+  size_t i, n_labels;
   int ret;
-  size_t n_ctxts;
-  struct StackElt
-  {
-    struct Instr** instructions;
-    size_t* n_instructions;
-    int allow_else;
-  } * stack, *new_stack;
-
-  init_instruction(&instruction);
-
-  n_ctxts = 1;
-  stack = malloc(sizeof(stack[0]));
-#if SGXWASM_LOADTIME_MEMORY
-  sgxwasm_increase_alloc_counter(sizeof(stack[0]));
-#endif
-  if (!stack)
-    goto error;
 
   assert(!*root_instructions);
   assert(!*root_n_instructions);
 
-  stack[0].instructions = root_instructions;
-  stack[0].n_instructions = root_n_instructions;
-  stack[0].allow_else = 0;
-
-  while (n_ctxts) {
-    struct Instr** instructions;
-    size_t* n_instructions;
-    int allow_else;
-
-    /* get item at top of stack */
-    instructions = stack[n_ctxts - 1].instructions;
-    n_instructions = stack[n_ctxts - 1].n_instructions;
-    allow_else = stack[n_ctxts - 1].allow_else;
+  // SGXWASM_LOADTIME_MEMORY counts every element of these when
+  // sgxwasm_vector_grow adds it, so the count for a body is what it keeps
+  // after the trim below (plus the open-block stack), as the old
+  // per-instruction counting did.
+  VECTOR_INIT(&instructions);
+  VECTOR_INIT(&blocks);
+  VECTOR_INIT(&labels);
 
-    /* shrink stack */
-    n_ctxts -= 1;
-    new_stack = realloc(stack, n_ctxts * sizeof(stack[0]));
-    if (!new_stack && n_ctxts)
+  while (1) {
+    if (!VECTOR_GROW(&instructions))
       goto error;
-    stack = new_stack;
+    idx = instructions.size - 1;
+    instr = &instructions.data[idx];
+    init_instruction(instr);
 
-    while (1) {
-      struct Instr* next_instructions;
-      size_t new_len;
-      size_t size;
+    ret = read_instruction(pstate, instr, &labels);
+    if (!ret)
+      goto error;
 
-      ret = read_instruction(pstate, &instruction);
-#if DEBUG_PARSE
-      dump_instruction(&instruction, 0);
-#endif
-      if (!ret)
+    if (instr->opcode == OPCODE_BLOCK || instr->opcode == OPCODE_LOOP ||
+        instr->opcode == OPCODE_IF) {
+      if (!VECTOR_GROW(&blocks))
         goto error;
+      blocks.data[blocks.size - 1] = idx;
+      continue;
+    }
 
-      if (instruction.opcode == OPCODE_END) {
-        uint64_t current_size = (uint64_t)pstate->input - start_offset;
-        // XXX: Deprecated.
-        // End of function body, do not insert the last END.
-        if ((size_t)current_size == code_size) {
-          // break;
-        }
-
-        // Insert END at the end of a control block.
-        new_len = *n_instructions + 1;
-        if (__builtin_umull_overflow(new_len, sizeof(struct Instr), &size)) {
-          goto error;
-        }
-        next_instructions = realloc(*instructions, size);
-#if SGXWASM_LOADTIME_MEMORY
-        sgxwasm_increase_alloc_counter(sizeof(struct Instr));
-#endif
-        if (!next_instructions) {
-          goto error;
-        }
-        next_instructions[new_len - 1] = instruction;
-        init_instruction(&instruction);
-
-        *instructions = next_instructions;
-        *n_instructions = new_len;
-        break;
-      }
-
-      if (instruction.opcode == OPCODE_ELSE) {
-        if (!allow_else)
-          goto error;
-
-        // Work-around: Insert ELSE at the end of a IF block.
-        new_len = *n_instructions + 1;
-        if (__builtin_umull_overflow(new_len, sizeof(struct Instr), &size)) {
-          goto error;
-        }
-        next_instructions = realloc(*instructions, size);
-#if SGXWASM_LOADTIME_MEMORY
-        sgxwasm_increase_alloc_counter(sizeof(struct Instr));
-#endif
-        if (!next_instructions) {
-          goto error;
-        }
-        next_instructions[new_len - 1] = instruction;
-        init_instruction(&instruction);
-
-        *instructions = next_instructions;
-        *n_instructions = new_len;
-
-        /* start reading else clause,
-           push the else clause onto the stack
-         */
-#if 0
-        /* increase stack size */
-        n_ctxts += 1;
-        new_stack = realloc(stack, n_ctxts * sizeof(stack[0]));
-        if (!new_stack)
-          goto error;
-        stack = new_stack;
-        {
-          /* we get the else clause from our parent, we should
-             be the previous element on the stack */
-          struct StackElt* last_stack_elt = &stack[n_ctxts - 2];
-          struct Instr* last_instr = &(
-            *last_stack_elt->instructions)[*last_stack_elt->n_instructions - 1];
-          struct IfExtra* extra = &last_instr->data.if_;
-          assert(last_instr->opcode == OPCODE_IF);
-
-          assert(!extra->instructions_else);
-          assert(!extra->n_instructions_else);
-
-          /* push parent onto stack first, so we can pick up
-             where we left off */
-          stack[n_ctxts - 1].instructions = &extra->instructions_else;
-          stack[n_ctxts - 1].n_instructions = &extra->n_instructions_else;
-          stack[n_ctxts - 1].allow_else = 0;
-        }
-        break;
-#endif
-      }
-
-      new_len = *n_instructions + 1;
-
-      if (__builtin_umull_overflow(new_len, sizeof(struct Instr), &size)) {
+    if (instr->opcode == OPCODE_ELSE) {
+      if (!blocks.size)
         goto error;
-      }
-      next_instructions = realloc(*instructions, size);
-#if SGXWASM_LOADTIME_MEMORY
-      sgxwasm_increase_alloc_counter(sizeof(struct Instr));
-#endif
-      if (!next_instructions) {
+      block = &instructions.data[blocks.data[blocks.size - 1]];
+      if (block->opcode != OPCODE_IF || block->data.if_.else_)
         goto error;
-      }
-      next_instructions[new_len - 1] = instruction;
-      init_instruction(&instruction);
-
-      *instructions = next_instructions;
-      *n_instructions = new_len;
-
-      if (next_instructions[new_len - 1].opcode == OPCODE_BLOCK ||
-          next_instructions[new_len - 1].opcode == OPCODE_LOOP ||
-          next_instructions[new_len - 1].opcode == OPCODE_IF) {
-        /* we read the beginning of a block,
-           we have to recurse */
-        n_ctxts += 2;
-        new_stack = realloc(stack, n_ctxts * sizeof(stack[0]));
-#if SGXWASM_LOADTIME_MEMORY
-        sgxwasm_increase_alloc_counter(2 * sizeof(stack[0]));
-#endif
-        if (!new_stack)
-          goto error;
-        stack = new_stack;
-
-        /* push parent onto stack first, so we can pick up
-           where we left off */
-        stack[n_ctxts - 2].instructions = instructions;
-        stack[n_ctxts - 2].n_instructions = n_instructions;
-        stack[n_ctxts - 2].allow_else = allow_else;
-      }
-
-      if (next_instructions[new_len - 1].opcode == OPCODE_BLOCK ||
-          next_instructions[new_len - 1].opcode == OPCODE_LOOP) {
-        struct BlockLoopExtra* block;
+      block->data.if_.else_ = idx;
+      continue;
+    }
 
-        // FIXME: Use next_instructions[new_len - 1] instead.
-        block = instruction.opcode == OPCODE_BLOCK
-                  ? &next_instructions[new_len - 1].data.block
-                  : &next_instructions[new_len - 1].data.loop;
+    if (instr->opcode != OPCODE_END)
+      continue;
 
-        stack[n_ctxts - 1].instructions = &block->instructions;
-        stack[n_ctxts - 1].n_instructions = &block->n_instructions;
-        stack[n_ctxts - 1].allow_else = 0;
+    // The last END closes the function body.
+    if (!blocks.size)
+      break;
 
+    block = &instructions.data[blocks.data[blocks.size - 1]];
+    blocks.size--;
+    switch (block->opcode) {
+      case OPCODE_BLOCK:
+        block->data.block.end = idx;
         break;
-      } else if (next_instructions[new_len - 1].opcode == OPCODE_IF) {
-        struct IfExtra* extra = &next_instructions[new_len - 1].data.if_;
-
-        stack[n_ctxts - 1].instructions = &extra->instructions_then;
-        stack[n_ctxts - 1].n_instructions = &extra->n_instructions_then;
-        stack[n_ctxts - 1].allow_else = 1;
+      case OPCODE_LOOP:
+        block->data.loop.end = idx;
         break;
-      }
+      case OPCODE_IF:
+        if (!block->data.if_.else_)
+          block->data.if_.else_ = idx;
+        block->data.if_.end = idx;
+        break;
+      default:
+        assert(0);
     }
   }
 
-  assert(ret);
-  if (0) {
-  error:
-    ret = 0;
+  // Give back the spare capacity, then point br_table at their labels.
+  instr = realloc(instructions.data, instructions.size * sizeof(struct Instr));
+  if (instr)
+    instructions.data = instr;
+  if (labels.size) {
+    uint32_t* data = realloc(labels.data, labels.size * sizeof(uint32_t));
+    if (data)
+      labels.data = data;
   }
 
-  if (stack)
-    free(stack);
+  n_labels = 0;
+  for (i = 0; i < instructions.size; ++i) {
+    instr = &instructions.data[i];
+    if (instr->opcode != OPCODE_BR_TABLE)
+      continue;
+    instr->data.br_table.labelidxs = &labels.data[n_labels];
+    n_labels += instr->data.br_table.n_labelidxs;
+  }
+  assert(n_labels == labels.size);
+#if DEBUG_PARSE
+  for (i = 0; i < instructions.size; ++i) {
+    dump_instruction(&instructions.data[i], 0);
+  }
+#endif
 
-  free_instruction(&instruction);
+  *root_instructions = instructions.data;
+  *root_n_instructions = instructions.size;
+  *root_labels = labels.data;
+  free(blocks.data);
+  return 1;
 
-  return ret;
+error:
+  free(instructions.data);
+  free(labels.data);
+  free(blocks.data);
+  return 0;
 }
 
 int
@@ -1317,7 +1218,7 @@ read_global_section(struct ParseState* pstate,
 
     global_section->globals =
       calloc(global_section->n_globals, sizeof(struct GlobalSectionGlobal));
-#if SGXWASM_LOADTIME_MEMORY
+#if SGXWASM_LOADTIME_MEMORY || SGXWASM_LOADTIME_PROFILE
     sgxwasm_increase_alloc_counter(global_section->n_globals * sizeof(struct GlobalSectionGlobal));
 #endif
     if (!global_section->globals)
@@ -1360,7 +1261,7 @@ read_export_section(struct ParseState* pstate,
 
     export_section->exports =
       calloc(export_section->n_exports, sizeof(struct ExportSectionExport));
-#if SGXWASM_LOADTIME_MEMORY
+#if SGXWASM_LOADTIME_MEMORY || SGXWASM_LOADTIME_PROFILE
     sgxwasm_increase_alloc_counter(export_section->n_exports * sizeof(struct ExportSectionExport));
 #endif
     if (!export_section->exports)
@@ -1412,7 +1313,7 @@ read_element_section(struct ParseState* pstate,
 
     element_section->elements =
       calloc(element_section->n_elements, sizeof(struct ElementSectionElement));
-#if SGXWASM_LOADTIME_MEMORY
+#if SGXWASM_LOADTIME_MEMORY || SGXWASM_LOADTIME_PROFILE
     sgxwasm_increase_alloc_counter(element_section->n_elements * sizeof(struct ElementSectionElement));
 #endif
     if (!element_section->elements)
@@ -1438,7 +1339,7 @@ read_element_section(struct ParseState* pstate,
         uint32_t j;
 
         element->funcidxs = calloc(element->n_funcidxs, sizeof(uint32_t));
-#if SGXWASM_LOADTIME_MEMORY
+#if SGXWASM_LOADTIME_MEMORY || SGXWASM_LOADTIME_PROFILE
         sgxwasm_increase_alloc_counter(element->n_funcidxs * sizeof(uint32_t));
 #endif
         if (!element->funcidxs)
@@ -1473,7 +1374,7 @@ read_code_section(struct ParseState* pstate, struct CodeSection* code_section)
 
     code_section->codes =
       calloc(code_section->n_codes, sizeof(struct CodeSectionCode));
-#if SGXWASM_LOADTIME_MEMORY
+#if SGXWASM_LOADTIME_MEMORY || SGXWASM_LOADTIME_PROFILE
         sgxwasm_increase_alloc_counter(code_section->n_codes * sizeof(struct CodeSectionCode));
 #endif
     if (!code_section->codes)
@@ -1497,7 +1398,7 @@ read_code_section(struct ParseState* pstate, struct CodeSection* code_section)
 
         code->locals =
           calloc(code->n_locals, sizeof(struct CodeSectionCodeLocal));
-#if SGXWASM_LOADTIME_MEMORY
+#if SGXWASM_LOADTIME_MEMORY || SGXWASM_LOADTIME_PROFILE
         sgxwasm_increase_alloc_counter(code->n_locals * sizeof(struct CodeSectionCodeLocal));
 #endif
         if (!code->locals)
@@ -1516,10 +1417,11 @@ read_code_section(struct ParseState* pstate, struct CodeSection* code_section)
         }
       }
       ret = read_instructions(
-        pstate, &code->instructions, &code->n_instructions, code->size, start);
+        pstate, &code->instructions, &code->n_instructions, &code->labels);
       if (!ret)
         goto error;
       assert(code->size == (size_t)((uint64_t)pstate->input - start));
+      code->hash = hash_bytes((const void*)start, code->size);
     }
   }
 
@@ -1543,7 +1445,7 @@ read_data_section(struct ParseState* pstate, struct DataSection* data_section)
 
     data_section->datas =
       calloc(data_section->n_datas, sizeof(struct DataSectionData));
-#if SGXWASM_LOADTIME_MEMORY
+#if SGXWASM_LOADTIME_MEMORY || SGXWASM_LOADTIME_PROFILE
         sgxwasm_increase_alloc_counter(data_section->n_datas * sizeof(struct DataSectionData));
 #endif
     if (!data_section->datas)
@@ -1572,6 +1474,71 @@ error:
   return 0;
 }
 
+// Makes every reference to a function type name the first identical
+// type, so that signatures can be compared by index. Types are calloc'ed
+// by read_type_section, so identical types have identical bytes.
+static int
+intern_types(struct WASMModule* module)
+{
+  struct TypeSection* types = &module->type_section;
+  uint32_t *canon, *slots;
+  uint32_t i, j, k;
+  size_t n_slots;
+  int ret = 0;
+
+  if (types->n_types < 2)
+    return 1;
+
+  n_slots = 1;
+  while (n_slots < 2 * (size_t)types->n_types)
+    n_slots <<= 1;
+  canon = calloc(types->n_types, sizeof(uint32_t));
+  slots = calloc(n_slots, sizeof(uint32_t)); // Type index + 1, 0 if free.
+  if (!canon || !slots)
+    goto error;
+
+  for (i = 0; i < types->n_types; ++i) {
+    const struct FuncType* type = &types->types[i];
+    size_t slot = hash_bytes(type, sizeof(*type)) & (n_slots - 1);
+    while (slots[slot] &&
+           memcmp(&types->types[slots[slot] - 1], type, sizeof(*type))) {
+      slot = (slot + 1) & (n_slots - 1);
+    }
+    if (!slots[slot])
+      slots[slot] = i + 1;
+    canon[i] = slots[slot] - 1;
+  }
+
+#define INTERN(idx)                                                            \
+  do {                                                                         \
+    if ((idx) < types->n_types)                                                \
+      (idx) = canon[(idx)];                                                    \
+  } while (0)
+
+  for (i = 0; i < module->import_section.n_imports; ++i) {
+    struct ImportSectionImport* import = &module->import_section.imports[i];
+    if (import->desc_type == IMPORT_DESC_TYPE_FUNC)
+      INTERN(import->desc.functypeidx);
+  }
+  for (i = 0; i < module->function_section.n_typeidxs; ++i) {
+    INTERN(module->function_section.typeidxs[i]);
+  }
+  for (j = 0; j < module->code_section.n_codes; ++j) {
+    struct CodeSectionCode* code = &module->code_section.codes[j];
+    for (k = 0; k < code->n_instructions; ++k) {
+      if (code->instructions[k].opcode == OPCODE_CALL_INDIRECT)
+        INTERN(code->instructions[k].data.call_indirect.typeidx);
+    }
+  }
+#undef INTERN
+
+  ret = 1;
+error:
+  free(canon);
+  free(slots);
+  return ret;
+}
+
 int
 read_wasm_module(struct ParseState* pstate,
                  struct WASMModule* module,
@@ -1700,5 +1667,12 @@ read_wasm_module(struct ParseState* pstate,
         return 0;
     }
   }
+
+  if (!intern_types(module)) {
+    if (why) {
+      snprintf(why, why_size, "Error interning types");
+    }
+    return 0;
+  }
   return 1;
 }
@@ -85,7 +85,8 @@ pass_is_enabled(struct PassManager*, char*);
   V(pm, caslr)                                                                 \
   V(pm, varys)                                                                 \
   V(pm, tsgx)                                                                  \
-  V(pm, aslr)
+  V(pm, aslr)                                                                  \
+  V(pm, profile)
 
 #define DECLAR_ADD_PASS(_pm, _name) void add_pass_##_name(struct PassManager*);
 
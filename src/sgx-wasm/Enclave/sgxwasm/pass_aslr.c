@@ -64,7 +64,8 @@ static DEFINE_VECTOR_GROW(cfg, struct ControlFlowGraph);
 static DEFINE_VECTOR_INIT(cfg_target_list, struct CFGTargetList);
 static DEFINE_VECTOR_GROW(cfg_target_list, struct CFGTargetList);
 
-struct ControlFlowGraph cfg = { 0, 0, NULL };
+// Per-thread state, see parallel.h.
+static SGXWASM_TLS struct ControlFlowGraph cfg = { 0, 0, NULL };
 
 struct CFGTarget*
 new_target(struct CFGNode* node)
@@ -106,23 +107,21 @@ insert_jump(struct CompilerContext* ctx,
   assert(ctx->memrefs != NULL);
   struct MemoryReferences* memrefs = ctx->memrefs;
   struct MemoryRef* memref;
-  size_t offset = pc_offset(output(ctx));
+  const struct MachineInstr* jump = last_jump(ctx);
+  size_t offset;
 
   // If the last instruction is already jmp, skip.
-  if ((uint8_t)output(ctx)->data[offset - 5] == 0xe9) {
-#if __DEBUG_ASLR__
-    plog("[insert_jump] skip id: %zu, ends with 32-bit jmp\n", node->id);
-#endif
-    return 0;
-  } else if ((uint8_t)output(ctx)->data[offset - 2] == 0xeb) {
+  if (jump != NULL && (jump->jump == JumpNear || jump->jump == JumpShort)) {
 #if __DEBUG_ASLR__
-    plog("[insert_jump] skip id: %zu, ends with 8-bit jmp\n", node->id);
+    plog("[insert_jump] skip id: %zu, ends with %s jmp\n",
+         node->id,
+         jump->jump == JumpNear ? "32-bit" : "8-bit");
 #endif
     return 0;
   }
 
   // Insert jump.
-  emit_jmp_32(output(ctx), 0);
+  emit_pass_jump(ctx, COND_NONE);
   offset = pc_offset(output(ctx));
 
   memref = new_memref(memrefs);
@@ -155,7 +154,7 @@ update_branch(struct CompilerContext* ctx,
   assert(ctx->memrefs != NULL);
   struct MemoryReferences* memrefs = ctx->memrefs;
   struct MemoryRef* memref = new_memref(memrefs);
-  size_t offset = pc_offset(output(ctx));
+  uint8_t jump;
 
   if (target->type == BrUnknown) {
     int i = cfg->size - 1;
@@ -211,31 +210,11 @@ update_branch(struct CompilerContext* ctx,
     }
   }
 
-  // Case of unconditional 32-bit jump.
-  if ((uint8_t)output(ctx)->data[offset - 5] == 0xe9) {
-    memref->type = type;
-    memref->code_offset = offset - 4;
-    memref->unit_idx = node->id;
-    memref->idx = target->id;
-    memref->target_type = target->type;
-    // Target depth is relative depth, need covertion here.
-    memref->depth = node->depth - target->depth;
-#if __DEBUG_ASLR__
-    plog("[update_branch] 32-bit jmp id: %zu -> %zu (%zu), depth: %zu\n",
-         memref->unit_idx,
-         memref->idx,
-         memref->target_type - 0xe0,
-         memref->depth);
-#endif
-  } else if ((uint8_t)output(ctx)->data[offset - 2] == 0xeb) {
-    // Convert 8-bit jmp to 32-bit.
-    // 0xeb 0x00 -> 0xe9 0x00 0x00 0x00 0x00
-    output(ctx)->data[offset - 2] = 0xe9;
-    emit(output(ctx), 0x00);
-    emit(output(ctx), 0x00);
-    emit(output(ctx), 0x00);
-
-    // Case of unconditional 8-bit jump
+  // Short jumps are widened to 32-bit ones.
+  jump = widen_last_jump(ctx);
+
+  // Case of unconditional jump.
+  if (jump == JumpNear) {
     memref->type = type;
     memref->code_offset = pc_offset(output(ctx)) - 4;
     memref->unit_idx = node->id;
@@ -244,17 +223,16 @@ update_branch(struct CompilerContext* ctx,
     // Target depth is relative depth, need covertion here.
     memref->depth = node->depth - target->depth;
 #if __DEBUG_ASLR__
-    plog("[update_branch] 8-bit jmp id: %zu -> %zu (%zu), depth: %zu\n",
+    plog("[update_branch] jmp id: %zu -> %zu (%zu), depth: %zu\n",
          memref->unit_idx,
          memref->idx,
          memref->target_type - 0xe0,
          memref->depth);
 #endif
-  } else if ((uint8_t)output(ctx)->data[offset - 5] >= 0x80 &&
-             (uint8_t)output(ctx)->data[offset - 5] <= 0x8f) {
-    // Case of 32-bit jcc
+  } else if (jump == JccNear) {
+    // Case of jcc
     memref->type = type;
-    memref->code_offset = offset - 4;
+    memref->code_offset = pc_offset(output(ctx)) - 4;
     memref->unit_idx = node->id;
     memref->idx = target->id;
     memref->target_type = target->type;
@@ -553,7 +531,7 @@ onInstructionEnd(struct CompilerContext* ctx,
 __attribute__((unused)) static void
 onMachineInstrEnd(struct CompilerContext* ctx,
                   const struct Function* func,
-                  const struct MachineInstr* instr)
+                  const struct MachineInstr* minstr)
 {
   (void)func;
   const struct Instr* instr = minstr->instr;
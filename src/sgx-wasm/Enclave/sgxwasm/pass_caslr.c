@@ -1,5 +1,6 @@
 #include <sgxwasm/pass.h>
 #include <sgxwasm/pass_cfg.h>
+#include <sgxwasm/profile.h>
 
 #if __CASLR__
 static const char* pass_name = "caslr";
@@ -10,14 +11,18 @@ static const char* pass_name = "caslr";
 #define JMP_SIZE 5
 
 // Global variables.
-static struct ControlFlowGraph* cfg;
-static struct FunctionCFG* fun_cfg;
+// Per-thread state, see parallel.h.
+static struct Pass* cfg_pass;
+static SGXWASM_TLS struct ControlFlowGraph* cfg;
+static SGXWASM_TLS struct FunctionCFG* fun_cfg;
 
 // Use to track the number of br_tables.
-static int br_table_num;
+static SGXWASM_TLS int br_table_num;
+// Memory references added since the current br_table started.
+static SGXWASM_TLS size_t br_table_memref;
 
 // Use to track last inserted/updated branch.
-static uint8_t last_branch;
+static SGXWASM_TLS uint8_t last_branch;
 
 #if FIX_SIZE_ASLR // For fix-sized code units
 #define CODE_UNIT_SIZE 64
@@ -30,40 +35,26 @@ struct FixSizeCodeUnit
   {
     size_t offset;
     size_t size;
+    // Memory references added from here on.
+    size_t memref;
   } * data;
 };
 static DEFINE_VECTOR_GROW(fix_size_unit, struct FixSizeCodeUnit);
 static DEFINE_VECTOR_INIT(fix_size_unit, struct FixSizeCodeUnit);
 static DEFINE_VECTOR_RESIZE(fix_size_unit, struct FixSizeCodeUnit);
 
-struct FixSizeCodeUnit fix_size_unit;
-
-#if 1 // For debug.
-/*#define ListSize 27
-static size_t whitelist[ListSize] = { 21, 24, 27, 29, 32, 33, 36, 38, 41,
-                                      42, 43, 52, 53, 54, 55, 56, 59, 61,
-                                      63, 64, 65, 66, 76, 77, 80, 81, 82 };*/
-
-#define ListSize 3
-static size_t whitelist[ListSize] = { 681, 796, 839 };
-static size_t skip_number = 43;
-static size_t skip_counter = 0;
+static SGXWASM_TLS struct FixSizeCodeUnit fix_size_unit;
 
+// Per-function policy from the hardening profile (profile.h).
 static int
-is_in_whitelist(size_t id)
+is_in_whitelist(const struct Function* func)
 {
-  int i;
-  for (i = 0; i < ListSize; i++) {
-    if (id == whitelist[i]) {
-      return 1;
-    }
-  }
-  return 0;
+  return has_hardening(func, HARDEN_UNIT);
 }
-#endif
 
 static void
-add_instr(struct FixSizeCodeUnit* code_unit, size_t offset, size_t size)
+add_instr(struct FixSizeCodeUnit* code_unit, size_t offset, size_t size,
+          size_t memref)
 {
   assert(code_unit != NULL);
   if (!fix_size_unit_grow(code_unit)) {
@@ -72,6 +63,7 @@ add_instr(struct FixSizeCodeUnit* code_unit, size_t offset, size_t size)
   struct UnitInstr* instr = &code_unit->data[code_unit->size - 1];
   instr->offset = offset;
   instr->size = size;
+  instr->memref = memref;
 }
 
 static void
@@ -90,7 +82,8 @@ insert_jump(struct CompilerContext* ctx, struct CFGNode* node,
   assert(ctx->memrefs != NULL);
   struct MemoryReferences* memrefs = ctx->memrefs;
   struct MemoryRef* memref;
-  size_t offset = pc_offset(output(ctx));
+  const struct MachineInstr* jump = last_jump(ctx);
+  size_t offset;
 
   // If the last instruction is already jmp, skip.
   // Special base - the block ends with br_if
@@ -99,16 +92,11 @@ insert_jump(struct CompilerContext* ctx, struct CFGNode* node,
   //   br_if
   //   ...   <---- jump to here if condition is false.
   // In the case, we need to insert additional jump.
-  if ((uint8_t)output(ctx)->data[offset - 5] == 0xe9 &&
+  if (jump != NULL && (jump->jump == JumpNear || jump->jump == JumpShort) &&
       last_branch != OPCODE_BR_IF) {
 #if __DEBUG_CASLR__
-    plog("[insert_jump] skip id: %zu, ends with 32-bit jmp\n", node->id);
-#endif
-    return 0;
-  } else if ((uint8_t)output(ctx)->data[offset - 2] == 0xeb &&
-             last_branch != OPCODE_BR_IF) {
-#if __DEBUG_CASLR__
-    plog("[insert_jump] skip id: %zu, ends with 8-bit jmp\n", node->id);
+    plog("[insert_jump] skip id: %zu, ends with %s jmp\n", node->id,
+         jump->jump == JumpNear ? "32-bit" : "8-bit");
 #endif
     return 0;
   }
@@ -116,7 +104,7 @@ insert_jump(struct CompilerContext* ctx, struct CFGNode* node,
   assert(target != NULL);
 
   // Insert jump.
-  emit_jmp_32(output(ctx), 0);
+  emit_pass_jump(ctx, COND_NONE);
   offset = pc_offset(output(ctx));
 
   memref = new_memref(memrefs);
@@ -138,38 +126,6 @@ insert_jump(struct CompilerContext* ctx, struct CFGNode* node,
 }
 
 #if FIX_SIZE_ASLR
-__attribute__((unused)) static void
-update_memref(struct CompilerContext* ctx, size_t start_offset,
-              size_t end_offset)
-{
-  assert(ctx->memrefs != NULL);
-  struct MemoryReferences* memrefs = ctx->memrefs;
-  struct MemoryRef* memref;
-  size_t offset;
-  size_t extra_bytes = JMP_SIZE;
-  size_t i;
-
-  if ((uint8_t)output(ctx)->data[start_offset - 5] == 0xe9) {
-    extra_bytes = 0;
-  }
-
-  for (i = 0; i < memrefs->size; i++) {
-    memref = &memrefs->data[i];
-    offset = memref->code_offset;
-    if (offset >= start_offset && offset < end_offset) {
-#if __DEBUG_CALSR_SPLIT_
-      printf("[update_memref] %zu -> %zu (%u), offset %lx", memref->unit_idx,
-             memref->idx, memref->type, offset);
-#endif
-      memref->code_offset += extra_bytes;
-#if __DEBUG_CALSR_SPLIT_
-      printf(" -> %lx (%lx - %lx)\n", memref->code_offset, start_offset,
-             end_offset);
-#endif
-    }
-  }
-}
-
 // Split unit design
 // Before split:
 // unit n (target: m)
@@ -193,20 +149,21 @@ split_unit(struct CompilerContext* ctx, struct FixSizeCodeUnit* code_unit)
   struct CFGTarget* next_target;
   size_t offset = pc_offset(output(ctx));
   size_t split_offset = offset;
-  uint8_t* buf = NULL;
-  size_t buf_size = 0;
+  size_t split_memref = ctx->memrefs->size;
+  struct CodeTail tail;
   int i;
 
 #if 1 // For debug.
   const struct Function* func = ctx->func;
 
-  if (is_in_whitelist(func->fun_index) != 1) {
+  if (!is_in_whitelist(func)) {
     // Reset the fix_size_unit.
 #if __DEBUG_CASLR__
     plog("[split_unit] skip fun #%zu\n", func->fun_index);
 #endif
     reset_unit(code_unit);
-    add_instr(code_unit, pc_offset(output(ctx)), 0); // Head node.
+    add_instr(code_unit, pc_offset(output(ctx)), 0,
+              ctx->memrefs->size); // Head node.
     return;
   }
 
@@ -264,6 +221,7 @@ if (node->id >= skip_number) {
   for (i = code_unit->size - 1; i >= 0; i--) {
     struct UnitInstr* instr = &code_unit->data[i];
     split_offset = instr->offset;
+    split_memref = instr->memref;
 #if __DEBUG_CALSR_SPLIT__
     plog("Search for split point - size: %zu, offset %lx\n", instr->size,
          instr->offset);
@@ -274,22 +232,13 @@ if (node->id >= skip_number) {
   }
 
   // If the split_offset is smaller than the current offset, we need
-  // to put them into the next unit.
-  if (split_offset < offset) {
-    buf_size = offset - split_offset;
+  // to put them into the next unit. The memory references in them
+  // move along by the size of the jmp actually inserted.
 #if __DEBUG_CALSR_SPLIT__
-    plog("split_offset: %lx, offset: %lx, diff: %zu\n", split_offset, offset,
-         buf_size);
-#endif
-    buf = malloc(buf_size);
-    memset(buf, 0, buf_size);
-    memcpy(buf, (uint8_t*)&output(ctx)->data[split_offset], buf_size);
-    // Extra bytes that we move to the next unit may include
-    // memory references. As a result, we need to upade the offset
-    // of these memory references.
-    update_memref(ctx, split_offset, offset);
-    output_buf_shrink(output(ctx), buf_size);
-  }
+  plog("split_offset: %lx, offset: %lx, diff: %zu\n", split_offset, offset,
+       offset - split_offset);
+#endif
+  take_code_tail(ctx, split_offset, split_memref, &tail);
 
   // Insert jmp.
   insert_jump(ctx, node, target, MEMREF_JMP_NEXT);
@@ -300,9 +249,7 @@ if (node->id >= skip_number) {
   node->size = next_node->offset - node->offset;
 
   // Append the bytes we previously removed.
-  for (i = 0; i < (int)buf_size; i++) {
-    emit(output(ctx), buf[i]);
-  }
+  put_code_tail(ctx, &tail);
   offset = pc_offset(output(ctx));
   // Keep the current size.
   next_node->size = offset - next_node->offset;
@@ -310,8 +257,8 @@ if (node->id >= skip_number) {
 
   // Reset the fix_size_unit.
   reset_unit(code_unit);
-  add_instr(code_unit, next_node->offset, 0); // Head node.
-  add_instr(code_unit, offset, next_node->size);
+  add_instr(code_unit, next_node->offset, 0, tail.first_memref); // Head node.
+  add_instr(code_unit, offset, next_node->size, ctx->memrefs->size);
 }
 #endif
 
@@ -322,26 +269,11 @@ update_branch(struct CompilerContext* ctx, struct CFGNode* node,
   assert(ctx->memrefs != NULL);
   struct MemoryReferences* memrefs = ctx->memrefs;
   struct MemoryRef* memref = new_memref(memrefs);
-  size_t offset = pc_offset(output(ctx));
+  // Short jumps are widened to 32-bit ones.
+  uint8_t jump = widen_last_jump(ctx);
 
-  // Case of unconditional 32-bit jump.
-  if ((uint8_t)output(ctx)->data[offset - 5] == 0xe9) {
-    memref->type = MEMREF_JMP_NEXT;
-    memref->code_offset = offset - 4;
-    memref->unit_idx = node->id;
-    memref->idx = target->id;
-    memref->target_type = target->type;
-    // Target depth is relative depth, need covertion here.
-    memref->depth = node->depth - target->depth;
-  } else if ((uint8_t)output(ctx)->data[offset - 2] == 0xeb) {
-    // Convert 8-bit jmp to 32-bit.
-    // 0xeb 0x00 -> 0xe9 0x00 0x00 0x00 0x00
-    output(ctx)->data[offset - 2] = 0xe9;
-    emit(output(ctx), 0x00);
-    emit(output(ctx), 0x00);
-    emit(output(ctx), 0x00);
-
-    // Case of unconditional 8-bit jump
+  // Case of unconditional jump.
+  if (jump == JumpNear) {
     memref->type = MEMREF_JMP_NEXT;
     memref->code_offset = pc_offset(output(ctx)) - 4;
     memref->unit_idx = node->id;
@@ -349,11 +281,10 @@ update_branch(struct CompilerContext* ctx, struct CFGNode* node,
     memref->target_type = target->type;
     // Target depth is relative depth, need covertion here.
     memref->depth = node->depth - target->depth;
-  } else if ((uint8_t)output(ctx)->data[offset - 5] >= 0x80 &&
-             (uint8_t)output(ctx)->data[offset - 5] <= 0x8f) {
-    // Case of 32-bit jcc
+  } else if (jump == JccNear) {
+    // Case of jcc
     memref->type = MEMREF_JMP_NEXT;
-    memref->code_offset = offset - 4;
+    memref->code_offset = pc_offset(output(ctx)) - 4;
     memref->unit_idx = node->id;
     memref->idx = target->id;
     memref->target_type = target->type;
@@ -420,13 +351,15 @@ try_patch_target(struct CompilerContext* ctx, struct CFGNode* node)
 {
   assert(ctx->memrefs != NULL);
   struct MemoryReferences* memrefs = ctx->memrefs;
-  size_t i;
+  size_t i, j;
   uint8_t control_state = node->control_state;
   control_type_t control_type = node->control_type;
 
   (void)control_type;
 
-  for (i = 0; i < memrefs->size; i++) {
+  update_pending_jumps(ctx);
+  for (j = 0; j < ctx->pending_jumps.size; j++) {
+    i = ctx->pending_jumps.data[j];
     uint8_t target_type = memrefs->data[i].target_type;
     if (memrefs->data[i].type != MEMREF_JMP_NEXT) {
       continue;
@@ -494,8 +427,8 @@ onFunctionStart(struct CompilerContext* ctx, const struct Function* func)
 #if FIX_SIZE_ASLR
   fix_size_unit_init(&fix_size_unit);
   // Add the head node.
-  add_instr(&fix_size_unit, 0, 0);
-  add_instr(&fix_size_unit, offset, offset);
+  add_instr(&fix_size_unit, 0, 0, 0);
+  add_instr(&fix_size_unit, offset, offset, ctx->memrefs->size);
 
 // For debug.
 // skip_counter = 0;
@@ -504,6 +437,7 @@ onFunctionStart(struct CompilerContext* ctx, const struct Function* func)
   // Reset the br_table_num;
   br_table_num = 0;
 
+  cfg = get_cfg(cfg_pass);
   fun_cfg = NULL;
   for (i = 0; i < cfg->size; i++) {
     struct FunctionCFG* f = &cfg->data[i];
@@ -559,7 +493,7 @@ onControlStart(struct CompilerContext* ctx, const struct Function* func,
 #if FIX_SIZE_ASLR
   // Reset the unit.
   reset_unit(&fix_size_unit);
-  add_instr(&fix_size_unit, pc_offset(output(ctx)), 0);
+  add_instr(&fix_size_unit, pc_offset(output(ctx)), 0, ctx->memrefs->size);
 
 // For debug.
 // skip_counter++;
@@ -602,7 +536,7 @@ onControlEnd(struct CompilerContext* ctx, const struct Function* func,
 #if FIX_SIZE_ASLR
   // Reset the unit.
   reset_unit(&fix_size_unit);
-  add_instr(&fix_size_unit, pc_offset(output(ctx)), 0);
+  add_instr(&fix_size_unit, pc_offset(output(ctx)), 0, ctx->memrefs->size);
 
 // For debug.
 // skip_counter++;
@@ -617,6 +551,10 @@ onInstructionStart(struct CompilerContext* ctx, const struct Function* func,
   (void)func;
   (void)instr;
 
+  if (instr->opcode == OPCODE_BR_TABLE) {
+    br_table_memref = ctx->memrefs->size;
+  }
+
   uint8_t opcode = instr->opcode;
 #if __DEBUG_CASLR__
   plog("[onInstructionStart] op: %u\n", opcode);
@@ -697,7 +635,7 @@ onInstructionEnd(struct CompilerContext* ctx, const struct Function* func,
     split_unit(ctx, &fix_size_unit);
 #endif
   } else {
-    add_instr(&fix_size_unit, offset, size);
+    add_instr(&fix_size_unit, offset, size, ctx->memrefs->size);
   }
 #endif
 }
@@ -795,22 +733,20 @@ onLowBrTable(struct CompilerContext* ctx, const struct MachineInstr* minstr)
   uint8_t type = minstr->type;
 
   if (type == BrTableJmp) {
-    assert((uint8_t)output(ctx)->data[offset - 5] >= 0x80 &&
-           (uint8_t)output(ctx)->data[offset - 5] <= 0x8f);
+    if (widen_last_jump(ctx) != JccNear) {
+      assert(0);
+    }
+    offset = pc_offset(output(ctx));
     memref = new_memref(memrefs);
     memref->type = MEMREF_BR_TABLE_JMP;
     memref->code_offset = offset - 4;
     memref->unit_idx = node->id;
     memref->idx = (br_table_num << 16) | (minstr->max << 8) | minstr->min;
   } else if (type == BrCaseJmp) {
-    if ((uint8_t)output(ctx)->data[offset - 2] == 0xeb) {
-      output(ctx)->data[offset - 2] = 0xe9;
-      emit(output(ctx), 0x00);
-      emit(output(ctx), 0x00);
-      emit(output(ctx), 0x00);
+    if (widen_last_jump(ctx) != JumpNear) {
+      assert(0);
     }
     offset = pc_offset(output(ctx));
-    assert((uint8_t)output(ctx)->data[offset - 5] == 0xe9);
     memref = new_memref(memrefs);
     memref->type = MEMREF_BR_CASE_JMP;
     memref->code_offset = offset - 4;
@@ -827,7 +763,8 @@ onLowBrTable(struct CompilerContext* ctx, const struct MachineInstr* minstr)
     size_t id = (br_table_num << 8) | minstr->depth;
     size_t i;
     int found = 0;
-    for (i = 0; i < memrefs->size; i++) {
+    // Only the targets of this br_table can match.
+    for (i = br_table_memref; i < memrefs->size; i++) {
       struct MemoryRef* ref = &memrefs->data[i];
       if (ref->type != MEMREF_BR_CASE_TARGET) {
         continue;
@@ -920,7 +857,7 @@ onMachineInstrEnd(struct CompilerContext* ctx, const struct Function* func,
     split_unit(ctx, &fix_size_unit);
 
   } else {
-    add_instr(&fix_size_unit, offset, size);
+    add_instr(&fix_size_unit, offset, size, ctx->memrefs->size);
   }
 #endif
 }
@@ -969,6 +906,7 @@ PassInit(struct PassManager* pm)
       break;
     }
     if (strcmp(pass->name, "cfg") == 0) {
+      cfg_pass = pass;
       cfg = get_cfg(pass);
       break;
     }
@@ -13,10 +13,12 @@ DEFINE_VECTOR_GROW(fun_cfg, struct FunctionCFG);
 DEFINE_VECTOR_INIT(cfg_target_list, struct CFGTargetList);
 static DEFINE_VECTOR_GROW(cfg_target_list, struct CFGTargetList);
 
-static struct ControlFlowGraph cfg = { 0, 0, NULL };
-static struct FunctionCFG* fun_cfg;
+// Per-thread state, see parallel.h. Each compiling thread records the
+// CFGs of the functions it compiled; get_cfg returns the caller's.
+static SGXWASM_TLS struct ControlFlowGraph cfg = { 0, 0, NULL };
+static SGXWASM_TLS struct FunctionCFG* fun_cfg;
 
-static uint8_t last_branch;
+static SGXWASM_TLS uint8_t last_branch;
 
 __attribute__((unused)) static void
 dump_cfg(struct ControlFlowGraph* cfg)
@@ -94,13 +96,8 @@ flush_units(struct CompilerContext* ctx,
 static int
 is_ending_with_jmp(struct CompilerContext* ctx)
 {
-  size_t offset = pc_offset(output(ctx));
-  if ((uint8_t)output(ctx)->data[offset - 5] == 0xe9) {
-    return 1;
-  } else if ((uint8_t)output(ctx)->data[offset - 2] == 0xeb) {
-    return 1;
-  }
-  return 0;
+  const struct MachineInstr* jump = last_jump(ctx);
+  return jump != NULL && (jump->jump == JumpNear || jump->jump == JumpShort);
 }
 
 __attribute__((unused)) static void
@@ -313,9 +310,14 @@ onFunctionStart(struct CompilerContext* ctx, const struct Function* func)
 __attribute__((unused)) static void
 onFunctionEnd(struct CompilerContext* ctx, const struct Function* func)
 {
+  assert(fun_cfg != NULL);
+  // Close the last node, the passes check it at the end of the function.
+  struct CFGNode* node = &fun_cfg->data[fun_cfg->size - 1];
 
-  (void)ctx;
   (void)func;
+
+  node->size = pc_offset(output(ctx)) - node->offset;
+  node->low_instr_num = num_low_instrs(ctx) - node->low_instr_offset;
 }
 
 __attribute__((unused)) static void
@@ -598,6 +600,39 @@ onBranchEnd(struct CompilerContext* ctx,
   }
 }
 
+/* The indirect jmp of a br_table lowered to a jump table may only land
+ * on the cases emitted right after the table, in the same node. Each
+ * case then branches to its target with a br-like jmp, handled by
+ * onBranchEnd. Record the node itself as the target of the jmp, so that
+ * every entry of the table is a known target.
+ * Of the passes using the CFG, only caslr sees jump tables:
+ * sgxwasm_instantiate leaves br_tables as compare chains under tsgx,
+ * varys, lspectre and aslr, whose instrumentation an indirect jmp would
+ * bypass.
+ */
+__attribute__((unused)) static void
+onJumpTableEnd(struct CompilerContext* ctx,
+               const struct Function* func,
+               const struct MachineInstr* minstr)
+{
+  assert(fun_cfg != NULL);
+  struct CFGNode* node = &fun_cfg->data[fun_cfg->size - 1];
+  struct CFGTarget* target = new_target(node);
+  assert(node != NULL && target != NULL);
+#if __DEBUG_CFG__
+  plog("[onJumpTableEnd] fun: %zu, br_table of %u entries\n",
+       func->fun_index,
+       minstr->max);
+#else
+  (void)func;
+  (void)minstr;
+#endif
+  target->id = node->id;
+  target->type = TargetKnown;
+  target->offset = pc_offset(output(ctx));
+  target->depth = 0;
+}
+
 __attribute__((unused)) static void
 onMachineInstrStart(struct CompilerContext* ctx,
                   const struct Function* func,
@@ -619,6 +654,8 @@ onMachineInstrEnd(struct CompilerContext* ctx,
   assert(minstr != NULL);
   if (minstr->type == UcondBranch || minstr->type == CondBranch) {
     onBranchEnd(ctx, func, minstr->instr, minstr->depth);
+  } else if (minstr->type == JumpTableJmp) {
+    onJumpTableEnd(ctx, func, minstr);
   }
 }
 #endif // End of __CFG__
@@ -645,6 +682,45 @@ PassEnd(struct PassManager* pm)
 #endif
 }
 
+static int
+is_pending_jump(const struct MemoryRef* memref)
+{
+  if (memref->type != MEMREF_JMP_NEXT && memref->type != MEMREF_LEA_NEXT) {
+    return 0;
+  }
+  return memref->target_type == IfUnknown ||
+         memref->target_type == ElseUnknown ||
+         memref->target_type == BrUnknown;
+}
+
+void
+update_pending_jumps(struct CompilerContext* ctx)
+{
+  struct MemoryReferences* memrefs = ctx->memrefs;
+  size_t i, n = 0;
+
+  // Drop the resolved ones.
+  for (i = 0; i < ctx->pending_jumps.size; i++) {
+    size_t idx = ctx->pending_jumps.data[i];
+    if (is_pending_jump(&memrefs->data[idx])) {
+      ctx->pending_jumps.data[n++] = idx;
+    }
+  }
+  ctx->pending_jumps.size = n;
+
+  // Add the new ones.
+  for (i = ctx->pending_scanned; i < memrefs->size; i++) {
+    if (!is_pending_jump(&memrefs->data[i])) {
+      continue;
+    }
+    if (!VECTOR_GROW(&ctx->pending_jumps)) {
+      assert(0);
+    }
+    ctx->pending_jumps.data[ctx->pending_jumps.size - 1] = i;
+  }
+  ctx->pending_scanned = memrefs->size;
+}
+
 struct ControlFlowGraph*
 get_cfg(struct Pass* pass)
 {
@@ -2,6 +2,7 @@
 #define __SGXWASM__PASS_CFG_H__
 
 struct Pass;
+struct CompilerContext;
 
 enum ControlState
 {
@@ -68,4 +69,11 @@ get_target(struct CFGNode*);
 struct ControlFlowGraph*
 get_cfg(struct Pass*);
 
+// Bring ctx->pending_jumps up to date: the indices of the
+// MEMREF_JMP_NEXT and MEMREF_LEA_NEXT memory references whose target
+// is IfUnknown, ElseUnknown or BrUnknown, so that patching the targets
+// at a control start or end does not scan all memory references.
+void
+update_pending_jumps(struct CompilerContext*);
+
 #endif
@@ -18,49 +18,42 @@
     lfence
     ...
     jmp next_bb
+
+ With LSPECTRE_MASK (speculative load hardening), the lfence becomes
+
+    jae ...
+    mov r10d, 0
+    cmovae r14d, r10d   # predicate, all ones on the architectural path
+    ...
+    and index, r14d     # before each load and store, see load_mem()
  */
 
 #if __LSPECTRE__
+#if LSPECTRE_MASK && (__TSGX__ || __VARYS__)
+#error "LSPECTRE_MASK keeps its predicate in R14, which T-SGX and Varys use"
+#endif
+
 static const char* pass_name = "lspectre";
 
 #define JMP_SIZE 12
 
 // Global variables.
-static struct ControlFlowGraph* cfg;
-static struct FunctionCFG* fun_cfg;
+// Per-thread state, see parallel.h.
+static struct Pass* cfg_pass;
+static SGXWASM_TLS struct ControlFlowGraph* cfg;
+static SGXWASM_TLS struct FunctionCFG* fun_cfg;
 static int is_caslr_enabled;
 
 // Use to track the number of br_tables.
-static int br_table_num;
+static SGXWASM_TLS int br_table_num;
+// Memory references added since the current br_table started.
+static SGXWASM_TLS size_t br_table_memref;
 
-static uint8_t last_branch;
+static SGXWASM_TLS uint8_t last_branch;
 
 #define LOW_INSTR_FREQ 30
-static size_t low_instr_counter;
-
-#if 1 // For debug.
-/*#define ListSize 27
-static size_t whitelist[ListSize] = { 21, 24, 27, 29, 32, 33, 36, 38, 41,
-                                      42, 43, 52, 53, 54, 55, 56, 59, 61,
-                                      63, 64, 65, 66, 76, 77, 80, 81, 82 };*/
+static SGXWASM_TLS size_t low_instr_counter;
 
-#define ListSize 3
-static size_t whitelist[ListSize] = { 681, 796, 839 };
-// static size_t skip_number = 1174;
-// static size_t skip_counter = 0;
-
-__attribute__((unused)) static int
-is_in_whitelist(size_t id)
-{
-  int i;
-  for (i = 0; i < ListSize; i++) {
-    if (id == whitelist[i]) {
-      return 1;
-    }
-  }
-  return 0;
-}
-#endif
 
 // Debug
 // static int counter = 0;
@@ -102,11 +95,10 @@ jump_to_next_bb(struct CompilerContext* ctx, struct CFGNode* node,
   struct MemoryRef* memref = new_memref(memrefs);
 
   if (is_cond == UcondBranch) {
-    emit_jmp_32(output(ctx), 0);
+    emit_pass_jump(ctx, COND_NONE);
   } else {
     assert(is_cond == CondBranch);
-    label_t label = { 0, 0 };
-    emit_jcc(output(ctx), cond, &label, Far);
+    emit_pass_jump(ctx, cond);
   }
 
   // unit_id will be resolved based on offset (see convert_to_unit_relo_info()).
@@ -130,22 +122,16 @@ __attribute__((unused)) static size_t
 insert_jump(struct CompilerContext* ctx, struct CFGNode* node,
             struct CFGTarget* target)
 {
-  size_t offset = pc_offset(output(ctx));
-  size_t start = offset;
+  const struct MachineInstr* jump = last_jump(ctx);
+  size_t start = pc_offset(output(ctx));
   int end_with_br_if = 0;
 
   // If the last instruction is already jmp, skip.
-  if ((uint8_t)output(ctx)->data[offset - 5] == 0xe9 &&
+  if (jump != NULL && (jump->jump == JumpNear || jump->jump == JumpShort) &&
       last_branch != OPCODE_BR_IF) {
 #if __DEBUG_LSPECTRE__
-    plog("[insert_jump] skip id: %zu, ends with 32-bit jmp\n", node->id);
-#endif
-    end_with_br_if = 1;
-    return 0;
-  } else if ((uint8_t)output(ctx)->data[offset - 2] == 0xeb &&
-             last_branch != OPCODE_BR_IF) {
-#if __DEBUG_LSPECTRE__
-    plog("[insert_jump] skip id: %zu, ends with 8-bit jmp\n", node->id);
+    plog("[insert_jump] skip id: %zu, ends with %s jmp\n", node->id,
+         jump->jump == JumpNear ? "32-bit" : "8-bit");
 #endif
     end_with_br_if = 1;
     return 0;
@@ -156,27 +142,41 @@ insert_jump(struct CompilerContext* ctx, struct CFGNode* node,
   return pc_offset(output(ctx)) - start;
 }
 
+// Guard the fall-through of a jcc on cond. The flags still hold the
+// compare of the jcc, so cond is set there only if the jcc was
+// mispredicted. Modules without a memory have no index to mask and
+// their entry functions do not set up PredicateReg, so they keep the
+// lfence.
+static void
+harden_fall_through(struct CompilerContext* ctx, condition_t cond)
+{
+#if LSPECTRE_MASK
+  if (sgxwasm_get_module(ctx->func)->mems.size > 0) {
+    // ScratchGP holds no value across machine instructions; mov keeps
+    // the flags.
+    emit_movl_ri(output(ctx), ScratchGP, 0);
+    emit_cmov_rr(output(ctx), cond, PredicateReg, ScratchGP, VALTYPE_I32);
+    return;
+  }
+#else
+  (void)cond;
+#endif
+  emit_lfence(output(ctx));
+}
+
 __attribute__((unused)) static void
 update_branch(struct CompilerContext* ctx, struct CFGNode* node,
               struct CFGTarget* target)
 {
+  condition_t cond;
+  uint8_t jump = drop_last_jump(ctx, &cond);
 
-  size_t offset = pc_offset(output(ctx));
-
-  // Case of unconditional 32-bit jump.
-  if ((uint8_t)output(ctx)->data[offset - 5] == 0xe9) {
-    output_buf_shrink(output(ctx), 5);
+  // Case of unconditional jump.
+  if (jump == JumpNear || jump == JumpShort) {
     jump_to_next_bb(ctx, node, target, MEMREF_JMP_NEXT, UcondBranch, COND_NONE);
-  } else if ((uint8_t)output(ctx)->data[offset - 2] == 0xeb) {
-    // Case of unconditional 8-bit jump.
-    output_buf_shrink(output(ctx), 2);
-    jump_to_next_bb(ctx, node, target, MEMREF_JMP_NEXT, UcondBranch, COND_NONE);
-  } else if ((uint8_t)output(ctx)->data[offset - 5] >= 0x80 &&
-             (uint8_t)output(ctx)->data[offset - 5] <= 0x8f) {
-    condition_t cond = (uint8_t)output(ctx)->data[offset - 5] & 0xf;
-    output_buf_shrink(output(ctx), 6);
+  } else if (jump == JccNear || jump == JccShort) {
     jump_to_next_bb(ctx, node, target, MEMREF_JMP_NEXT, CondBranch, cond);
-    emit_lfence(output(ctx));
+    harden_fall_through(ctx, cond);
   } else {
 #if __DEBUG_LSPECTRE__
     plog("[update_branch] unhandled - id: %zu, depth %zu\n", node->id,
@@ -192,13 +192,15 @@ try_patch_target(struct CompilerContext* ctx, struct CFGNode* node)
 {
   assert(ctx->memrefs != NULL);
   struct MemoryReferences* memrefs = ctx->memrefs;
-  size_t i;
+  size_t i, j;
   uint8_t control_state = node->control_state;
   control_type_t control_type = node->control_type;
 
   (void)control_type;
 
-  for (i = 0; i < memrefs->size; i++) {
+  update_pending_jumps(ctx);
+  for (j = 0; j < ctx->pending_jumps.size; j++) {
+    i = ctx->pending_jumps.data[j];
     uint8_t target_type = memrefs->data[i].target_type;
     if (memrefs->data[i].type != MEMREF_JMP_NEXT) {
       continue;
@@ -269,6 +271,7 @@ onFunctionStart(struct CompilerContext* ctx, const struct Function* func)
   // Reset the low_instr_counter.
   low_instr_counter = 0;
 
+  cfg = get_cfg(cfg_pass);
   fun_cfg = NULL;
   for (i = 0; i < cfg->size; i++) {
     struct FunctionCFG* f = &cfg->data[i];
@@ -347,6 +350,10 @@ onInstructionStart(struct CompilerContext* ctx, const struct Function* func,
   (void)ctx;
   (void)func;
   (void)instr;
+
+  if (instr->opcode == OPCODE_BR_TABLE) {
+    br_table_memref = ctx->memrefs->size;
+  }
 }
 
 __attribute__((unused)) static void
@@ -466,22 +473,20 @@ onLowBrTable(struct CompilerContext* ctx, const struct MachineInstr* minstr)
   uint8_t type = minstr->type;
 
   if (type == BrTableJmp) {
-    assert((uint8_t)output(ctx)->data[offset - 5] >= 0x80 &&
-           (uint8_t)output(ctx)->data[offset - 5] <= 0x8f);
+    if (widen_last_jump(ctx) != JccNear) {
+      assert(0);
+    }
+    offset = pc_offset(output(ctx));
     memref = new_memref(memrefs);
     memref->type = MEMREF_BR_TABLE_JMP;
     memref->code_offset = offset - 4;
     memref->unit_idx = node->id;
     memref->idx = (br_table_num << 16) | (minstr->max << 8) | minstr->min;
   } else if (type == BrCaseJmp) {
-    if ((uint8_t)output(ctx)->data[offset - 2] == 0xeb) {
-      output(ctx)->data[offset - 2] = 0xe9;
-      emit(output(ctx), 0x00);
-      emit(output(ctx), 0x00);
-      emit(output(ctx), 0x00);
+    if (widen_last_jump(ctx) != JumpNear) {
+      assert(0);
     }
     offset = pc_offset(output(ctx));
-    assert((uint8_t)output(ctx)->data[offset - 5] == 0xe9);
     memref = new_memref(memrefs);
     memref->type = MEMREF_BR_CASE_JMP;
     memref->code_offset = offset - 4;
@@ -498,7 +503,8 @@ onLowBrTable(struct CompilerContext* ctx, const struct MachineInstr* minstr)
     size_t id = (br_table_num << 8) | minstr->depth;
     size_t i;
     int found = 0;
-    for (i = 0; i < memrefs->size; i++) {
+    // Only the targets of this br_table can match.
+    for (i = br_table_memref; i < memrefs->size; i++) {
       struct MemoryRef* ref = &memrefs->data[i];
       if (ref->type != MEMREF_BR_CASE_TARGET) {
         continue;
@@ -612,6 +618,7 @@ PassInit(struct PassManager* pm)
       break;
     }
     if (strcmp(pass->name, "cfg") == 0) {
+      cfg_pass = pass;
       cfg = get_cfg(pass);
       continue;
     }
@@ -0,0 +1,100 @@
+#include <sgxwasm/pass.h>
+#include <sgxwasm/profile.h>
+
+/*
+ Profile scheme (counters live in struct Function):
+ fun:
+   calls++
+   abort_slot = &aborts
+   ...
+ block/if:
+   blocks++
+ loop:
+ label:
+   blocks++
+   ...
+ call:
+   call target
+   abort_slot = &aborts
+*/
+
+#if __PROFILE__
+static const char* pass_name = "profile";
+
+// R10 and R11 are scratch registers that never hold values across
+// instructions.
+static void
+emit_counter_inc(struct SizedBuffer* out, const uint64_t* counter)
+{
+  struct Operand op;
+  emit_movq_ri(out, GP_R11, (uint64_t)counter);
+  build_operand(&op, GP_R11, REG_UNKNOWN, SCALE_NONE, 0);
+  emit_mov_rm(out, GP_R10, &op, VALTYPE_I64);
+  emit_add_ri(out, GP_R10, 1, VALTYPE_I64);
+  emit_mov_mr(out, &op, GP_R10, VALTYPE_I64);
+}
+
+static void
+emit_set_abort_slot(struct SizedBuffer* out, const struct Function* func)
+{
+  struct Operand op;
+  emit_movq_ri(out, GP_R10, (uint64_t)&func->profile.aborts);
+  emit_movq_ri(out, GP_R11, (uint64_t)&sgxwasm_profile_abort_slot);
+  build_operand(&op, GP_R11, REG_UNKNOWN, SCALE_NONE, 0);
+  emit_mov_mr(out, &op, GP_R10, VALTYPE_I64);
+}
+
+__attribute__((unused)) static void
+onFunctionStart(struct CompilerContext* ctx, const struct Function* func)
+{
+  emit_counter_inc(output(ctx), &func->profile.calls);
+  emit_set_abort_slot(output(ctx), func);
+}
+
+__attribute__((unused)) static void
+onControlStart(struct CompilerContext* ctx, const struct Function* func,
+               control_type_t control_type, size_t depth)
+{
+  (void)depth;
+
+  // Loops are counted per iteration, at their label.
+  if (control_type != CONTROL_BLOCK && control_type != CONTROL_IF) {
+    return;
+  }
+  emit_counter_inc(output(ctx), &func->profile.blocks);
+}
+
+__attribute__((unused)) static void
+onInstructionEnd(struct CompilerContext* ctx, const struct Function* func,
+                 const struct Instr* instr)
+{
+  // The callee moved the abort slot.
+  if (instr->opcode == OPCODE_CALL || instr->opcode == OPCODE_CALL_INDIRECT) {
+    emit_set_abort_slot(output(ctx), func);
+  }
+}
+
+__attribute__((unused)) static void
+onMachineInstrEnd(struct CompilerContext* ctx, const struct Function* func,
+                  const struct MachineInstr* minstr)
+{
+  if (minstr->type != BindLabel || minstr->instr == NULL ||
+      minstr->instr->opcode != OPCODE_LOOP) {
+    return;
+  }
+  emit_counter_inc(output(ctx), &func->profile.blocks);
+}
+#endif
+
+void
+add_pass_profile(struct PassManager* pm)
+{
+  (void)pm;
+#if __PROFILE__
+  struct Pass* pass = get_new_pass(pm);
+  assert(pass != NULL);
+  pass_init(pass, pass_name, NULL, NULL, onFunctionStart, NULL,
+            onControlStart, NULL, NULL, onInstructionEnd, NULL,
+            onMachineInstrEnd, NULL);
+#endif
+}
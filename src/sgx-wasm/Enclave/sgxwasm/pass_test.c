@@ -4,10 +4,10 @@
 static const char* pass_name = "test";
 
 #if MEMORY_TRACE
-size_t prev_count = 0;
+static SGXWASM_TLS size_t prev_count = 0;
 #endif
 
-static int function_start_flag = 0;
+static SGXWASM_TLS int function_start_flag = 0;
 
 void
 onFunctionStart(struct CompilerContext* ctx, const struct Function* func)
@@ -85,7 +85,7 @@ onInstructionStart(struct CompilerContext* ctx,
 
   // Spill the input parameters to stack before the call.
   struct ControlBlock* c = control_at(control(ctx), 0);
-  if (control_depth(control(ctx)) == 1 && c->cont == 1 &&
+  if (control_depth(control(ctx)) == 1 && instr_id(ctx) == 0 &&
       c->type == CONTROL_BLOCK && function_start_flag == 0) {
     for (i = 0; i < num_params; i++) {
       struct StackSlot* slot = &cache_state(ctx)->stack_state->data[i];
@@ -1,5 +1,6 @@
 #include <sgxwasm/pass.h>
 #include <sgxwasm/pass_cfg.h>
+#include <sgxwasm/profile.h>
 
 /*
  T-SGX scheme:
@@ -32,127 +33,101 @@ static const char* pass_name = "tsgx";
 #endif
 
 // Global variables.
-static struct ControlFlowGraph* cfg;
-static struct FunctionCFG* fun_cfg;
+// Per-thread state, see parallel.h.
+static struct Pass* cfg_pass;
+static SGXWASM_TLS struct ControlFlowGraph* cfg;
+static SGXWASM_TLS struct FunctionCFG* fun_cfg;
 static int is_caslr_enabled;
 
 // Use to track the number of br_tables.
-static int br_table_num;
-
-static uint8_t last_branch;
-
-// nbench
-//#define SkipNum 6
-// static size_t skiplist[SkipNum] = { 108, 109, 138, 144, 197, 198 };
-
-// fib
-//#define SkipNum 1
-// static size_t skiplist[SkipNum] = { 21 };
-
-//#define SkipNum 9
-// lighttpd:
-// 607:_malloc
-// 608:_free
-// 609:_calloc
-// 610:_realloc
-// 611:try_realloc_chunk
-// 848:_memcpy
-// 849:_memmove
-// 850:_memset
-// 851:_sbrk
-// static size_t skiplist[SkipNum] = { 607, 608, 609, 610, 611, 848, 849, 850,
-// 851 };
-
-// 23: init_array
-// 28: malloc
-// 29: free
-// 78: memcpy
-// 79: memset
-// 80: sbrk
-//#define SkipNum 5
-//static size_t skiplist[SkipNum] = { 28, 29, 78, 79,
-//                                    80 }; // poly-c: cholesky, lu, ludcmp
-#define SkipNum 6
-static size_t skiplist[SkipNum] = { 23, 28, 29, 78, 79, 80 }; // poly-c
-
-//#define SkipNum 0
-//static size_t skiplist[SkipNum];
+static SGXWASM_TLS int br_table_num;
+// Memory references added since the current br_table started.
+static SGXWASM_TLS size_t br_table_memref;
 
-__attribute__((unused)) static int
-is_in_skiplist(size_t id)
+static SGXWASM_TLS uint8_t last_branch;
+
+// Per-function policy from the hardening profile (profile.h).
+static int
+is_in_skiplist(const struct Module* module, size_t id)
 {
-  int i;
-  for (i = 0; i < SkipNum; i++) {
-    if (id == skiplist[i]) {
-      return 1;
-    }
-  }
-  return 0;
+  return has_hardening(module->funcs.data[id], HARDEN_SKIP);
 }
 
-// static size_t optlist[OptNum] = { 24 }; // fannkuchredux
+static int
+is_in_optlist(const struct Module* module, size_t id)
+{
+  return has_hardening(module->funcs.data[id], HARDEN_OPT);
+}
 
-//#define OptNum 0
-//static size_t optlist[OptNum];
-// static size_t optlist[OptNum] = { 85 }; // lighttpd
-#define OptNum 1
-static size_t optlist[OptNum] = { 15 }; // stackAlloc, 2mm
-//#define OptNum 7
-//static size_t optlist[OptNum] = { 241, 293, 339, 343, 476, 616, 690 };
+#if TSX_SUPPORT
+#if __PROFILE__
+// The inline sites sit next to calls whose target and arguments may be
+// in any register, so R10 and R11 are saved around the increment.
+static void
+emit_inline_counter_inc(struct SizedBuffer* out, const uint64_t* counter)
+{
+  struct Operand op;
+  emit_pushq_r(out, GP_R10);
+  emit_pushq_r(out, GP_R11);
+  emit_movq_ri(out, GP_R11, (uint64_t)counter);
+  build_operand(&op, GP_R11, REG_UNKNOWN, SCALE_NONE, 0);
+  emit_mov_rm(out, GP_R10, &op, VALTYPE_I64);
+  emit_add_ri(out, GP_R10, 1, VALTYPE_I64);
+  emit_mov_mr(out, &op, GP_R10, VALTYPE_I64);
+  emit_popq_r(out, GP_R11);
+  emit_popq_r(out, GP_R10);
+}
+#endif
 
-__attribute__((unused)) static int
-is_in_optlist(size_t id)
+// Transactions begun and ended outside the springboard: around calls
+// that leave T-SGX and in _main. With __PROFILE__ they count their
+// aborts and commits like the springboard does, but straight into the
+// function's counters: the abort slot still names the callee right
+// after a call.
+//     jmp begin
+// abort:
+//     inc qword [func.aborts]
+// begin:
+//     xbegin abort
+//     ...
+//     xend
+//     inc qword [func.commits]
+static void
+emit_inline_xbegin(struct SizedBuffer* out, const struct Function* func)
 {
-  int i;
-  for (i = 0; i < OptNum; i++) {
-    if (id == optlist[i]) {
-      return 1;
-    }
-  }
-  return 0;
+  label_t begin = { 0, 0 };
+#if __PROFILE__
+  label_t abort = { 0, 0 };
+  emit_jmp_label(out, &begin, Near);
+  bind_label(out, &abort, pc_offset(out));
+  emit_inline_counter_inc(out, &func->profile.aborts);
+  bind_label(out, &begin, pc_offset(out));
+  emit_xbegin(out, &abort);
+#else
+  (void)func;
+  bind_label(out, &begin, pc_offset(out));
+  emit_xbegin(out, &begin);
+#endif
+}
+
+static void
+emit_inline_xend(struct SizedBuffer* out, const struct Function* func)
+{
+  emit_xend(out);
+#if __PROFILE__
+  emit_inline_counter_inc(out, &func->profile.commits);
+#else
+  (void)func;
+#endif
 }
+#endif
 
 #define LOOP_OPT 1
-/*#define LoopOptNum 20
-static size_t loop_optlist[OptNum] = { 168, 231, 232, 236, 239, 241, 293, 339,
-341, 337,
-                                       338, 343, 426, 476, 616, 618, 690,
-                                       702, 719, 801};*/
 
 __attribute__((unused)) static int
-is_in_loop_optlist(size_t id)
+is_in_loop_optlist(const struct Module* module, size_t id)
 {
-  return 1;
-#if 0
-  if (id >= 700 && id <= 865) {
-    return 1;
-  }
-  if (id >= 600 && id < 700) {
-    return 1;
-  }
-  if (id >= 500 && id < 600) {
-    return 1;
-  }
-  if (id >= 400 && id < 500) {
-    return 1;
-  }
-  if (id >= 300 && id < 400) {
-    return 1;
-  }
-  /*if (id >= 200 && id < 300) {
-    return 1;
-  }*/
-  return 0;
-#endif
-#if 0
-  int i;
-  for (i = 0; i < LoopOptNum; i++) {
-    if (id == loop_optlist[i]) {
-      return 1;
-    }
-  }
-  return 0;
-#endif
+  return has_hardening(module->funcs.data[id], HARDEN_LOOP);
 }
 
 #if FIX_SIZE_UNIT // For fix-sized code units
@@ -166,16 +141,19 @@ struct FixSizeCodeUnit
   {
     size_t offset;
     size_t size;
+    // Memory references added from here on.
+    size_t memref;
   } * data;
 };
 static DEFINE_VECTOR_GROW(fix_size_unit, struct FixSizeCodeUnit);
 static DEFINE_VECTOR_INIT(fix_size_unit, struct FixSizeCodeUnit);
 static DEFINE_VECTOR_RESIZE(fix_size_unit, struct FixSizeCodeUnit);
 
-struct FixSizeCodeUnit fix_size_unit;
+static SGXWASM_TLS struct FixSizeCodeUnit fix_size_unit;
 
 static void
-add_instr(struct FixSizeCodeUnit* code_unit, size_t offset, size_t size)
+add_instr(struct FixSizeCodeUnit* code_unit, size_t offset, size_t size,
+          size_t memref)
 {
   assert(code_unit != NULL);
   if (!fix_size_unit_grow(code_unit)) {
@@ -184,6 +162,7 @@ add_instr(struct FixSizeCodeUnit* code_unit, size_t offset, size_t size)
   struct UnitInstr* instr = &code_unit->data[code_unit->size - 1];
   instr->offset = offset;
   instr->size = size;
+  instr->memref = memref;
 }
 
 static void
@@ -195,31 +174,11 @@ reset_unit(struct FixSizeCodeUnit* code_unit)
 }
 #endif
 
-#if 1 // For debug.
-/*#define ListSize 27
-static size_t whitelist[ListSize] = { 21, 24, 27, 29, 32, 33, 36, 38, 41,
-                                      42, 43, 52, 53, 54, 55, 56, 59, 61,
-                                      63, 64, 65, 66, 76, 77, 80, 81, 82 };*/
-
-#define ListSize 3
-// 27, 59, 63
-static size_t whitelist[ListSize] = { 681, 796, 839 };
-// static size_t skip_number = 900;
-static size_t skip_number = 0;
-// static size_t skip_counter = 0;
-
 __attribute__((unused)) static int
-is_in_whitelist(size_t id)
+is_in_whitelist(const struct Function* func)
 {
-  int i;
-  for (i = 0; i < ListSize; i++) {
-    if (id == whitelist[i]) {
-      return 1;
-    }
-  }
-  return 0;
+  return has_hardening(func, HARDEN_UNIT);
 }
-#endif
 
 // Debug
 // static int counter = 0;
@@ -286,7 +245,7 @@ jump_to_next(struct CompilerContext* ctx, struct CFGNode* node,
   struct MemoryReferences* memrefs = ctx->memrefs;
   struct MemoryRef* memref = new_memref(memrefs);
 
-  emit_jmp_32(output(ctx), 0);
+  emit_pass_jump(ctx, COND_NONE);
 
   memref->type = MEMREF_LEA_NEXT;
   memref->code_offset = pc_offset(output(ctx)) - 4;
@@ -312,11 +271,10 @@ jump_to_springboard(struct CompilerContext* ctx, size_t type, size_t is_cond,
   struct MemoryRef* memref = new_memref(memrefs);
 
   if (is_cond == UcondBranch) {
-    emit_jmp_32(output(ctx), 0);
+    emit_pass_jump(ctx, COND_NONE);
   } else {
     assert(is_cond == CondBranch);
-    label_t label = { 0, 0 };
-    emit_jcc(output(ctx), cond, &label, Far);
+    emit_pass_jump(ctx, cond);
   }
 
   // unit_id will be resolved based on offset (see convert_to_unit_relo_info()).
@@ -341,11 +299,10 @@ update_jump_to_springboard(struct CompilerContext* ctx,
 #endif
 
   if (is_cond == UcondBranch) {
-    emit_jmp_32(output(ctx), 0);
+    emit_pass_jump(ctx, COND_NONE);
   } else {
     assert(is_cond == CondBranch);
-    label_t label = { 0, 0 };
-    emit_jcc(output(ctx), cond, &label, Far);
+    emit_pass_jump(ctx, cond);
   }
   memset(memref, 0, sizeof(struct MemoryRef));
   memref->type = type;
@@ -361,22 +318,15 @@ __attribute__((unused)) static size_t
 insert_jump(struct CompilerContext* ctx, struct CFGNode* node,
             struct CFGTarget* target, int split)
 {
-  size_t offset = pc_offset(output(ctx));
-  size_t start = offset;
+  const struct MachineInstr* jump = last_jump(ctx);
+  size_t start = pc_offset(output(ctx));
 
   // If the last instruction is already jmp, skip.
-  if ((uint8_t)output(ctx)->data[offset - 5] == 0xe9 &&
+  if (jump != NULL && (jump->jump == JumpNear || jump->jump == JumpShort) &&
       last_branch != OPCODE_BR_IF) {
 #if __DEBUG_TSGX__
-    plog("[insert_jump] skip id: %zu, ends with 32-bit jmp, last branch: %x\n",
-         node->id, last_branch);
-#endif
-    return 0;
-  } else if ((uint8_t)output(ctx)->data[offset - 2] == 0xeb &&
-             last_branch != OPCODE_BR_IF) {
-#if __DEBUG_TSGX__
-    plog("[insert_jump] skip id: %zu, ends with 8-bit jmp, last branch: %x\n",
-         node->id, last_branch);
+    plog("[insert_jump] skip id: %zu, ends with %s jmp, last branch: %x\n",
+         node->id, jump->jump == JumpNear ? "32-bit" : "8-bit", last_branch);
 #endif
     return 0;
   }
@@ -397,9 +347,6 @@ __attribute__((unused)) static void
 update_branch(struct CompilerContext* ctx, struct CFGNode* node,
               struct CFGTarget* target, int split)
 {
-
-  size_t offset = pc_offset(output(ctx));
-
   if (split == 1 && target != NULL && target->type == TargetLoopKnown) {
 #if __DEBUG_TSX__
     plog("[update_branch] Target is loop, split = 0\n");
@@ -408,20 +355,13 @@ update_branch(struct CompilerContext* ctx, struct CFGNode* node,
   }
 
   if (split == 1) {
-    // Case of unconditional 32-bit jump.
-    if ((uint8_t)output(ctx)->data[offset - 5] == 0xe9) {
-      output_buf_shrink(output(ctx), 5);
+    condition_t cond;
+    uint8_t jump = drop_last_jump(ctx, &cond);
+    // Case of unconditional jump.
+    if (jump == JumpNear || jump == JumpShort) {
       insert_lea(ctx, node, target);
       jump_to_springboard(ctx, MEMREF_SPRINGBOARD_NEXT, UcondBranch, COND_NONE);
-    } else if ((uint8_t)output(ctx)->data[offset - 2] == 0xeb) {
-      // Case of unconditional 8-bit jump.
-      output_buf_shrink(output(ctx), 2);
-      insert_lea(ctx, node, target);
-      jump_to_springboard(ctx, MEMREF_SPRINGBOARD_NEXT, UcondBranch, COND_NONE);
-    } else if ((uint8_t)output(ctx)->data[offset - 5] >= 0x80 &&
-               (uint8_t)output(ctx)->data[offset - 5] <= 0x8f) {
-      condition_t cond = (uint8_t)output(ctx)->data[offset - 5] & 0xf;
-      output_buf_shrink(output(ctx), 6);
+    } else if (jump == JccNear || jump == JccShort) {
       insert_lea(ctx, node, target);
       jump_to_springboard(ctx, MEMREF_SPRINGBOARD_NEXT, CondBranch, cond);
 #if LS
@@ -439,24 +379,10 @@ update_branch(struct CompilerContext* ctx, struct CFGNode* node,
     assert(ctx->memrefs != NULL);
     struct MemoryReferences* memrefs = ctx->memrefs;
     struct MemoryRef* memref = new_memref(memrefs);
-    // Case of unconditional 32-bit jump.
-    if ((uint8_t)output(ctx)->data[offset - 5] == 0xe9) {
-      memref->type = MEMREF_LEA_NEXT;
-      memref->code_offset = offset - 4;
-      memref->unit_idx = node->id;
-      memref->idx = target->id;
-      memref->target_type = target->type;
-      // Target depth is relative depth, need covertion here.
-      memref->depth = node->depth - target->depth;
-    } else if ((uint8_t)output(ctx)->data[offset - 2] == 0xeb) {
-      // Convert 8-bit jmp to 32-bit.
-      // 0xeb 0x00 -> 0xe9 0x00 0x00 0x00 0x00
-      output(ctx)->data[offset - 2] = 0xe9;
-      emit(output(ctx), 0x00);
-      emit(output(ctx), 0x00);
-      emit(output(ctx), 0x00);
-
-      // Case of unconditional 8-bit jump
+    // Short jumps are widened to 32-bit ones.
+    uint8_t jump = widen_last_jump(ctx);
+    // Case of unconditional jump.
+    if (jump == JumpNear) {
       memref->type = MEMREF_LEA_NEXT;
       memref->code_offset = pc_offset(output(ctx)) - 4;
       memref->unit_idx = node->id;
@@ -464,11 +390,10 @@ update_branch(struct CompilerContext* ctx, struct CFGNode* node,
       memref->target_type = target->type;
       // Target depth is relative depth, need covertion here.
       memref->depth = node->depth - target->depth;
-    } else if ((uint8_t)output(ctx)->data[offset - 5] >= 0x80 &&
-               (uint8_t)output(ctx)->data[offset - 5] <= 0x8f) {
-      // Case of 32-bit jcc
+    } else if (jump == JccNear) {
+      // Case of jcc
       memref->type = MEMREF_LEA_NEXT;
-      memref->code_offset = offset - 4;
+      memref->code_offset = pc_offset(output(ctx)) - 4;
       memref->unit_idx = node->id;
       memref->idx = target->id;
       memref->target_type = target->type;
@@ -506,16 +431,14 @@ update_aslr_branch(struct CompilerContext* ctx, struct CFGNode* node,
   size_t original_offset = memref->code_offset;
 #endif
   // Simply update the relocation entry of the jmp/jcc inserted by pass_caslr.
-  if ((uint8_t)output(ctx)->data[offset - 5] == 0xe9) {
-    output_buf_shrink(output(ctx), 5);
+  condition_t cond;
+  uint8_t jump = drop_last_jump(ctx, &cond);
+  if (jump == JumpNear) {
     // spill_register(ctx, GP_RAX);
     insert_lea(ctx, node, target);
     update_jump_to_springboard(ctx, memref_index, MEMREF_SPRINGBOARD_NEXT,
                                UcondBranch, COND_NONE);
-  } else if ((uint8_t)output(ctx)->data[offset - 5] >= 0x80 &&
-             (uint8_t)output(ctx)->data[offset - 5] <= 0x8f) {
-    condition_t cond = (uint8_t)output(ctx)->data[offset - 5] & 0xf;
-    output_buf_shrink(output(ctx), 6);
+  } else if (jump == JccNear) {
     // spill_register(ctx, GP_RAX);
     insert_lea(ctx, node, target);
     update_jump_to_springboard(ctx, memref_index, MEMREF_SPRINGBOARD_NEXT,
@@ -532,38 +455,6 @@ update_aslr_branch(struct CompilerContext* ctx, struct CFGNode* node,
 }
 
 #if FIX_SIZE_UNIT
-__attribute__((unused)) static void
-update_memref(struct CompilerContext* ctx, size_t start_offset,
-              size_t end_offset)
-{
-  assert(ctx->memrefs != NULL);
-  struct MemoryReferences* memrefs = ctx->memrefs;
-  struct MemoryRef* memref;
-  size_t offset;
-  size_t extra_bytes = JMP_SIZE;
-  size_t i;
-
-  if ((uint8_t)output(ctx)->data[start_offset - 5] == 0xe9) {
-    extra_bytes = 0;
-  }
-
-  for (i = 0; i < memrefs->size; i++) {
-    memref = &memrefs->data[i];
-    offset = memref->code_offset;
-    if (offset >= start_offset && offset < end_offset) {
-#if __DEBUG_TSGX_SPLIT__
-      printf("[update_memref] %zu -> %zu (%u), offset %lx", memref->unit_idx,
-             memref->idx, memref->type, offset);
-#endif
-      memref->code_offset += extra_bytes;
-#if __DEBUG_TSGX_SPLIT__
-      printf(" -> %lx (%lx - %lx)\n", memref->code_offset, start_offset,
-             end_offset);
-#endif
-    }
-  }
-}
-
 // Split unit design
 // Before split:
 // unit n (target: m)
@@ -587,20 +478,21 @@ split_unit(struct CompilerContext* ctx, struct FixSizeCodeUnit* code_unit)
   struct CFGTarget* next_target;
   size_t offset = pc_offset(output(ctx));
   size_t split_offset = offset;
-  uint8_t* buf = NULL;
-  size_t buf_size = 0;
+  size_t split_memref = ctx->memrefs->size;
+  struct CodeTail tail;
   int i;
 
 #if 1 // For debug.
   const struct Function* func = ctx->func;
 
-  if (is_in_whitelist(func->fun_index) != 1) {
+  if (!is_in_whitelist(func)) {
     // Reset the fix_size_unit.
 #if __DEBUG_TSGX__
     plog("[split_unit] skip fun #%zu\n", func->fun_index);
 #endif
     reset_unit(code_unit);
-    add_instr(code_unit, pc_offset(output(ctx)), 0); // Head node.
+    add_instr(code_unit, pc_offset(output(ctx)), 0,
+              ctx->memrefs->size); // Head node.
     return;
   }
 
@@ -658,6 +550,7 @@ if (node->id >= skip_number) {
   for (i = code_unit->size - 1; i >= 0; i--) {
     struct UnitInstr* instr = &code_unit->data[i];
     split_offset = instr->offset;
+    split_memref = instr->memref;
 #if __DEBUG_TSGX_SPLIT__
     plog("Search for split point - size: %zu, offset %lx\n", instr->size,
          instr->offset);
@@ -668,22 +561,13 @@ if (node->id >= skip_number) {
   }
 
   // If the split_offset is smaller than the current offset, we need
-  // to put them into the next unit.
-  if (split_offset < offset) {
-    buf_size = offset - split_offset;
+  // to put them into the next unit. The memory references in them
+  // move along by the size of the jmp actually inserted.
 #if __DEBUG_TSGX_SPLIT__
-    plog("split_offset: %lx, offset: %lx, diff: %zu\n", split_offset, offset,
-         buf_size);
-#endif
-    buf = malloc(buf_size);
-    memset(buf, 0, buf_size);
-    memcpy(buf, (uint8_t*)&output(ctx)->data[split_offset], buf_size);
-    // Extra bytes that we move to the next unit may include
-    // memory references. As a result, we need to upade the offset
-    // of these memory references.
-    update_memref(ctx, split_offset, offset);
-    output_buf_shrink(output(ctx), buf_size);
-  }
+  plog("split_offset: %lx, offset: %lx, diff: %zu\n", split_offset, offset,
+       offset - split_offset);
+#endif
+  take_code_tail(ctx, split_offset, split_memref, &tail);
 
   // Insert jmp.
   insert_jump(ctx, node, target, 0);
@@ -694,9 +578,7 @@ if (node->id >= skip_number) {
   node->size = next_node->offset - node->offset;
 
   // Append the bytes we previously removed.
-  for (i = 0; i < (int)buf_size; i++) {
-    emit(output(ctx), buf[i]);
-  }
+  put_code_tail(ctx, &tail);
   offset = pc_offset(output(ctx));
   // Keep the current size.
   next_node->size = offset - next_node->offset;
@@ -704,12 +586,8 @@ if (node->id >= skip_number) {
 
   // Reset the fix_size_unit.
   reset_unit(code_unit);
-  add_instr(code_unit, next_node->offset, 0); // Head node.
-  add_instr(code_unit, offset, next_node->size);
-
-  if (buf != NULL) {
-    free(buf);
-  }
+  add_instr(code_unit, next_node->offset, 0, tail.first_memref); // Head node.
+  add_instr(code_unit, offset, next_node->size, ctx->memrefs->size);
 }
 #endif
 
@@ -718,13 +596,15 @@ try_patch_target(struct CompilerContext* ctx, struct CFGNode* node)
 {
   assert(ctx->memrefs != NULL);
   struct MemoryReferences* memrefs = ctx->memrefs;
-  size_t i;
+  size_t i, j;
   uint8_t control_state = node->control_state;
   control_type_t control_type = node->control_type;
 
   (void)control_type;
 
-  for (i = 0; i < memrefs->size; i++) {
+  update_pending_jumps(ctx);
+  for (j = 0; j < ctx->pending_jumps.size; j++) {
+    i = ctx->pending_jumps.data[j];
     uint8_t target_type = memrefs->data[i].target_type;
     if (memrefs->data[i].type != MEMREF_LEA_NEXT) {
       continue;
@@ -793,8 +673,8 @@ onFunctionStart(struct CompilerContext* ctx, const struct Function* func)
 #if FIX_SIZE_UNIT
   fix_size_unit_init(&fix_size_unit);
   // Add the head node.
-  add_instr(&fix_size_unit, 0, 0);
-  add_instr(&fix_size_unit, offset, offset);
+  add_instr(&fix_size_unit, 0, 0, 0);
+  add_instr(&fix_size_unit, offset, offset, ctx->memrefs->size);
 
 // For debug.
 // skip_counter = 0;
@@ -803,6 +683,7 @@ onFunctionStart(struct CompilerContext* ctx, const struct Function* func)
   // Reset the br_table_num;
   br_table_num = 0;
 
+  cfg = get_cfg(cfg_pass);
   fun_cfg = NULL;
   for (i = 0; i < cfg->size; i++) {
     struct FunctionCFG* f = &cfg->data[i];
@@ -815,9 +696,7 @@ onFunctionStart(struct CompilerContext* ctx, const struct Function* func)
 
   if (func->name && !strcmp(func->name, "_main")) {
 #if TSX_SUPPORT
-    label_t label = { 0, 0 };
-    bind_label(output(ctx), &label, pc_offset(output(ctx)));
-    emit_xbegin(output(ctx), &label);
+    emit_inline_xbegin(output(ctx), func);
 #endif
   }
 #if 0
@@ -845,7 +724,7 @@ onFunctionEnd(struct CompilerContext* ctx, const struct Function* func)
 
   if (func->name && !strcmp(func->name, "_main")) {
 #if TSX_SUPPORT
-    emit_xend(output(ctx));
+    emit_inline_xend(output(ctx), func);
 #endif
   }
 #if 0
@@ -894,7 +773,7 @@ onControlStart(struct CompilerContext* ctx, const struct Function* func,
   }
 
 #if LOOP_OPT
-  if (is_in_loop_optlist(fun_index)) {
+  if (is_in_loop_optlist(module, fun_index)) {
     if (next_node->control_type == CONTROL_LOOP) {
       split = 1;
     } else {
@@ -903,7 +782,8 @@ onControlStart(struct CompilerContext* ctx, const struct Function* func,
   }
 #endif
 
-  if (is_in_skiplist(fun_index) || is_in_optlist(fun_index)) {
+  if (is_in_skiplist(module, fun_index) ||
+      is_in_optlist(module, fun_index)) {
     split = 0;
   }
 
@@ -924,7 +804,7 @@ onControlStart(struct CompilerContext* ctx, const struct Function* func,
 #if FIX_SIZE_UNIT
   // Reset the unit.
   reset_unit(&fix_size_unit);
-  add_instr(&fix_size_unit, pc_offset(output(ctx)), 0);
+  add_instr(&fix_size_unit, pc_offset(output(ctx)), 0, ctx->memrefs->size);
 
 // For debug.
 // skip_counter++;
@@ -965,7 +845,7 @@ onControlEnd(struct CompilerContext* ctx, const struct Function* func,
   }
 
 #if LOOP_OPT
-  if (is_in_loop_optlist(fun_index)) {
+  if (is_in_loop_optlist(module, fun_index)) {
     if (next_node->control_type == CONTROL_LOOP) {
       split = 1;
     } else {
@@ -974,7 +854,8 @@ onControlEnd(struct CompilerContext* ctx, const struct Function* func,
   }
 #endif
 
-  if (is_in_skiplist(fun_index) || is_in_optlist(fun_index)) {
+  if (is_in_skiplist(module, fun_index) ||
+      is_in_optlist(module, fun_index)) {
     split = 0;
   }
 
@@ -995,7 +876,7 @@ onControlEnd(struct CompilerContext* ctx, const struct Function* func,
 #if FIX_SIZE_UNIT
   // Reset the unit.
   reset_unit(&fix_size_unit);
-  add_instr(&fix_size_unit, pc_offset(output(ctx)), 0);
+  add_instr(&fix_size_unit, pc_offset(output(ctx)), 0, ctx->memrefs->size);
 
 // For debug.
 // skip_counter++;
@@ -1010,6 +891,10 @@ onInstructionStart(struct CompilerContext* ctx, const struct Function* func,
   (void)func;
   (void)instr;
 
+  if (instr->opcode == OPCODE_BR_TABLE) {
+    br_table_memref = ctx->memrefs->size;
+  }
+
   size_t fun_index = func->fun_index;
   const struct Module* module = sgxwasm_get_module(func);
   size_t num_imports = module->n_imported_funcs;
@@ -1017,7 +902,8 @@ onInstructionStart(struct CompilerContext* ctx, const struct Function* func,
     return;
   }
 
-  if (is_in_skiplist(fun_index) || is_in_optlist(fun_index)) {
+  if (is_in_skiplist(module, fun_index) ||
+      is_in_optlist(module, fun_index)) {
     return;
   }
 
@@ -1061,7 +947,8 @@ onInstructionEnd(struct CompilerContext* ctx, const struct Function* func,
     return;
   }
 
-  if (is_in_skiplist(fun_index) || is_in_optlist(fun_index)) {
+  if (is_in_skiplist(module, fun_index) ||
+      is_in_optlist(module, fun_index)) {
     return;
   }
 
@@ -1098,7 +985,7 @@ onInstructionEnd(struct CompilerContext* ctx, const struct Function* func,
 #endif
     split_unit(ctx, &fix_size_unit);
   } else {
-    add_instr(&fix_size_unit, offset, size);
+    add_instr(&fix_size_unit, offset, size, ctx->memrefs->size);
   }
 #endif
 }
@@ -1220,22 +1107,20 @@ onLowBrTable(struct CompilerContext* ctx, const struct MachineInstr* minstr)
   uint8_t type = minstr->type;
 
   if (type == BrTableJmp) {
-    assert((uint8_t)output(ctx)->data[offset - 5] >= 0x80 &&
-           (uint8_t)output(ctx)->data[offset - 5] <= 0x8f);
+    if (widen_last_jump(ctx) != JccNear) {
+      assert(0);
+    }
+    offset = pc_offset(output(ctx));
     memref = new_memref(memrefs);
     memref->type = MEMREF_BR_TABLE_JMP;
     memref->code_offset = offset - 4;
     memref->unit_idx = node->id;
     memref->idx = (br_table_num << 16) | (minstr->max << 8) | minstr->min;
   } else if (type == BrCaseJmp) {
-    if ((uint8_t)output(ctx)->data[offset - 2] == 0xeb) {
-      output(ctx)->data[offset - 2] = 0xe9;
-      emit(output(ctx), 0x00);
-      emit(output(ctx), 0x00);
-      emit(output(ctx), 0x00);
+    if (widen_last_jump(ctx) != JumpNear) {
+      assert(0);
     }
     offset = pc_offset(output(ctx));
-    assert((uint8_t)output(ctx)->data[offset - 5] == 0xe9);
     memref = new_memref(memrefs);
     memref->type = MEMREF_BR_CASE_JMP;
     memref->code_offset = offset - 4;
@@ -1252,7 +1137,8 @@ onLowBrTable(struct CompilerContext* ctx, const struct MachineInstr* minstr)
     size_t id = (br_table_num << 8) | minstr->depth;
     size_t i;
     int found = 0;
-    for (i = 0; i < memrefs->size; i++) {
+    // Only the targets of this br_table can match.
+    for (i = br_table_memref; i < memrefs->size; i++) {
       struct MemoryRef* ref = &memrefs->data[i];
       if (ref->type != MEMREF_BR_CASE_TARGET) {
         continue;
@@ -1304,16 +1190,29 @@ onMachineInstrStart(struct CompilerContext* ctx, const struct Function* func,
     }
     case CallFunction: {
       uint32_t target_index = minstr->fun_index;
-      if (is_in_optlist(fun_index) || is_in_skiplist(fun_index)) {
+      if (is_in_optlist(module, fun_index) ||
+          is_in_skiplist(module, fun_index)) {
         break;
       }
-      if (target_index < num_imports || is_in_skiplist(target_index)) {
+      if (target_index < num_imports ||
+          is_in_skiplist(module, target_index)) {
 #if TSX_SUPPORT
-        emit_xend(output(ctx));
+        emit_inline_xend(output(ctx), func);
 #endif
       }
       break;
     }
+    case CallRuntime: {
+      // The runtime may leave the enclave.
+      if (is_in_optlist(module, fun_index) ||
+          is_in_skiplist(module, fun_index)) {
+        break;
+      }
+#if TSX_SUPPORT
+      emit_inline_xend(output(ctx), func);
+#endif
+      break;
+    }
     default:
       break;
   }
@@ -1333,7 +1232,7 @@ onMachineInstrEnd(struct CompilerContext* ctx, const struct Function* func,
   }
 
 #if LOOP_OPT
-  if (is_in_loop_optlist(fun_index)) {
+  if (is_in_loop_optlist(module, fun_index)) {
     if (node->control_type == CONTROL_LOOP) {
       split = 1;
     } else {
@@ -1343,7 +1242,8 @@ onMachineInstrEnd(struct CompilerContext* ctx, const struct Function* func,
 #endif
 
   // Force not to split.
-  if (is_in_skiplist(fun_index) || is_in_optlist(fun_index)) {
+  if (is_in_skiplist(module, fun_index) ||
+      is_in_optlist(module, fun_index)) {
     split = 0;
   }
 
@@ -1366,18 +1266,28 @@ onMachineInstrEnd(struct CompilerContext* ctx, const struct Function* func,
 #endif
     case CallFunction: {
       uint32_t target_index = minstr->fun_index;
-      if (is_in_optlist(fun_index) || is_in_skiplist(fun_index)) {
+      if (is_in_optlist(module, fun_index) ||
+          is_in_skiplist(module, fun_index)) {
         break;
       }
-      if (target_index < num_imports || is_in_skiplist(target_index)) {
+      if (target_index < num_imports ||
+          is_in_skiplist(module, target_index)) {
 #if TSX_SUPPORT
-        label_t label = { 0, 0 };
-        bind_label(output(ctx), &label, pc_offset(output(ctx)));
-        emit_xbegin(output(ctx), &label);
+        emit_inline_xbegin(output(ctx), func);
 #endif
       }
       break;
     }
+    case CallRuntime: {
+      if (is_in_optlist(module, fun_index) ||
+          is_in_skiplist(module, fun_index)) {
+        break;
+      }
+#if TSX_SUPPORT
+      emit_inline_xbegin(output(ctx), func);
+#endif
+      break;
+    }
   }
 
 #if FIX_SIZE_UNIT
@@ -1411,7 +1321,7 @@ onMachineInstrEnd(struct CompilerContext* ctx, const struct Function* func,
     split_unit(ctx, &fix_size_unit);
 
   } else {
-    add_instr(&fix_size_unit, offset, size);
+    add_instr(&fix_size_unit, offset, size, ctx->memrefs->size);
   }
 #endif
 }
@@ -1469,6 +1379,7 @@ PassInit(struct PassManager* pm)
       break;
     }
     if (strcmp(pass->name, "cfg") == 0) {
+      cfg_pass = pass;
       cfg = get_cfg(pass);
       continue;
     }
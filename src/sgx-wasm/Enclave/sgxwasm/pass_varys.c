@@ -1,5 +1,6 @@
 #include <sgxwasm/pass.h>
 #include <sgxwasm/pass_cfg.h>
+#include <sgxwasm/profile.h>
 
 /*
  Varys scheme:
@@ -26,19 +27,34 @@ static const char* pass_name = "varys";
 #define JMP_SIZE 12
 
 // Global variables.
-static struct ControlFlowGraph* cfg;
-static struct FunctionCFG* fun_cfg;
+// Per-thread state, see parallel.h.
+static struct Pass* cfg_pass;
+static SGXWASM_TLS struct ControlFlowGraph* cfg;
+static SGXWASM_TLS struct FunctionCFG* fun_cfg;
 static int is_caslr_enabled;
 
 // Use to track the number of br_tables.
-static int br_table_num;
+static SGXWASM_TLS int br_table_num;
+// Memory references added since the current br_table started.
+static SGXWASM_TLS size_t br_table_memref;
 
-static uint8_t last_branch;
+static SGXWASM_TLS uint8_t last_branch;
 
 static size_t check_count = 0;
 
 #define LOW_INSTR_FREQ 30
-static size_t low_instr_counter;
+static SGXWASM_TLS size_t low_instr_counter;
+
+// Open loops, for the checks at loop heads (HARDEN_LOOP).
+struct LoopRegion
+{
+  size_t memref; // MEMREF_AEX_COUNT of the check at the loop head.
+  size_t low_instr_offset;
+  size_t inner_low_instrs; // Instructions of the inner loops.
+};
+static SGXWASM_TLS DEFINE_ANON_VECTOR(struct LoopRegion) loop_regions;
+// Instructions of the outermost loops of the function.
+static SGXWASM_TLS size_t loop_low_instrs;
 
 #if FIX_SIZE_UNIT // For fix-sized code units
 #define CODE_UNIT_SIZE 256
@@ -51,16 +67,19 @@ struct FixSizeCodeUnit
   {
     size_t offset;
     size_t size;
+    // Memory references added from here on.
+    size_t memref;
   } * data;
 };
 static DEFINE_VECTOR_GROW(fix_size_unit, struct FixSizeCodeUnit);
 static DEFINE_VECTOR_INIT(fix_size_unit, struct FixSizeCodeUnit);
 static DEFINE_VECTOR_RESIZE(fix_size_unit, struct FixSizeCodeUnit);
 
-struct FixSizeCodeUnit fix_size_unit;
+static SGXWASM_TLS struct FixSizeCodeUnit fix_size_unit;
 
 static void
-add_instr(struct FixSizeCodeUnit* code_unit, size_t offset, size_t size)
+add_instr(struct FixSizeCodeUnit* code_unit, size_t offset, size_t size,
+          size_t memref)
 {
   assert(code_unit != NULL);
   if (!fix_size_unit_grow(code_unit)) {
@@ -69,6 +88,7 @@ add_instr(struct FixSizeCodeUnit* code_unit, size_t offset, size_t size)
   struct UnitInstr* instr = &code_unit->data[code_unit->size - 1];
   instr->offset = offset;
   instr->size = size;
+  instr->memref = memref;
 }
 
 static void
@@ -80,49 +100,25 @@ reset_unit(struct FixSizeCodeUnit* code_unit)
 }
 #endif
 
-#if 1 // For debug.
-/*#define ListSize 27
-static size_t whitelist[ListSize] = { 21, 24, 27, 29, 32, 33, 36, 38, 41,
-                                      42, 43, 52, 53, 54, 55, 56, 59, 61,
-                                      63, 64, 65, 66, 76, 77, 80, 81, 82 };*/
-
-#define ListSize 3
-static size_t whitelist[ListSize] = { 681, 796, 839 };
-// static size_t skip_number = 1174;
-// static size_t skip_counter = 0;
-
+// Per-function policy from the hardening profile (profile.h).
 __attribute__((unused)) static int
-is_in_whitelist(size_t id)
+is_in_whitelist(const struct Function* func)
 {
-  int i;
-  for (i = 0; i < ListSize; i++) {
-    if (id == whitelist[i]) {
-      return 1;
-    }
-  }
-  return 0;
+  return has_hardening(func, HARDEN_UNIT);
 }
-#endif
 
-#define InstrListSize 1
-static size_t instrlist[ListSize] = { 24 }; // PolyBench
-// static size_t skip_number = 1174;
-// static size_t skip_counter = 0;
+// No AEX checks at all.
+static int
+is_in_skiplist(const struct Function* func)
+{
+  return has_hardening(func, HARDEN_SKIP);
+}
 
-__attribute__((unused)) static int
-is_in_instr_list(size_t id)
+// AEX checks at loop heads and at the end of the function only.
+static int
+is_in_optlist(const struct Function* func)
 {
-#if 0 // Enable for PolyBench
-  int i;
-  for (i = 0; i < InstrListSize; i++) {
-    if (id == instrlist[i]) {
-      return 1;
-    }
-  }
-  return 0;
-#else
-  return 1;
-#endif
+  return has_hardening(func, HARDEN_OPT);
 }
 
 // Debug
@@ -165,11 +161,10 @@ jump_to_next_bb(struct CompilerContext* ctx, struct CFGNode* node,
   struct MemoryRef* memref = new_memref(memrefs);
 
   if (is_cond == UcondBranch) {
-    emit_jmp_32(output(ctx), 0);
+    emit_pass_jump(ctx, COND_NONE);
   } else {
     assert(is_cond == CondBranch);
-    label_t label = { 0, 0 };
-    emit_jcc(output(ctx), cond, &label, Far);
+    emit_pass_jump(ctx, cond);
   }
 
   // unit_id will be resolved based on offset (see convert_to_unit_relo_info()).
@@ -189,25 +184,36 @@ jump_to_next_bb(struct CompilerContext* ctx, struct CFGNode* node,
 #endif
 }
 
+// Add low_instr_num to the counter (r14) and poll the SSA once it is
+// past the threshold. If count_memref is not NULL, the count is an imm32
+// to be patched later through the MEMREF_AEX_COUNT stored there.
 __attribute__((unused)) static size_t
-insert_check(struct CompilerContext* ctx, struct CFGNode* node)
+emit_check(struct CompilerContext* ctx, size_t low_instr_num,
+           size_t* count_memref)
 {
-  (void)ctx;
-  (void)node;
 #if 1
   size_t diff = pc_offset(output(ctx));
-  size_t low_instr_num = node->low_instr_num;
 
-  check_count++;
+  __sync_fetch_and_add(&check_count, 1);
   assert(ctx->memrefs != NULL);
   struct MemoryReferences* memrefs = ctx->memrefs;
-  struct MemoryRef* memref = new_memref(memrefs);
+  struct MemoryRef* memref;
   label_t end = { 0, 0 };
   emit_pushfd(output(ctx));
-  emit_add_ri(output(ctx), GP_R14, low_instr_num, VALTYPE_I32);
+  if (count_memref != NULL) {
+    // Force the imm32 form.
+    emit_add_ri(output(ctx), GP_R14, INT32_MAX, VALTYPE_I32);
+    memref = new_memref(memrefs);
+    memref->type = MEMREF_AEX_COUNT;
+    memref->code_offset = pc_offset(output(ctx)) - 4;
+    *count_memref = memrefs->size - 1;
+  } else {
+    emit_add_ri(output(ctx), GP_R14, low_instr_num, VALTYPE_I32);
+  }
   emit_cmp_ri(output(ctx), GP_R14, VARYS_THRESHOLD, VALTYPE_I32);
   emit_jcc(output(ctx), COND_LE_U, &end, Near);
   emit_movq_ri(output(ctx), GP_R15, 0xffffffffffffffff);
+  memref = new_memref(memrefs);
   memref->type = MEMREF_SSA_POLLING;
   memref->code_offset = output(ctx)->size - 8;
   emit_call_r(output(ctx), GP_R15);
@@ -230,26 +236,95 @@ insert_check(struct CompilerContext* ctx, struct CFGNode* node)
 #endif
 }
 
+__attribute__((unused)) static size_t
+insert_check(struct CompilerContext* ctx, struct CFGNode* node)
+{
+  return emit_check(ctx, node->low_instr_num, NULL);
+}
+
+// Loop-level placement (HARDEN_LOOP).
+//
+// Instead of a check every LOW_INSTR_FREQ instructions, there is one at
+// every loop head, which runs on entry and on every back-edge, and one
+// before every return. A loop head adds the instructions of one
+// iteration of the loop body, without its inner loops, which is only
+// known at the end of the loop. A return adds the instructions outside
+// of loops emitted so far; that code only runs forward, so this bounds
+// any path to the return.
+__attribute__((unused)) static int
+has_loop_checks(const struct Function* func)
+{
+  return has_hardening(func, HARDEN_LOOP) && !is_in_skiplist(func) &&
+         !is_in_optlist(func);
+}
+
+__attribute__((unused)) static void
+begin_loop_check(struct CompilerContext* ctx)
+{
+  struct LoopRegion* loop;
+
+  if (!VECTOR_GROW(&loop_regions)) {
+    assert(0);
+  }
+  loop = &loop_regions.data[loop_regions.size - 1];
+  emit_check(ctx, 0, &loop->memref);
+  loop->low_instr_offset = num_low_instrs(ctx);
+  loop->inner_low_instrs = 0;
+}
+
+__attribute__((unused)) static void
+end_loop_check(struct CompilerContext* ctx)
+{
+  struct LoopRegion* loop;
+  struct MemoryRef* memref;
+  size_t low_instr_num;
+
+  assert(loop_regions.size > 0);
+  loop = &loop_regions.data[loop_regions.size - 1];
+  memref = &ctx->memrefs->data[loop->memref];
+  assert(memref->type == MEMREF_AEX_COUNT);
+  low_instr_num = num_low_instrs(ctx) - loop->low_instr_offset;
+  encode_le_uint32_t(low_instr_num - loop->inner_low_instrs,
+                     &output(ctx)->data[memref->code_offset]);
+#if __DEBUG_VARYS__
+  plog("[end_loop_check] offset: %lx, low_instr_num: %zu\n",
+       memref->code_offset, low_instr_num - loop->inner_low_instrs);
+#endif
+  loop_regions.size--;
+  if (loop_regions.size > 0) {
+    loop_regions.data[loop_regions.size - 1].inner_low_instrs += low_instr_num;
+  } else {
+    loop_low_instrs += low_instr_num;
+  }
+}
+
+__attribute__((unused)) static void
+insert_return_check(struct CompilerContext* ctx)
+{
+  size_t low_instr_num = num_low_instrs(ctx) - loop_low_instrs;
+
+  // Returning from inside of loops.
+  if (loop_regions.size > 0) {
+    low_instr_num -=
+      num_low_instrs(ctx) - loop_regions.data[0].low_instr_offset;
+  }
+  emit_check(ctx, low_instr_num, NULL);
+}
+
 __attribute__((unused)) static size_t
 insert_jump(struct CompilerContext* ctx, struct CFGNode* node,
             struct CFGTarget* target)
 {
-  size_t offset = pc_offset(output(ctx));
-  size_t start = offset;
+  const struct MachineInstr* jump = last_jump(ctx);
+  size_t start = pc_offset(output(ctx));
   int end_with_br_if = 0;
 
   // If the last instruction is already jmp, skip.
-  if ((uint8_t)output(ctx)->data[offset - 5] == 0xe9 &&
+  if (jump != NULL && (jump->jump == JumpNear || jump->jump == JumpShort) &&
       last_branch != OPCODE_BR_IF) {
 #if __DEBUG_VARYS__
-    plog("[insert_jump] skip id: %zu, ends with 32-bit jmp\n", node->id);
-#endif
-    end_with_br_if = 1;
-    return 0;
-  } else if ((uint8_t)output(ctx)->data[offset - 2] == 0xeb &&
-             last_branch != OPCODE_BR_IF) {
-#if __DEBUG_VARYS__
-    plog("[insert_jump] skip id: %zu, ends with 8-bit jmp\n", node->id);
+    plog("[insert_jump] skip id: %zu, ends with %s jmp\n", node->id,
+         jump->jump == JumpNear ? "32-bit" : "8-bit");
 #endif
     end_with_br_if = 1;
     return 0;
@@ -267,23 +342,14 @@ __attribute__((unused)) static void
 update_branch(struct CompilerContext* ctx, struct CFGNode* node,
               struct CFGTarget* target)
 {
+  condition_t cond;
+  uint8_t jump = drop_last_jump(ctx, &cond);
 
-  size_t offset = pc_offset(output(ctx));
-
-  // Case of unconditional 32-bit jump.
-  if ((uint8_t)output(ctx)->data[offset - 5] == 0xe9) {
-    output_buf_shrink(output(ctx), 5);
-    // insert_check(ctx, node);
-    jump_to_next_bb(ctx, node, target, MEMREF_JMP_NEXT, UcondBranch, COND_NONE);
-  } else if ((uint8_t)output(ctx)->data[offset - 2] == 0xeb) {
-    // Case of unconditional 8-bit jump.
-    output_buf_shrink(output(ctx), 2);
+  // Case of unconditional jump.
+  if (jump == JumpNear || jump == JumpShort) {
     // insert_check(ctx, node);
     jump_to_next_bb(ctx, node, target, MEMREF_JMP_NEXT, UcondBranch, COND_NONE);
-  } else if ((uint8_t)output(ctx)->data[offset - 5] >= 0x80 &&
-             (uint8_t)output(ctx)->data[offset - 5] <= 0x8f) {
-    condition_t cond = (uint8_t)output(ctx)->data[offset - 5] & 0xf;
-    output_buf_shrink(output(ctx), 6);
+  } else if (jump == JccNear || jump == JccShort) {
     // insert_check(ctx, node);
     jump_to_next_bb(ctx, node, target, MEMREF_JMP_NEXT, CondBranch, cond);
 #if 0
@@ -299,38 +365,6 @@ update_branch(struct CompilerContext* ctx, struct CFGNode* node,
 }
 
 #if FIX_SIZE_UNIT
-__attribute__((unused)) static void
-update_memref(struct CompilerContext* ctx, size_t start_offset,
-              size_t end_offset)
-{
-  assert(ctx->memrefs != NULL);
-  struct MemoryReferences* memrefs = ctx->memrefs;
-  struct MemoryRef* memref;
-  size_t offset;
-  size_t extra_bytes = JMP_SIZE;
-  size_t i;
-
-  if ((uint8_t)output(ctx)->data[start_offset - 5] == 0xe9) {
-    extra_bytes = 0;
-  }
-
-  for (i = 0; i < memrefs->size; i++) {
-    memref = &memrefs->data[i];
-    offset = memref->code_offset;
-    if (offset >= start_offset && offset < end_offset) {
-#if __DEBUG_VARYS_SPLIT__
-      printf("[update_memref] %zu -> %zu (%u), offset %lx", memref->unit_idx,
-             memref->idx, memref->type, offset);
-#endif
-      memref->code_offset += extra_bytes;
-#if __DEBUG_VARYS_SPLIT__
-      printf(" -> %lx (%lx - %lx)\n", memref->code_offset, start_offset,
-             end_offset);
-#endif
-    }
-  }
-}
-
 // Split unit design
 // Before split:
 // unit n (target: m)
@@ -354,21 +388,21 @@ split_unit(struct CompilerContext* ctx, struct FixSizeCodeUnit* code_unit)
   struct CFGTarget* next_target;
   size_t offset = pc_offset(output(ctx));
   size_t split_offset = offset;
-  uint8_t* buf = NULL;
-  size_t buf_size = 0;
+  size_t split_memref = ctx->memrefs->size;
+  struct CodeTail tail;
   int i;
-  int extra_bytes = 0;
 
 #if 1 // For debug.
   const struct Function* func = ctx->func;
 
-  if (is_in_whitelist(func->fun_index) != 1) {
+  if (!is_in_whitelist(func)) {
     // Reset the fix_size_unit.
 #if __DEBUG_VARYS__
     plog("[split_unit] skip fun #%zu\n", func->fun_index);
 #endif
     reset_unit(code_unit);
-    add_instr(code_unit, pc_offset(output(ctx)), 0); // Head node.
+    add_instr(code_unit, pc_offset(output(ctx)), 0,
+              ctx->memrefs->size); // Head node.
     return;
   }
 
@@ -426,6 +460,7 @@ if (node->id >= skip_number) {
   for (i = code_unit->size - 1; i >= 0; i--) {
     struct UnitInstr* instr = &code_unit->data[i];
     split_offset = instr->offset;
+    split_memref = instr->memref;
 #if __DEBUG_VARYS_SPLIT__
     plog("Search for split point - size: %zu, offset %lx\n", instr->size,
          instr->offset);
@@ -436,25 +471,16 @@ if (node->id >= skip_number) {
   }
 
   // If the split_offset is smaller than the current offset, we need
-  // to put them into the next unit.
-  if (split_offset < offset) {
-    buf_size = offset - split_offset;
+  // to put them into the next unit. The memory references in them
+  // move along by the size of the jmp actually inserted.
 #if __DEBUG_VARYS_SPLIT__
-    plog("split_offset: %lx, offset: %lx, diff: %zu\n", split_offset, offset,
-         buf_size);
+  plog("split_offset: %lx, offset: %lx, diff: %zu\n", split_offset, offset,
+       offset - split_offset);
 #endif
-    buf = malloc(buf_size);
-    memset(buf, 0, buf_size);
-    memcpy(buf, (uint8_t*)&output(ctx)->data[split_offset], buf_size);
-    // Extra bytes that we move to the next unit may include
-    // memory references. As a result, we need to upade the offset
-    // of these memory references.
-    update_memref(ctx, split_offset, offset);
-    output_buf_shrink(output(ctx), buf_size);
-  }
+  take_code_tail(ctx, split_offset, split_memref, &tail);
 
   // Insert jmp.
-  extra_bytes = insert_jump(ctx, node, target);
+  insert_jump(ctx, node, target);
 
   // Update the offset for the next node.
   next_node->offset = pc_offset(output(ctx));
@@ -462,9 +488,7 @@ if (node->id >= skip_number) {
   node->size = next_node->offset - node->offset;
 
   // Append the bytes we previously removed.
-  for (i = 0; i < (int)buf_size; i++) {
-    emit(output(ctx), buf[i]);
-  }
+  put_code_tail(ctx, &tail);
   offset = pc_offset(output(ctx));
   // Keep the current size.
   next_node->size = offset - next_node->offset;
@@ -472,12 +496,8 @@ if (node->id >= skip_number) {
 
   // Reset the fix_size_unit.
   reset_unit(code_unit);
-  add_instr(code_unit, next_node->offset, 0); // Head node.
-  add_instr(code_unit, offset, next_node->size);
-
-  if (buf != NULL) {
-    free(buf);
-  }
+  add_instr(code_unit, next_node->offset, 0, tail.first_memref); // Head node.
+  add_instr(code_unit, offset, next_node->size, ctx->memrefs->size);
 }
 #endif
 
@@ -524,13 +544,15 @@ try_patch_target(struct CompilerContext* ctx, struct CFGNode* node)
 {
   assert(ctx->memrefs != NULL);
   struct MemoryReferences* memrefs = ctx->memrefs;
-  size_t i;
+  size_t i, j;
   uint8_t control_state = node->control_state;
   control_type_t control_type = node->control_type;
 
   (void)control_type;
 
-  for (i = 0; i < memrefs->size; i++) {
+  update_pending_jumps(ctx);
+  for (j = 0; j < ctx->pending_jumps.size; j++) {
+    i = ctx->pending_jumps.data[j];
     uint8_t target_type = memrefs->data[i].target_type;
     if (memrefs->data[i].type != MEMREF_JMP_NEXT) {
       continue;
@@ -598,8 +620,8 @@ onFunctionStart(struct CompilerContext* ctx, const struct Function* func)
 #if FIX_SIZE_UNIT
   fix_size_unit_init(&fix_size_unit);
   // Add the head node.
-  add_instr(&fix_size_unit, 0, 0);
-  add_instr(&fix_size_unit, offset, offset);
+  add_instr(&fix_size_unit, 0, 0, 0);
+  add_instr(&fix_size_unit, offset, offset, ctx->memrefs->size);
 
 // For debug.
 // skip_counter = 0;
@@ -610,7 +632,10 @@ onFunctionStart(struct CompilerContext* ctx, const struct Function* func)
 
   // Reset the low_instr_counter.
   low_instr_counter = 0;
+  loop_regions.size = 0;
+  loop_low_instrs = 0;
 
+  cfg = get_cfg(cfg_pass);
   fun_cfg = NULL;
   for (i = 0; i < cfg->size; i++) {
     struct FunctionCFG* f = &cfg->data[i];
@@ -630,7 +655,8 @@ onFunctionEnd(struct CompilerContext* ctx, const struct Function* func)
   (void)func;
 
 #if 1
-  if (is_in_instr_list(func->fun_index)) {
+  // Otherwise the return is checked, see onMachineInstrStart.
+  if (!is_in_skiplist(func) && !has_loop_checks(func)) {
     struct CFGNode* node = &fun_cfg->data[fun_cfg->size - 1];
     insert_check(ctx, node);
   }
@@ -649,7 +675,6 @@ onControlStart(struct CompilerContext* ctx, const struct Function* func,
   size_t size = node->size;
   size_t extra_bytes = 0;
   size_t low_instr_num;
-  size_t fun_index = func->fun_index;
 
   (void)control_type;
   (void)depth;
@@ -664,8 +689,12 @@ onControlStart(struct CompilerContext* ctx, const struct Function* func,
   try_patch_target(ctx, next_node);
 
   low_instr_num = num_low_instrs(ctx);
-  if (next_node->control_type == CONTROL_LOOP) {
-    if (is_in_instr_list(fun_index)) {
+  if (has_loop_checks(func)) {
+    if (next_node->control_type == CONTROL_LOOP) {
+      begin_loop_check(ctx);
+    }
+  } else if (next_node->control_type == CONTROL_LOOP) {
+    if (!is_in_skiplist(func)) {
       insert_check(ctx, node);
     }
     low_instr_counter = low_instr_num;
@@ -674,7 +703,7 @@ onControlStart(struct CompilerContext* ctx, const struct Function* func,
     plog("[insert_check] low_instr_counter: %zu, low_instr_num: %zu\n",
          low_instr_counter, low_instr_num);
 #endif
-    if (is_in_instr_list(fun_index)) {
+    if (!is_in_skiplist(func) && !is_in_optlist(func)) {
       insert_check(ctx, node);
     }
     low_instr_counter = low_instr_num;
@@ -683,7 +712,7 @@ onControlStart(struct CompilerContext* ctx, const struct Function* func,
 #if FIX_SIZE_UNIT
   // Reset the unit.
   reset_unit(&fix_size_unit);
-  add_instr(&fix_size_unit, pc_offset(output(ctx)), 0);
+  add_instr(&fix_size_unit, pc_offset(output(ctx)), 0, ctx->memrefs->size);
 
 // For debug.
 // skip_counter++;
@@ -708,6 +737,10 @@ onControlEnd(struct CompilerContext* ctx, const struct Function* func,
 
   assert(node != NULL && next_node != NULL);
 
+  if (control_type == CONTROL_LOOP && has_loop_checks(func)) {
+    end_loop_check(ctx);
+  }
+
   extra_bytes = insert_jump(ctx, node, target);
   node->size = size + extra_bytes;
   next_node->offset = offset + extra_bytes;
@@ -718,7 +751,7 @@ onControlEnd(struct CompilerContext* ctx, const struct Function* func,
 #if FIX_SIZE_UNIT
   // Reset the unit.
   reset_unit(&fix_size_unit);
-  add_instr(&fix_size_unit, pc_offset(output(ctx)), 0);
+  add_instr(&fix_size_unit, pc_offset(output(ctx)), 0, ctx->memrefs->size);
 
 // For debug.
 // skip_counter++;
@@ -733,6 +766,10 @@ onInstructionStart(struct CompilerContext* ctx, const struct Function* func,
   (void)func;
   (void)instr;
 
+  if (instr->opcode == OPCODE_BR_TABLE) {
+    br_table_memref = ctx->memrefs->size;
+  }
+
 #if FIX_SIZE_UNIT
   // The point is prior to control start & end.
   // Check if requiring spilt based on the current counter.
@@ -808,7 +845,7 @@ onInstructionEnd(struct CompilerContext* ctx, const struct Function* func,
 #endif
     split_unit(ctx, &fix_size_unit);
   } else {
-    add_instr(&fix_size_unit, offset, size);
+    add_instr(&fix_size_unit, offset, size, ctx->memrefs->size);
   }
 #endif
 }
@@ -905,22 +942,20 @@ onLowBrTable(struct CompilerContext* ctx, const struct MachineInstr* minstr)
   uint8_t type = minstr->type;
 
   if (type == BrTableJmp) {
-    assert((uint8_t)output(ctx)->data[offset - 5] >= 0x80 &&
-           (uint8_t)output(ctx)->data[offset - 5] <= 0x8f);
+    if (widen_last_jump(ctx) != JccNear) {
+      assert(0);
+    }
+    offset = pc_offset(output(ctx));
     memref = new_memref(memrefs);
     memref->type = MEMREF_BR_TABLE_JMP;
     memref->code_offset = offset - 4;
     memref->unit_idx = node->id;
     memref->idx = (br_table_num << 16) | (minstr->max << 8) | minstr->min;
   } else if (type == BrCaseJmp) {
-    if ((uint8_t)output(ctx)->data[offset - 2] == 0xeb) {
-      output(ctx)->data[offset - 2] = 0xe9;
-      emit(output(ctx), 0x00);
-      emit(output(ctx), 0x00);
-      emit(output(ctx), 0x00);
+    if (widen_last_jump(ctx) != JumpNear) {
+      assert(0);
     }
     offset = pc_offset(output(ctx));
-    assert((uint8_t)output(ctx)->data[offset - 5] == 0xe9);
     memref = new_memref(memrefs);
     memref->type = MEMREF_BR_CASE_JMP;
     memref->code_offset = offset - 4;
@@ -937,7 +972,8 @@ onLowBrTable(struct CompilerContext* ctx, const struct MachineInstr* minstr)
     size_t id = (br_table_num << 8) | minstr->depth;
     size_t i;
     int found = 0;
-    for (i = 0; i < memrefs->size; i++) {
+    // Only the targets of this br_table can match.
+    for (i = br_table_memref; i < memrefs->size; i++) {
       struct MemoryRef* ref = &memrefs->data[i];
       if (ref->type != MEMREF_BR_CASE_TARGET) {
         continue;
@@ -987,6 +1023,12 @@ onMachineInstrStart(struct CompilerContext* ctx, const struct Function* func,
       minstr->label->pos = -1;
       break;
     }
+    case Return: {
+      if (has_loop_checks(func)) {
+        insert_return_check(ctx);
+      }
+      break;
+    }
 
     default:
       break;
@@ -1055,7 +1097,7 @@ onMachineInstrEnd(struct CompilerContext* ctx, const struct Function* func,
     split_unit(ctx, &fix_size_unit);
 
   } else {
-    add_instr(&fix_size_unit, offset, size);
+    add_instr(&fix_size_unit, offset, size, ctx->memrefs->size);
   }
 #endif
 }
@@ -1136,6 +1178,7 @@ PassInit(struct PassManager* pm)
       break;
     }
     if (strcmp(pass->name, "cfg") == 0) {
+      cfg_pass = pass;
       cfg = get_cfg(pass);
       continue;
     }
@@ -0,0 +1,383 @@
+#include <sgxwasm/profile.h>
+#include <sgxwasm/util.h>
+
+#include <stdarg.h>
+
+static struct FunctionProfile unattributed;
+uint64_t* sgxwasm_profile_abort_slot = &unattributed.aborts;
+
+static const struct
+{
+  const char* name;
+  unsigned flag;
+} policy_names[] = {
+  { "skip", HARDEN_SKIP },
+  { "opt", HARDEN_OPT },
+  { "loop", HARDEN_LOOP },
+  { "unit", HARDEN_UNIT },
+};
+
+#define N_POLICY_NAMES (sizeof(policy_names) / sizeof(policy_names[0]))
+
+void
+sgxwasm_profile_init(struct HardeningProfile* profile)
+{
+  VECTOR_INIT(&profile->entries);
+  profile->n_named = 0;
+}
+
+void
+sgxwasm_profile_free(struct HardeningProfile* profile)
+{
+  size_t i;
+  for (i = 0; i < profile->entries.size; i++) {
+    free(profile->entries.data[i].name);
+  }
+  free(profile->entries.data);
+  sgxwasm_profile_init(profile);
+}
+
+static int
+is_space(char c)
+{
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+static int
+parse_policy(const char* p, size_t len, unsigned* hardening)
+{
+  size_t i;
+  *hardening = 0;
+  if (len == 4 && !strncmp(p, "full", 4)) {
+    return 1;
+  }
+  while (len > 0) {
+    size_t n = 0;
+    while (n < len && p[n] != ',') {
+      n++;
+    }
+    for (i = 0; i < N_POLICY_NAMES; i++) {
+      if (strlen(policy_names[i].name) == n &&
+          !strncmp(p, policy_names[i].name, n)) {
+        *hardening |= policy_names[i].flag;
+        break;
+      }
+    }
+    if (i == N_POLICY_NAMES) {
+      return 0;
+    }
+    if (n < len) {
+      n++; // ','
+    }
+    p += n;
+    len -= n;
+  }
+  return 1;
+}
+
+// Parse one line: key, optional counters, policy.
+static int
+parse_line(struct HardeningProfile* profile, const char* p, size_t len)
+{
+  const char* tokens[8];
+  size_t lengths[8];
+  size_t n_tokens = 0;
+  size_t i = 0;
+  struct ProfileEntry entry;
+
+  while (i < len) {
+    while (i < len && is_space(p[i])) {
+      i++;
+    }
+    if (i == len || p[i] == '#') {
+      break;
+    }
+    if (n_tokens == 8) {
+      return 0;
+    }
+    tokens[n_tokens] = &p[i];
+    while (i < len && !is_space(p[i])) {
+      i++;
+    }
+    lengths[n_tokens] = &p[i] - tokens[n_tokens];
+    n_tokens++;
+  }
+
+  if (n_tokens == 0) {
+    return 1; // Blank line or comment.
+  }
+  if (n_tokens < 2) {
+    return 0;
+  }
+
+  if (!parse_policy(tokens[n_tokens - 1], lengths[n_tokens - 1],
+                    &entry.hardening)) {
+    return 0;
+  }
+
+  if (lengths[0] > 5 && !strncmp(tokens[0], "name:", 5)) {
+    size_t name_length = lengths[0] - 5;
+    entry.name = malloc(name_length + 1);
+    if (!entry.name) {
+      return 0;
+    }
+    memcpy(entry.name, tokens[0] + 5, name_length);
+    entry.name[name_length] = '\0';
+    entry.hash = 0;
+  } else if (lengths[0] > 5 && lengths[0] <= 5 + 16 &&
+             !strncmp(tokens[0], "hash:", 5)) {
+    char hex[17];
+    char* end;
+    memcpy(hex, tokens[0] + 5, lengths[0] - 5);
+    hex[lengths[0] - 5] = '\0';
+    entry.name = NULL;
+    entry.hash = strtoull(hex, &end, 16);
+    if (*end != '\0') {
+      return 0;
+    }
+  } else {
+    return 0;
+  }
+
+  if (!VECTOR_GROW(&profile->entries)) {
+    free(entry.name);
+    return 0;
+  }
+  profile->entries.data[profile->entries.size - 1] = entry;
+  if (entry.name) {
+    profile->n_named++;
+  }
+  return 1;
+}
+
+static int
+compare_entries(const void* a, const void* b)
+{
+  const struct ProfileEntry* x = a;
+  const struct ProfileEntry* y = b;
+  if (x->name && y->name) {
+    return strcmp(x->name, y->name);
+  }
+  if (x->name || y->name) {
+    return x->name ? -1 : 1;
+  }
+  return x->hash < y->hash ? -1 : x->hash > y->hash;
+}
+
+int
+sgxwasm_profile_parse(struct HardeningProfile* profile, const char* buf,
+                      size_t size)
+{
+  size_t start = 0, end;
+
+  while (start < size) {
+    end = start;
+    while (end < size && buf[end] != '\n') {
+      end++;
+    }
+    if (!parse_line(profile, &buf[start], end - start)) {
+      return 0;
+    }
+    start = end + 1;
+  }
+
+  qsort(profile->entries.data, profile->entries.size,
+        sizeof(struct ProfileEntry), compare_entries);
+  return 1;
+}
+
+int
+sgxwasm_profile_load(struct HardeningProfile* profile, const char* path)
+{
+  char* buf;
+  size_t size;
+  int ret;
+
+  buf = sgxwasm_load_file(path, &size);
+  if (!buf) {
+    return 0;
+  }
+  ret = sgxwasm_profile_parse(profile, buf, size);
+  sgxwasm_unload_file(buf, size);
+  if (!ret) {
+    sgxwasm_profile_free(profile);
+  }
+  return ret;
+}
+
+unsigned
+sgxwasm_profile_lookup(const struct HardeningProfile* profile,
+                       const char* name, uint64_t hash)
+{
+  struct ProfileEntry key;
+  const struct ProfileEntry* entry = NULL;
+
+  if (!profile) {
+    return HARDEN_DEFAULT;
+  }
+
+  if (name) {
+    key.name = (char*)name;
+    entry = bsearch(&key, profile->entries.data, profile->n_named,
+                    sizeof(struct ProfileEntry), compare_entries);
+  }
+  if (!entry) {
+    key.name = NULL;
+    key.hash = hash;
+    entry = bsearch(&key, profile->entries.data + profile->n_named,
+                    profile->entries.size - profile->n_named,
+                    sizeof(struct ProfileEntry), compare_entries);
+  }
+  return entry ? entry->hardening : HARDEN_DEFAULT;
+}
+
+// Transaction granularities, from coarse to fine.
+static const unsigned granularities[] = {
+  HARDEN_OPT,
+  HARDEN_LOOP,
+  0,
+#if FIX_SIZE_UNIT
+  HARDEN_UNIT,
+#endif
+};
+
+#define N_GRANULARITIES (sizeof(granularities) / sizeof(granularities[0]))
+#define GRANULARITY_MASK (HARDEN_OPT | HARDEN_LOOP | HARDEN_UNIT)
+
+static size_t
+granularity_level(unsigned hardening)
+{
+  size_t i;
+  for (i = 0; i < N_GRANULARITIES; i++) {
+    if ((hardening & GRANULARITY_MASK) == granularities[i]) {
+      return i;
+    }
+  }
+  return 2; // Mixed flags are taken as full.
+}
+
+static unsigned
+derive_policy(const struct Function* func)
+{
+  const struct FunctionProfile* counters = &func->profile;
+  uint64_t transactions = counters->aborts + counters->commits;
+  size_t level;
+
+  // Not run: keep the policy it was loaded with.
+  if (counters->calls == 0) {
+    return func->hardening;
+  }
+  // Transactions of this function rarely commit.
+  if (counters->aborts * 100 >=
+      counters->calls * PROFILE_SKIP_ABORT_RATE) {
+    return HARDEN_SKIP;
+  }
+  if (has_hardening(func, HARDEN_SKIP)) {
+    return func->hardening;
+  }
+
+  level = granularity_level(func->hardening);
+  if (counters->aborts > 0 &&
+      counters->aborts * 100 >= transactions * PROFILE_SPLIT_ABORT_RATE) {
+    // Transactions are too large: split them.
+    if (level + 1 < N_GRANULARITIES) {
+      level++;
+    }
+  } else if (counters->aborts == 0 && counters->commits > 0 &&
+             counters->commits >= counters->calls * PROFILE_MERGE_COMMITS) {
+    // Many short transactions that always commit: merge them.
+    if (level > 0) {
+      level--;
+    }
+  } else if (counters->aborts == 0 && counters->calls >= PROFILE_OPT_CALLS &&
+             counters->blocks <= counters->calls * PROFILE_OPT_BLOCKS) {
+    // Hot and short: the per-block overhead dominates.
+    level = 0;
+  }
+  return (func->hardening & ~GRANULARITY_MASK) | granularities[level];
+}
+static void
+policy_string(unsigned hardening, char* buf, size_t size)
+{
+  size_t i, len = 0;
+  buf[0] = '\0';
+  for (i = 0; i < N_POLICY_NAMES; i++) {
+    if (hardening & policy_names[i].flag) {
+      len += snprintf(buf + len, size - len, "%s%s", len ? "," : "",
+                      policy_names[i].name);
+    }
+  }
+  if (len == 0) {
+    snprintf(buf, size, "full");
+  }
+}
+
+// Append to buf like snprintf, keeping the full length in *len.
+static void
+append(char* buf, size_t size, size_t* len, const char* fmt, ...)
+{
+  va_list ap;
+  int n;
+
+  va_start(ap, fmt);
+  n = vsnprintf(*len < size ? buf + *len : NULL,
+                *len < size ? size - *len : 0, fmt, ap);
+  va_end(ap);
+  if (n > 0) {
+    *len += n;
+  }
+}
+
+size_t
+sgxwasm_profile_format(const struct Module* module, char* buf, size_t size)
+{
+  size_t i, len = 0;
+  char policy[32];
+
+  if (size > 0) {
+    buf[0] = '\0';
+  }
+  append(buf, size, &len, "# key\tcalls\tblocks\taborts\tcommits\tpolicy\n");
+  for (i = module->n_imported_funcs; i < module->funcs.size; i++) {
+    const struct Function* func = module->funcs.data[i];
+    const struct FunctionProfile* counters = &func->profile;
+    policy_string(derive_policy(func), policy, sizeof(policy));
+    if (func->name) {
+      append(buf, size, &len, "name:%s", func->name);
+    } else {
+      append(buf, size, &len, "hash:%016llx", (unsigned long long)func->hash);
+    }
+    append(buf, size, &len, "\t%llu\t%llu\t%llu\t%llu\t%s\n",
+           (unsigned long long)counters->calls,
+           (unsigned long long)counters->blocks,
+           (unsigned long long)counters->aborts,
+           (unsigned long long)counters->commits, policy);
+  }
+  return len;
+}
+
+int
+sgxwasm_profile_dump(const struct Module* module, const char* path)
+{
+  FILE* f;
+  char* buf;
+  size_t len;
+  int ret;
+
+  len = sgxwasm_profile_format(module, NULL, 0);
+  buf = malloc(len + 1);
+  if (!buf) {
+    return 0;
+  }
+  sgxwasm_profile_format(module, buf, len + 1);
+
+  f = fopen(path, "w");
+  if (!f) {
+    free(buf);
+    return 0;
+  }
+  ret = fwrite(buf, 1, len, f) == len;
+  fclose(f);
+  free(buf);
+  return ret;
+}
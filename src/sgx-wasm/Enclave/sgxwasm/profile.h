@@ -0,0 +1,94 @@
+#ifndef __SGXWASM__PROFILE_H__
+#define __SGXWASM__PROFILE_H__
+
+#include <sgxwasm/config.h>
+#include <sgxwasm/runtime.h>
+#include <sgxwasm/sys.h>
+#include <sgxwasm/vector.h>
+
+// Hardening profile.
+//
+// Selects per function how much instrumentation the passes add. The
+// profile is a text file with one function per line:
+//
+//   # key                  calls   blocks  aborts  commits policy
+//   name:_malloc           1200    98000   812     3100    skip
+//   hash:5d1c0f3e8a2b4c71  40000   80000   0       40000   opt
+//
+// A function is matched by export name or by the hash of its body
+// (for functions that are not exported). Counters are informational;
+// only the key and the policy are used by the loader. The policy is a
+// comma-separated list of the flags below, or "full" for none of them.
+// Functions without an entry get HARDEN_DEFAULT.
+//
+// __PROFILE__ builds write such a file with the counters collected at
+// runtime and a policy derived from them, which can be edited by hand.
+// The derived policy starts from the one the function ran with, and
+// moves its T-SGX transactions one step finer (opt, loop, full, unit)
+// when they abort often, or one step coarser when they always commit
+// and commit many times per call. Loading the module again with the
+// new profile recompiles and places the code accordingly, so a few
+// profiled runs settle each function on the granularity its workload
+// fits.
+
+// T-SGX: no transactions in the function; callers close theirs around
+// calls to it. Varys: no AEX checks.
+#define HARDEN_SKIP 0x1
+// T-SGX: a single transaction for the whole function. Varys: checks
+// only at loop heads and at the end of the function.
+#define HARDEN_OPT 0x2
+// T-SGX: split transactions at loop heads only. Varys: checks only at
+// loop heads and returns, each counting its whole region.
+#define HARDEN_LOOP 0x4
+// Split into fixed-size code units (FIX_SIZE_UNIT).
+#define HARDEN_UNIT 0x8
+
+#define HARDEN_DEFAULT HARDEN_LOOP
+
+#define has_hardening(func, flag) (((func)->hardening & (flag)) != 0)
+
+struct ProfileEntry
+{
+  char* name; // NULL for entries matched by hash.
+  uint64_t hash;
+  unsigned hardening;
+};
+
+// Entries matched by name come first, each group is sorted.
+struct HardeningProfile
+{
+  DEFINE_ANON_VECTOR(struct ProfileEntry) entries;
+  size_t n_named;
+};
+
+void
+sgxwasm_profile_init(struct HardeningProfile*);
+void
+sgxwasm_profile_free(struct HardeningProfile*);
+
+// Returns 0 if there is no valid profile at path.
+int
+sgxwasm_profile_load(struct HardeningProfile*, const char* path);
+int
+sgxwasm_profile_parse(struct HardeningProfile*, const char*, size_t);
+
+unsigned
+sgxwasm_profile_lookup(const struct HardeningProfile*, const char* name,
+                       uint64_t hash);
+
+// Write the counters of the defined functions of module.
+int
+sgxwasm_profile_dump(const struct Module*, const char* path);
+
+// Format the file sgxwasm_profile_dump() writes into buf, truncated to
+// size. Returns its full length, like snprintf.
+size_t
+sgxwasm_profile_format(const struct Module*, char* buf, size_t size);
+
+// Counter of T-SGX aborts of the running function, bumped by the
+// springboard. Its commits are counted in the field after it. The
+// transactions pass_tsgx.c begins and ends inline count into the
+// function directly.
+extern uint64_t* sgxwasm_profile_abort_slot;
+
+#endif
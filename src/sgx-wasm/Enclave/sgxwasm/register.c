@@ -15,7 +15,7 @@ sgxwasm_register_t FPParemterList[FPRegisterParameterNum] = {
   FP_XMM0, FP_XMM1, FP_XMM2, FP_XMM3, FP_XMM4, FP_XMM5, FP_XMM6, FP_XMM7
 };
 
-static reglist_t AllocableRegList = 0;
+static SGXWASM_TLS reglist_t AllocableRegList = 0;
 void
 init_allocable_reg_list()
 {
@@ -25,11 +25,12 @@ init_allocable_reg_list()
   set(&AllocableRegList, ScratchFP2);
 
   // Callee-saved registers.
+  // RBX doubles as MemBaseReg with __PIN_MEM_BASE__.
   set(&AllocableRegList, GP_RBX);
   set(&AllocableRegList, GP_RBP);
   set(&AllocableRegList, GP_RSP);
 
-  // For ASLR & T-SGX.
+  // For ASLR & T-SGX. R14 doubles as PredicateReg with LSPECTRE_MASK.
   set(&AllocableRegList, GP_R14);
   set(&AllocableRegList, GP_R15);
 }
@@ -46,6 +46,8 @@ typedef enum REGISTERS sgxwasm_register_t;
 #define ScratchGP GP_R10
 #define ScratchGP2 GP_R11
 #define RootReg GP_R13
+#define MemBaseReg GP_RBX
+#define PredicateReg GP_R14
 #define ScratchFP FP_XMM15
 #define ScratchFP2 FP_XMM14
 
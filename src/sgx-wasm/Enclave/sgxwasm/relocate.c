@@ -1,3 +1,4 @@
+#include <sgxwasm/profile.h>
 #include <sgxwasm/relocate.h>
 
 // Define grow functions.
@@ -135,6 +136,69 @@ add_relo_entry(struct RelocationTable* table,
 #endif
 }
 
+// Address of the code patched by an entry of a function.
+static uint64_t
+entry_addr(struct Entry* entry,
+           struct CodeUnits* unit_list,
+           uint64_t code_base,
+           int use_code_unit)
+{
+  int64_t code_offset;
+  if (use_code_unit) {
+    code_offset = unit_list->data[entry->unit_index].offset;
+  } else {
+    code_offset = unit_list->entry_offset;
+  }
+  return code_base + code_offset + entry->offset;
+}
+
+static int
+compare_entry_target(const void* a, const void* b)
+{
+  const struct Entry* x = *(struct Entry* const*)a;
+  const struct Entry* y = *(struct Entry* const*)b;
+  if (x->target_index != y->target_index) {
+    return x->target_index < y->target_index ? -1 : 1;
+  }
+  return 0;
+}
+
+// The RELO_JUMP_TABLE_CASE entries of a function, sorted by target_index,
+// so that each slot of its jump tables finds its case by binary search.
+static struct Entry**
+index_jump_table_cases(struct RelocationEntries* entries, size_t* size)
+{
+  struct Entry** cases;
+  size_t k;
+  *size = 0;
+  for (k = 0; k < entries->size; k++) {
+    if (entries->data[k].type == RELO_JUMP_TABLE_CASE) {
+      (*size)++;
+    }
+  }
+  cases = malloc(sizeof(*cases) * (*size ? *size : 1));
+  assert(cases != NULL);
+  *size = 0;
+  for (k = 0; k < entries->size; k++) {
+    if (entries->data[k].type == RELO_JUMP_TABLE_CASE) {
+      cases[(*size)++] = &entries->data[k];
+    }
+  }
+  qsort(cases, *size, sizeof(*cases), compare_entry_target);
+  return cases;
+}
+
+static struct Entry*
+find_jump_table_case(struct Entry** cases, size_t size, size_t target_index)
+{
+  struct Entry key;
+  struct Entry* pkey = &key;
+  struct Entry** found;
+  key.target_index = target_index;
+  found = bsearch(&pkey, cases, size, sizeof(*cases), compare_entry_target);
+  return found ? *found : NULL;
+}
+
 void
 relocate(struct Module* module,
          struct RelocationTable* table,
@@ -149,19 +213,14 @@ relocate(struct Module* module,
   for (i = 0; i < table->size; i++) {
     struct RelocationEntries* entries = &table->entries[i];
     struct CodeUnits* unit_list = &code_table->units[i];
+    // Built on the first jump table slot of the function.
+    struct Entry** cases = NULL;
+    size_t n_cases = 0;
     size_t j;
     for (j = 0; j < entries->size; j++) {
       struct Entry* entry = &entries->data[j];
-      struct CodeUnit* unit;
-      int64_t code_offset;
-      uint64_t relo_addr;
-      if (use_code_unit) {
-        unit = &unit_list->data[entry->unit_index];
-        code_offset = unit->offset;
-      } else {
-        code_offset = unit_list->entry_offset;
-      }
-      relo_addr = code_base + code_offset + entry->offset;
+      uint64_t relo_addr =
+        entry_addr(entry, unit_list, code_base, use_code_unit);
       switch (entry->type) {
         case RELO_CALL: {
           size_t target_index = entry->target_index; // Function index.
@@ -179,6 +238,29 @@ relocate(struct Module* module,
                  relo_addr,
                  target_val);
 #endif
+#endif
+          break;
+        }
+        case RELO_CALL_REL: {
+          const uint32_t call_offset = 4;
+          size_t target_index = entry->target_index; // Function index.
+          assert(target_index < table->size);
+          int64_t target_offset = code_table->units[target_index].entry_offset;
+          // Target calculation: target address - current address - offset
+          int64_t target_val =
+            (int64_t)(code_base + target_offset - relo_addr - call_offset);
+          assert(target_val == (int32_t)target_val);
+          encode_le_uint32_t((uint32_t)target_val, (char*)relo_addr);
+#if DEBUG_RELOCATE
+#if __linux__
+          printf("[relocate_call_rel] addr 0x%lx <- target_val 0x%lx\n",
+                 relo_addr,
+                 target_val);
+#else
+          printf("[relocate_call_rel] addr 0x%llx <- target_val 0x%llx\n",
+                 relo_addr,
+                 target_val);
+#endif
 #endif
           break;
         }
@@ -200,6 +282,28 @@ relocate(struct Module* module,
 #endif
           break;
         }
+        case RELO_MEMORY: {
+          size_t target_index = entry->target_index;
+          uint64_t target_val = (uintptr_t)module->mems.data[target_index];
+          encode_le_uint64_t(target_val, (char*)relo_addr);
+#if DEBUG_RELOCATE
+#if __linux__
+          printf("[relocate_memory] addr 0x%lx <- target_val 0x%lx\n",
+                 relo_addr,
+                 target_val);
+#else
+          printf("[relocate_memory] addr 0x%llx <- target_val 0x%llx\n",
+                 relo_addr,
+                 target_val);
+#endif
+#endif
+          break;
+        }
+        case RELO_MEMORY_GROW: {
+          uint64_t target_val = (uintptr_t)sgxwasm_memory_grow;
+          encode_le_uint64_t(target_val, (char*)relo_addr);
+          break;
+        }
         case RELO_GLOBAL: {
           size_t target_index = entry->target_index;
           uint64_t target_val =
@@ -395,6 +499,42 @@ relocate(struct Module* module,
                  relo_addr,
                  ssa_polling_addr);
 #endif
+#endif
+          break;
+        }
+        case RELO_JUMP_TABLE: {
+          // The table starts with its first slot, added after it.
+          size_t table_id = entry->target_index;
+          struct Entry* slot = NULL;
+          size_t k;
+          for (k = j + 1; k < entries->size; k++) {
+            struct Entry* t = &entries->data[k];
+            if (t->type == RELO_JUMP_TABLE_ENTRY &&
+                (t->target_index >> 32) == (table_id >> 32)) {
+              slot = t;
+              break;
+            }
+          }
+          assert(slot != NULL);
+          uint64_t target_val =
+            entry_addr(slot, unit_list, code_base, use_code_unit);
+          encode_le_uint64_t(target_val, (char*)relo_addr);
+          break;
+        }
+        case RELO_JUMP_TABLE_ENTRY: {
+          if (cases == NULL) {
+            cases = index_jump_table_cases(entries, &n_cases);
+          }
+          struct Entry* target =
+            find_jump_table_case(cases, n_cases, entry->target_index);
+          assert(target != NULL);
+          uint64_t target_val =
+            entry_addr(target, unit_list, code_base, use_code_unit);
+          encode_le_uint64_t(target_val, (char*)relo_addr);
+#if DEBUG_RELOCATE
+          printf("[relocate_jump_table] slot 0x%llx <- case 0x%llx\n",
+                 (unsigned long long)relo_addr,
+                 (unsigned long long)target_val);
 #endif
           break;
         }
@@ -458,6 +598,7 @@ relocate(struct Module* module,
         }
       }
     }
+    free(cases);
   }
 }
 
@@ -473,6 +614,23 @@ DebugSpringboard(uint64_t addr, uint64_t rax)
 #endif
 }
 
+#if __PROFILE__ && TSX_SUPPORT
+// Bump the counter at offset from sgxwasm_profile_abort_slot. Clobbers
+// RAX and R11.
+static void
+emit_slot_counter_inc(struct SizedBuffer* output, int32_t offset)
+{
+  struct Operand op;
+  emit_movq_ri(output, GP_RAX, (uint64_t)&sgxwasm_profile_abort_slot);
+  build_operand(&op, GP_RAX, REG_UNKNOWN, SCALE_NONE, 0);
+  emit_mov_rm(output, GP_RAX, &op, VALTYPE_I64);
+  build_operand(&op, GP_RAX, REG_UNKNOWN, SCALE_NONE, offset);
+  emit_mov_rm(output, GP_R11, &op, VALTYPE_I64);
+  emit_add_ri(output, GP_R11, 1, VALTYPE_I64);
+  emit_mov_mr(output, &op, GP_R11, VALTYPE_I64);
+}
+#endif
+
 // T-SGX Support.
 void
 construct_springboard(struct Springboard* springboard)
@@ -491,12 +649,29 @@ construct_springboard(struct Springboard* springboard)
   // end:
   //     xend
   //     jmp r15
+  //
+  // With __PROFILE__, next counts the commit after its xend and xbegin
+  // falls back to abort instead of begin:
+  //     mov rax, [sgxwasm_profile_abort_slot]
+  //     inc qword [rax + 8] # commits, r11 as temporary
+  // ...
+  // abort:
+  //     mov rax, [sgxwasm_profile_abort_slot]
+  //     inc qword [rax] # aborts, r11 as temporary
+  //     jmp begin
   label_t begin = { 0, 0 };
+#if __PROFILE__ && TSX_SUPPORT
+  label_t abort = { 0, 0 };
+#endif
   springboard->next = pc_offset(&output);
   emit_mov_rr(&output, GP_R14, GP_RAX, VALTYPE_I64);
 #if TSX_SUPPORT
   emit_xend(&output);
 #endif
+#if __PROFILE__ && TSX_SUPPORT
+  emit_slot_counter_inc(&output, offsetof(struct FunctionProfile, commits) -
+                                   offsetof(struct FunctionProfile, aborts));
+#endif
 
 #if TSX_SIMULATE && !TSX_SUPPORT
   label_t label = { 0, 0 };
@@ -516,7 +691,9 @@ construct_springboard(struct Springboard* springboard)
   RestoreRegisterStates(&output);
 #endif
   springboard->begin = pc_offset(&output);
-#if TSX_SUPPORT
+#if __PROFILE__ && TSX_SUPPORT
+  emit_xbegin(&output, &abort);
+#elif TSX_SUPPORT
   emit_xbegin(&output, &begin);
 #endif
   emit_mov_rr(&output, GP_RAX, GP_R14, VALTYPE_I64);
@@ -526,6 +703,11 @@ construct_springboard(struct Springboard* springboard)
   emit_xend(&output);
 #endif
   emit_jmp_r(&output, GP_R15);
+#if __PROFILE__ && TSX_SUPPORT
+  bind_label(&output, &abort, pc_offset(&output));
+  emit_slot_counter_inc(&output, 0);
+  emit_jmp_label(&output, &begin, Far);
+#endif
 
   mapped = sgxwasm_allocate_code(output.size, PageSize, 0);
   memcpy(mapped, output.data, output.size);
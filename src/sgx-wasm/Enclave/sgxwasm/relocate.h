@@ -36,6 +36,12 @@ enum RelocationType
   RELO_BR_TABLE_TARGET = 0x1e,
   RELO_BR_CASE_TARGET = 0x1f,
   RELO_SSA_POLLING = 0x20,
+  RELO_MEMORY = 0x21,
+  RELO_MEMORY_GROW = 0x22,
+  RELO_CALL_REL = 0x23,
+  RELO_JUMP_TABLE = 0x24,
+  RELO_JUMP_TABLE_ENTRY = 0x25,
+  RELO_JUMP_TABLE_CASE = 0x26,
 };
 typedef enum RelocationType relocation_type_t;
 
@@ -101,7 +101,7 @@ sgxwasm_free_module(struct Module* module)
   }
   free(module->tables.data);
   for (i = module->n_imported_mems; i < module->mems.size; ++i) {
-    free(module->mems.data[i]->data);
+    sgxwasm_memory_free(module->mems.data[i]);
     free(module->mems.data[i]);
   }
   free(module->mems.data);
@@ -53,6 +53,15 @@ struct Function
   size_t type_index;
   size_t stack_usage;
   struct FuncType type;
+  uint64_t hash;      // Of the body, see CodeSectionCode.
+  unsigned hardening; // HARDEN_* flags, see profile.h.
+  struct FunctionProfile
+  {
+    uint64_t calls;
+    uint64_t blocks;
+    uint64_t aborts;
+    uint64_t commits; // Follows aborts, see construct_springboard.
+  } profile; // Counters of __PROFILE__ builds.
 };
 
 struct Table
@@ -68,8 +77,14 @@ struct Memory
   char* data;
   size_t size;
   size_t max; /* max of 0 means no max */
+  size_t reserved; /* data never moves while growing up to this */
 };
 
+// With SGXWASM_MEMORY_BOUNDS_CHECK, the size of a memory is also stored
+// right before its data, where the compiled code reads it relative to
+// the base it already holds (see bounds_check_mem).
+#define MEMORY_BOUND_OFFSET (-(int32_t)sizeof(size_t))
+
 struct Global
 {
   struct Value value;
@@ -127,6 +142,21 @@ void sgxwasm_init_code_region(size_t);
 int sgxwasm_commit_code_region();
 uint64_t sgxwasm_get_code_base();
 
+// Usage of the code region, in units of UnitSize.
+struct CodeRegionStats
+{
+  size_t total_units;
+  size_t free_units;
+  size_t n_extents;      // Free runs.
+  size_t largest_extent; // Longest free run.
+  size_t n_allocs;
+  size_t n_rand_allocs;
+  size_t n_rejections;      // Extent picks retried.
+  size_t n_entropy_batches; // Random number refills.
+};
+
+void sgxwasm_code_region_stats(struct CodeRegionStats*);
+
 void
 _sgxwasm_create_func_type(struct FuncType* ft,
                           size_t n_inputs,
@@ -218,6 +248,15 @@ sgxwasm_free_module(struct Module*);
 
 void*
 sgxwasm_allocate_code(size_t, int, int);
+
+// Reserve the range of a memory and commit its first size bytes.
+int
+sgxwasm_memory_init(struct Memory*, size_t size, size_t max);
+void
+sgxwasm_memory_free(struct Memory*);
+// memory.grow: returns the previous size in pages, or -1.
+uint32_t
+sgxwasm_memory_grow(struct Memory*, uint32_t pages);
 int
 sgxwasm_mark_code_segment_executable(void*, size_t);
 int
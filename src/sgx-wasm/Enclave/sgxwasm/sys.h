@@ -56,6 +56,9 @@
 // OSX requires page alignment.
 #define PageSize 0x1000
 
+// Per-thread state of the compiler and passes (see parallel.h).
+#define SGXWASM_TLS __thread
+
 #define I32Size 4
 #define I64Size 8
 #define F32Size 4
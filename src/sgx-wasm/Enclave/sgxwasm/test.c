@@ -5,6 +5,7 @@
 #include <sgxwasm/pass.h>
 #include <sgxwasm/runtime.h>
 #include <sgxwasm/sense.h>
+#include <sgxwasm/timesrc.h>
 #include <sgxwasm/util.h>
 
 #if !__SGX__
@@ -691,24 +692,26 @@ test_ret_f64(void* fun_ptr, double ret, uint64_t* args, uint8_t* args_type,
   }
 }
 
-__attribute__((unused)) static void
-do_spec_test(struct Module* module, const char* fun_name, uint64_t* args,
-             uint8_t* args_type, size_t n_args, uint64_t expected,
-             uint8_t expected_type)
+static struct Function*
+find_spec_function(struct Module* module, const char* fun_name)
 {
   size_t i;
-  struct Function* func = NULL;
 
   for (i = 0; i < module->funcs.size; i++) {
-    func = module->funcs.data[i];
-    if (func->name == NULL) {
-      continue;
+    struct Function* func = module->funcs.data[i];
+    if (func->name != NULL && strcmp(func->name, fun_name) == 0) {
+      return func;
     }
-    if (strcmp(func->name, fun_name) == 0) {
-      break;
-    }
-    func = NULL;
   }
+  return NULL;
+}
+
+__attribute__((unused)) static void
+do_spec_test(struct Module* module, const char* fun_name, uint64_t* args,
+             uint8_t* args_type, size_t n_args, uint64_t expected,
+             uint8_t expected_type)
+{
+  struct Function* func = find_spec_function(module, fun_name);
 
   if (func == NULL) {
     printf("Target function %s not found!\n", fun_name);
@@ -842,11 +845,11 @@ run_wasm_test(const char* filename, uint32_t static_bump, int has_table,
       //#endif
       // int((*fun)(uint32_t, uint32_t)) = func->code;
       int((*fun)()) = func->code;
-      ocall_sgx_rdtsc(&t1);
+      t1 = sgxwasm_cycles();
       // test_i32(fun(5, 6), 11, &count);
       // fun(5, 6);
       fun();
-      ocall_sgx_rdtsc(&t2);
+      t2 = sgxwasm_cycles();
       printf("t: %lu\n", t2 - t1);
     }
   } else if (strcmp(filename, "../../tests/micro_benchmark/sum/sum.wasm") ==
@@ -861,13 +864,13 @@ run_wasm_test(const char* filename, uint32_t static_bump, int has_table,
       //#endif
       int((*fun)(uint32_t, uint32_t)) = func->code;
 
-      ocall_sgx_rdtsc(&t1);
+      t1 = sgxwasm_cycles();
       // test_i32(fun(5, 6), 11, &count);
       for (i = 0; i < 1000000; i++) {
         fun(5, 6);
         // test_sum(5, 6);
       }
-      ocall_sgx_rdtsc(&t2);
+      t2 = sgxwasm_cycles();
       printf("t: %lu\n", t2 - t1);
     }
   } else if (strcmp(filename, "../../tests/micro_benchmark/fib/fib.wasm") ==
@@ -884,13 +887,13 @@ run_wasm_test(const char* filename, uint32_t static_bump, int has_table,
       int((*fun)()) = func->code;
 
       // printf("fib: %d\n", fun(10));
-      ocall_sgx_rdtsc(&t1);
+      t1 = sgxwasm_cycles();
       // test_i32(fun(5, 6), 11, &count);
       for (i = 0; i < 1000000; i++) {
         // fun(10);
         fun();
       }
-      ocall_sgx_rdtsc(&t2);
+      t2 = sgxwasm_cycles();
       printf("t: %lu\n", t2 - t1);
     }
   } else if (strcmp(filename, "../../tests/micro_benchmark/fib/test.wasm") ==
@@ -905,11 +908,11 @@ run_wasm_test(const char* filename, uint32_t static_bump, int has_table,
       //#endif
       int((*fun)()) = func->code;
 
-      ocall_sgx_rdtsc(&t1);
+      t1 = sgxwasm_cycles();
       for (i = 0; i < 1000000; i++) {
         fun();
       }
-      ocall_sgx_rdtsc(&t2);
+      t2 = sgxwasm_cycles();
       printf("t: %lu\n", t2 - t1);
     }
   } else if (strcmp(filename, "../../tests/micro_benchmark/sha/test.wasm") ==
@@ -923,10 +926,10 @@ run_wasm_test(const char* filename, uint32_t static_bump, int has_table,
       //#endif
       int((*fun)()) = func->code;
 
-      ocall_sgx_rdtsc(&t1);
+      t1 = sgxwasm_cycles();
       // test_i32(fun(5, 6), 11, &count);
       fun();
-      ocall_sgx_rdtsc(&t2);
+      t2 = sgxwasm_cycles();
       printf("%lu\n", t2 - t1);
     }
   } else if (strcmp(filename, "../../tests/micro_benchmark/nbody/test.wasm") ==
@@ -940,9 +943,9 @@ run_wasm_test(const char* filename, uint32_t static_bump, int has_table,
       //#endif
       int((*fun)()) = func->code;
 
-      ocall_sgx_rdtsc(&t1);
+      t1 = sgxwasm_cycles();
       fun();
-      ocall_sgx_rdtsc(&t2);
+      t2 = sgxwasm_cycles();
       printf("%lu\n", t2 - t1);
     }
   } else if (strcmp(filename,
@@ -957,9 +960,9 @@ run_wasm_test(const char* filename, uint32_t static_bump, int has_table,
       //#endif
       int((*fun)(uint32_t)) = func->code;
 
-      ocall_sgx_rdtsc(&t1);
+      t1 = sgxwasm_cycles();
       fun(7);
-      ocall_sgx_rdtsc(&t2);
+      t2 = sgxwasm_cycles();
       printf("%lu\n", t2 - t1);
     }
   }
@@ -980,3 +983,369 @@ run_wasm_test(const char* filename, uint32_t static_bump, int has_table,
 
   return ret;
 }
+
+// Batched spec tests.
+//
+// A script holds the assertions of one spec .json file, one per line:
+//
+//   module <path>
+//   assert_return <fun> <n_args> [<arg> <type>]... <expected> <type>
+//   assert_trap <fun> ...
+//   invoke <fun> <n_args> [<arg> <type>]...
+//
+// Values are the bit patterns of the wasm values in decimal and types
+// are 0 (i32), 1 (i64), 2 (f32), 3 (f64), or 4 (no result) for the
+// expected value, which may also be "nan" to accept any NaN. Every
+// module line instantiates a fresh module that the following lines
+// run against, so one call checks a whole script. Traps abort the
+// instance, so assert_trap lines are only counted as skipped.
+
+#define SPEC_TEST_MAX_ARGS 16
+#define SPEC_TEST_MAX_LINE 1024
+
+enum
+{
+  SPEC_TEST_PASS,
+  SPEC_TEST_FAIL,
+  SPEC_TEST_SKIP,
+};
+
+// Integer and float arguments take separate register sequences in the
+// SysV ABI, so this one prototype can call any function with at most
+// six of the former and eight of the latter. f32 values travel in the
+// low half of a double.
+typedef uint64_t (*spec_gp_fun)(uint64_t, uint64_t, uint64_t, uint64_t,
+                                uint64_t, uint64_t, double, double, double,
+                                double, double, double, double, double);
+typedef double (*spec_fp_fun)(uint64_t, uint64_t, uint64_t, uint64_t,
+                              uint64_t, uint64_t, double, double, double,
+                              double, double, double, double, double);
+
+static double
+spec_bits_to_double(uint64_t bits)
+{
+  double d;
+  memcpy(&d, &bits, sizeof(d));
+  return d;
+}
+
+static int
+spec_invoke(struct Function* func, const uint64_t* args,
+            const uint8_t* args_type, size_t n_args, uint8_t ret_type,
+            uint64_t* ret)
+{
+  uint64_t gp[6] = { 0 };
+  double fp[8] = { 0 };
+  size_t n_gp = 0, n_fp = 0, i;
+
+  for (i = 0; i < n_args; i++) {
+    switch (args_type[i]) {
+      case 0:
+      case 1:
+        if (n_gp == 6)
+          return -1;
+        gp[n_gp++] = args_type[i] == 0 ? (uint32_t)args[i] : args[i];
+        break;
+      case 2:
+      case 3:
+        if (n_fp == 8)
+          return -1;
+        fp[n_fp++] = spec_bits_to_double(
+          args_type[i] == 2 ? (uint32_t)args[i] : args[i]);
+        break;
+      default:
+        return -1;
+    }
+  }
+
+  if (ret_type == 2 || ret_type == 3) {
+    spec_fp_fun fun = (spec_fp_fun)func->code;
+    double d = fun(gp[0], gp[1], gp[2], gp[3], gp[4], gp[5], fp[0], fp[1],
+                   fp[2], fp[3], fp[4], fp[5], fp[6], fp[7]);
+    memcpy(ret, &d, sizeof(*ret));
+  } else {
+    spec_gp_fun fun = (spec_gp_fun)func->code;
+    *ret = fun(gp[0], gp[1], gp[2], gp[3], gp[4], gp[5], fp[0], fp[1], fp[2],
+               fp[3], fp[4], fp[5], fp[6], fp[7]);
+  }
+  return 0;
+}
+
+static int
+spec_check(uint64_t ret, uint64_t expected, int expect_nan, uint8_t type)
+{
+  switch (type) {
+    case 0:
+      return (uint32_t)ret == (uint32_t)expected;
+    case 1:
+      return ret == expected;
+    case 2: {
+      uint32_t bits = (uint32_t)ret;
+      if (expect_nan)
+        return (bits & 0x7f800000) == 0x7f800000 && (bits & 0x007fffff);
+      return bits == (uint32_t)expected;
+    }
+    case 3:
+      if (expect_nan)
+        return (ret & 0x7ff0000000000000) == 0x7ff0000000000000 &&
+               (ret & 0x000fffffffffffff);
+      return ret == expected;
+    case 4:
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+// Copy the next blank-separated token of *line into buf.
+static int
+spec_next_token(const char** line, char* buf, size_t size)
+{
+  const char* p = *line;
+  size_t n = 0;
+
+  while (*p == ' ' || *p == '\t')
+    p++;
+  if (*p == '\0')
+    return 0;
+  while (*p != '\0' && *p != ' ' && *p != '\t') {
+    if (n + 1 < size)
+      buf[n++] = *p;
+    p++;
+  }
+  buf[n] = '\0';
+  *line = p;
+  return 1;
+}
+
+static int
+spec_next_value(const char** line, uint64_t* value, int* is_nan)
+{
+  char token[32];
+  char* end;
+
+  if (!spec_next_token(line, token, sizeof(token)))
+    return 0;
+  if (is_nan != NULL) {
+    *is_nan = strcmp(token, "nan") == 0;
+    if (*is_nan) {
+      *value = 0;
+      return 1;
+    }
+  }
+  *value = strtoull(token, &end, 10);
+  return end != token && *end == '\0';
+}
+
+static int
+spec_next_type(const char** line, uint8_t* type)
+{
+  uint64_t value;
+
+  if (!spec_next_value(line, &value, NULL) || value > 4)
+    return 0;
+  *type = (uint8_t)value;
+  return 1;
+}
+
+struct SpecTestModule
+{
+  struct WasmJITHigh high;
+  int high_init;
+  struct Module* module;
+};
+
+static int
+spec_open_module(struct SpecTestModule* self, const char* filename)
+{
+  struct EmscriptenContext ctx;
+  struct PassManager pm;
+  struct SystemConfig sys_config;
+  const char* msg;
+  size_t i;
+
+  emscripten_context_init(&ctx);
+  pass_manager_init(&pm);
+  passes_init(&pm);
+
+  init_system_sensing(&sys_config);
+  system_sensing(&sys_config);
+
+  self->module = NULL;
+  self->high_init = 0;
+  if (sgxwasm_high_init(&self->high)) {
+    msg = "failed to initialize";
+    goto error;
+  }
+  self->high_init = 1;
+
+  if (sgxwasm_high_instantiate_emscripten_runtime(
+        &self->high, &ctx, 6000, 0, 0,
+        SGXWASM_HIGH_INSTANTIATE_EMSCRIPTEN_RUNTIME_FLAGS_NO_TABLE)) {
+    msg = "failed to instantiate emscripten runtime";
+    goto error;
+  }
+
+  if (sgxwasm_high_instantiate(&self->high, &pm, &sys_config, filename,
+                               "asm", 0)) {
+    msg = "failed to instantiate module";
+    goto error;
+  }
+
+  for (i = 0; i < self->high.n_modules; i++) {
+    if (strcmp(self->high.modules[i].name, "asm") == 0) {
+      self->module = self->high.modules[i].module;
+      return 0;
+    }
+  }
+  msg = "module asm not found";
+
+error:
+  printf("%s: %s\n", filename, msg);
+  return -1;
+}
+
+static void
+spec_close_module(struct SpecTestModule* self)
+{
+  if (self->high_init)
+    sgxwasm_high_close(&self->high);
+  self->high_init = 0;
+  self->module = NULL;
+}
+
+static void
+spec_report(const char* filename, const uint64_t* counts)
+{
+  printf("%s: pass=%lu fail=%lu skip=%lu\n", filename,
+         counts[SPEC_TEST_PASS], counts[SPEC_TEST_FAIL],
+         counts[SPEC_TEST_SKIP]);
+}
+
+// Run one script line against the current module and return which
+// count it goes to, or -1 for lines that are not assertions.
+static int
+spec_run_line(struct SpecTestModule* self, const char* line)
+{
+  char command[32], fun_name[256];
+  uint64_t args[SPEC_TEST_MAX_ARGS], n_args, expected = 0, ret;
+  uint8_t args_type[SPEC_TEST_MAX_ARGS], expected_type = 4;
+  int expect_nan = 0, is_return, is_invoke;
+  struct Function* func;
+  size_t i;
+
+  fun_name[0] = '\0';
+  if (!spec_next_token(&line, command, sizeof(command)))
+    return -1;
+  if (strcmp(command, "assert_trap") == 0)
+    return SPEC_TEST_SKIP;
+  is_return = strcmp(command, "assert_return") == 0;
+  is_invoke = strcmp(command, "invoke") == 0;
+  if (!is_return && !is_invoke) {
+    printf("unknown command: %s\n", command);
+    return SPEC_TEST_FAIL;
+  }
+
+  if (!spec_next_token(&line, fun_name, sizeof(fun_name)) ||
+      !spec_next_value(&line, &n_args, NULL) || n_args > SPEC_TEST_MAX_ARGS)
+    goto malformed;
+  for (i = 0; i < n_args; i++) {
+    if (!spec_next_value(&line, &args[i], NULL) ||
+        !spec_next_type(&line, &args_type[i]) || args_type[i] > 3)
+      goto malformed;
+  }
+  if (is_return && (!spec_next_value(&line, &expected, &expect_nan) ||
+                    !spec_next_type(&line, &expected_type)))
+    goto malformed;
+
+  if (self->module == NULL)
+    return is_return ? SPEC_TEST_FAIL : -1;
+
+  func = find_spec_function(self->module, fun_name);
+  if (func == NULL) {
+    printf("Target function %s not found!\n", fun_name);
+    return is_return ? SPEC_TEST_FAIL : -1;
+  }
+
+  if (spec_invoke(func, args, args_type, n_args, expected_type, &ret)) {
+    printf("unsupported signature: %s\n", fun_name);
+    return is_return ? SPEC_TEST_SKIP : -1;
+  }
+  if (!is_return)
+    return -1;
+
+  if (!spec_check(ret, expected, expect_nan, expected_type)) {
+    dump_spec_test(fun_name, args, args_type, n_args, expected,
+                   expected_type);
+    printf("[spec test] got: 0x%lx\n", ret);
+    return SPEC_TEST_FAIL;
+  }
+  return SPEC_TEST_PASS;
+
+malformed:
+  printf("malformed line: %s %s\n", command, fun_name);
+  return SPEC_TEST_FAIL;
+}
+
+int
+run_spec_test_script(const char* script_name, uint64_t* counts)
+{
+  struct SpecTestModule current;
+  char* script;
+  size_t size, pos = 0;
+  uint64_t module_counts[3] = { 0 };
+  char module_name[256] = "";
+  char line[SPEC_TEST_MAX_LINE];
+
+  memset(counts, 0, 3 * sizeof(*counts));
+
+  script = sgxwasm_load_file(script_name, &size);
+  if (script == NULL) {
+    printf("failed to load %s\n", script_name);
+    return -1;
+  }
+
+  current.high_init = 0;
+  current.module = NULL;
+
+  while (pos < size) {
+    size_t len = 0;
+    const char* rest;
+    int result;
+
+    while (pos < size && script[pos] != '\n') {
+      if (len + 1 < sizeof(line))
+        line[len++] = script[pos];
+      pos++;
+    }
+    pos++;
+    line[len] = '\0';
+
+    if (strncmp(line, "module ", 7) == 0) {
+      if (module_name[0] != '\0')
+        spec_report(module_name, module_counts);
+      spec_close_module(&current);
+      memset(module_counts, 0, sizeof(module_counts));
+
+      rest = line + 7;
+      if (!spec_next_token(&rest, module_name, sizeof(module_name)))
+        strcpy(module_name, "?");
+      spec_open_module(&current, module_name);
+      continue;
+    }
+
+    result = spec_run_line(&current, line);
+    if (result >= 0) {
+      module_counts[result]++;
+      counts[result]++;
+    }
+  }
+
+  if (module_name[0] != '\0')
+    spec_report(module_name, module_counts);
+  spec_close_module(&current);
+  sgxwasm_unload_file(script, size);
+
+  spec_report("TOTAL", counts);
+  return 0;
+}
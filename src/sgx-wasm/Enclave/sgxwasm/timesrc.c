@@ -0,0 +1,138 @@
+#include <sgxwasm/sys.h>
+#include <sgxwasm/timesrc.h>
+
+#if __SGX__
+#include "common.h"
+#include "sgx_trts.h"
+
+// Attempts to read a consistent snapshot before giving up on the page.
+#define PAGE_READ_RETRIES 16
+
+static struct time_page* page = NULL;
+static int page_failed = 0;
+
+// Per clock, shared by all enclave threads, only accessed atomically.
+// stale_reads stops at SGXWASM_TIME_STALE_READS: the page is then
+// bypassed until its seq changes.
+static uint64_t last_seq[TIME_PAGE_CLOCKS];
+static uint64_t stale_reads[TIME_PAGE_CLOCKS];
+static uint64_t last_ns[TIME_PAGE_CLOCKS];
+
+static struct time_page*
+get_page(void)
+{
+  void* p;
+  if (page || page_failed) {
+    return page;
+  }
+  p = sgxwasm_time_page(SGXWASM_TIME_PRECISION_US);
+  if (p && sgx_is_outside_enclave(p, sizeof(struct time_page))) {
+    page = p;
+  } else {
+    page_failed = 1;
+  }
+  return page;
+}
+
+// Returns 0 if the page is being rewritten or looks stale.
+static int
+read_page(int clock, uint64_t* ns)
+{
+  struct time_page* p = get_page();
+  uint64_t seq, value;
+  int i;
+
+  if (!p) {
+    return 0;
+  }
+  for (i = 0; i < PAGE_READ_RETRIES; i++) {
+    seq = p->seq;
+    __sync_synchronize();
+    value = p->ns[clock];
+    __sync_synchronize();
+    if (!(seq & 1) && seq == p->seq) {
+      break;
+    }
+  }
+  if (i == PAGE_READ_RETRIES) {
+    return 0;
+  }
+
+  if (__atomic_exchange_n(&last_seq[clock], seq, __ATOMIC_RELAXED) != seq) {
+    __atomic_store_n(&stale_reads[clock], 0, __ATOMIC_RELAXED);
+  } else if (__atomic_load_n(&stale_reads[clock], __ATOMIC_RELAXED) >=
+             SGXWASM_TIME_STALE_READS) {
+    return 0;
+  } else {
+    __atomic_fetch_add(&stale_reads[clock], 1, __ATOMIC_RELAXED);
+  }
+  *ns = value;
+  return 1;
+}
+
+// Never return less than before, for any clock: the page lags the ocall
+// by up to SGXWASM_TIME_PRECISION_US.
+static uint64_t
+clamp_forward(int clock, uint64_t ns)
+{
+  uint64_t last = __atomic_load_n(&last_ns[clock], __ATOMIC_RELAXED);
+
+  while (ns > last &&
+         !__atomic_compare_exchange_n(&last_ns[clock], &last, ns, 1,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+  }
+  return ns > last ? ns : last;
+}
+
+uint64_t
+sgxwasm_time_get(int clock, int strict)
+{
+  uint64_t ns;
+
+  assert(clock >= 0 && clock < TIME_PAGE_CLOCKS);
+  if (SGXWASM_TIME_STRICT || strict || !read_page(clock, &ns)) {
+    ns = sgxwasm_time_exit(clock);
+  }
+  return clamp_forward(clock, ns);
+}
+
+// Not served from the page: it changes every SGXWASM_TIME_PRECISION_US,
+// far coarser than the intervals the benchmarks measure.
+uint64_t
+sgxwasm_cycles(void)
+{
+  uint64_t t;
+  ocall_sgx_rdtsc(&t);
+  return t;
+}
+
+#else
+#include <time.h>
+
+uint64_t
+sgxwasm_time_get(int clock, int strict)
+{
+  static const clockid_t ids[] = {
+    CLOCK_REALTIME,
+    CLOCK_MONOTONIC,
+    CLOCK_PROCESS_CPUTIME_ID,
+  };
+  struct timespec ts;
+
+  (void)strict;
+  assert(clock >= 0 && clock < (int)(sizeof(ids) / sizeof(ids[0])));
+  if (clock_gettime(ids[clock], &ts)) {
+    return 0;
+  }
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+uint64_t
+sgxwasm_cycles(void)
+{
+  uint32_t lo, hi;
+  __asm__ volatile("rdtsc" : "=a"(lo), "=d"(hi));
+  return ((uint64_t)hi << 32) | lo;
+}
+
+#endif
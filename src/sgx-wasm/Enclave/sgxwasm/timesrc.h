@@ -0,0 +1,32 @@
+#ifndef __SGXWASM__TIMESRC_H__
+#define __SGXWASM__TIMESRC_H__
+
+#include <sgxwasm/config.h>
+#include <stdint.h>
+
+// Time source.
+//
+// Without SGX, this is clock_gettime(). For SGX, a helper thread of the
+// App publishes the clocks into a shared page every
+// SGXWASM_TIME_PRECISION_US, and readers take them from there without
+// leaving the enclave. Reads that must be exact (strict), and reads
+// after the page did not change for SGXWASM_TIME_STALE_READS reads in a
+// row (the helper may be gone or descheduled), use an ocall instead,
+// until the page changes again. No clock goes backwards, whatever the
+// untrusted side publishes: a clock set back on the host holds still
+// in the enclave until it catches up.
+
+// Same numbering as TIME_PAGE_* in Include/common.h.
+#define SGXWASM_CLOCK_REALTIME 0
+#define SGXWASM_CLOCK_MONOTONIC 1
+#define SGXWASM_CLOCK_PROCESS 2 // CPU time of the process.
+
+// Nanoseconds of the clock, or 0 if it cannot be read.
+uint64_t
+sgxwasm_time_get(int clock, int strict);
+
+// Cycle counter, for benchmarks. Always exact, so an ocall for SGX.
+uint64_t
+sgxwasm_cycles(void);
+
+#endif
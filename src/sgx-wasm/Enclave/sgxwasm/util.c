@@ -127,6 +127,18 @@ is_uintn(int64_t x, unsigned n)
   return !(x >> n);
 }
 
+uint64_t
+hash_bytes(const void* data, size_t size)
+{
+  const uint8_t* p = data;
+  uint64_t hash = 0xcbf29ce484222325;
+  size_t i;
+  for (i = 0; i < size; i++) {
+    hash ^= p[i];
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
 
 char*
 sgxwasm_load_file(const char* filename, size_t* size)
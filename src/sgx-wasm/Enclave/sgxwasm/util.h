@@ -51,6 +51,9 @@ uint32_t count_population(uint64_t, uint8_t);
 uint32_t count_leading_zeros(uint64_t, uint8_t);
 uint32_t count_trailing_zeros(uint64_t, uint8_t);
 
+// FNV-1a, for matching function bodies across builds.
+uint64_t hash_bytes(const void*, size_t);
+
 __attribute__((unused)) static uint64_t
 f64_encoding(double val)
 {
@@ -22,6 +22,7 @@
   SOFTWARE.
  */
 
+#include <sgxwasm/loadtime.h>
 #include <sgxwasm/vector.h>
 
 #if SGXWASM_LOADTIME_MEMORY
@@ -36,10 +37,18 @@ sgxwasm_reset_alloc_counter()
 {
   alloc_counter = 0;
 }
+#endif
+
+#if SGXWASM_LOADTIME_MEMORY || SGXWASM_LOADTIME_PROFILE
 void
 sgxwasm_increase_alloc_counter(uint64_t n)
 {
+#if SGXWASM_LOADTIME_MEMORY
   alloc_counter += n;
+#endif
+#if SGXWASM_LOADTIME_PROFILE
+  sgxwasm_loadtime_alloc(n);
+#endif
 }
 #endif
 
@@ -82,6 +91,9 @@ sgxwasm_vector_grow(size_t* capacity_ptr,
     if (!*data) {
       goto error;
     }
+#if SGXWASM_LOADTIME_PROFILE
+    sgxwasm_loadtime_alloc(total_data_size);
+#endif
   } else if (size == capacity) { // Double the capacity if the stack is full.
     assert(capacity > 0);
     capacity *= 2;
@@ -92,6 +104,9 @@ sgxwasm_vector_grow(size_t* capacity_ptr,
     if (!*data) {
       goto error;
     }
+#if SGXWASM_LOADTIME_PROFILE
+    sgxwasm_loadtime_alloc(total_data_size / 2);
+#endif
     *capacity_ptr = capacity;
   }
   *size_ptr += 1;
@@ -157,6 +172,9 @@ sgxwasm_vector_resize(size_t* capacity_ptr,
 #endif
       goto error;
     }
+#if SGXWASM_LOADTIME_PROFILE
+    sgxwasm_loadtime_alloc(total_data_size - *capacity_ptr * data_size);
+#endif
     *capacity_ptr = capacity;
     *size_ptr = new_size;
   }
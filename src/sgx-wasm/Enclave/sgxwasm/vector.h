@@ -39,7 +39,9 @@ int sgxwasm_vector_resize(size_t*, size_t*, void*, size_t, size_t);
 #if SGXWASM_LOADTIME_MEMORY
 uint64_t sgxwasm_get_alloc_counter();
 void sgxwasm_reset_alloc_counter();
-void sgxwasm_increase_alloc_counter();
+#endif
+#if SGXWASM_LOADTIME_MEMORY || SGXWASM_LOADTIME_PROFILE
+void sgxwasm_increase_alloc_counter(uint64_t);
 #endif
 
 #define DEFINE_ANON_VECTOR(type)                                               \
@@ -1 +1,48 @@
+#ifndef __COMMON_H__
+#define __COMMON_H__
+
 typedef unsigned long nfds_t;
+
+/* Identity of the process, snapshotted by the enclave (ocall_stub.c)
+   and refreshed by enclave_refresh_process_ids. */
+struct process_ids
+{
+  int pid;
+  unsigned uid;
+  unsigned euid;
+  unsigned gid;
+  unsigned egid;
+};
+
+/* Clocks published by a helper thread of the App for the enclave
+   (Enclave/sgxwasm/timesrc.c), in nanoseconds. seq is odd while the
+   page is being updated. */
+#define TIME_PAGE_REALTIME 0
+#define TIME_PAGE_MONOTONIC 1
+#define TIME_PAGE_PROCESS 2
+#define TIME_PAGE_CLOCKS 3
+
+struct time_page
+{
+  volatile uint64_t seq;
+  volatile uint64_t ns[TIME_PAGE_CLOCKS];
+};
+
+/* Request of the I/O bridge (Enclave/sgxwasm/iobridge.c). The enclave
+   writes it to a window of untrusted memory, followed by len bytes of
+   data, and ocall_sgx_io_submit carries it out in place. */
+#define IO_REQUEST_WRITE 0
+#define IO_REQUEST_READ 1
+#define IO_REQUEST_SEND 2
+#define IO_REQUEST_RECV 3
+
+struct io_request
+{
+  int op;
+  int fd;
+  int flags;
+  int err; /* errno on failure, set by the untrusted side */
+  size_t len;
+};
+
+#endif
@@ -51,6 +51,8 @@
 
 int
 run_wasm_test(const char*, uint32_t, int, size_t, size_t);
+int
+run_spec_test_script(const char*, uint64_t*);
 
 static void*
 get_stack_top(void)
@@ -388,6 +390,12 @@ run_emscripten_file(const char* filename,
     goto error;
   }
 
+#if __PROFILE__
+  if (sgxwasm_high_dump_profile(&high, "asm", SGXWASM_PROFILE_PATH) < 0) {
+    fprintf(stderr, "failed to write profile\n");
+  }
+#endif
+
   if (0) {
     char error_buffer[256];
 
@@ -411,17 +419,21 @@ main(int argc, char* argv[])
 {
   int ret = 0;
   char* filename;
-  int dump_module, opt;
+  int dump_module, spec_script, opt;
   int has_table;
   size_t tablemin = 0, tablemax = 0;
   uint32_t static_bump = 0;
 
   dump_module = 0;
-  while ((opt = getopt(argc, argv, "dop")) != -1) {
+  spec_script = 0;
+  while ((opt = getopt(argc, argv, "dops")) != -1) {
     switch (opt) {
       case 'd':
         dump_module = 1;
         break;
+      case 's':
+        spec_script = 1;
+        break;
       default:
         return -1;
     }
@@ -437,6 +449,13 @@ main(int argc, char* argv[])
   if (dump_module)
     return dump_wasm_module(filename);
 
+  if (spec_script) {
+    uint64_t counts[3];
+    if (run_spec_test_script(filename, counts))
+      return -1;
+    return counts[1] != 0;
+  }
+
   // Hard-coded
   // static_bump = 10000;
   // static_bump = 26320;
@@ -0,0 +1,18 @@
+# Hardening profile for the PolyBench/C benchmarks (T-SGX), replacing the
+# function indices that used to be hard-coded in pass_tsgx.c. Copy to
+# sgxwasm.profile next to the module to use it.
+#
+# The old list also skipped index 23, init_array. It is static in every
+# kernel, so it has no export name to match, and its body, hence its
+# hash, differs from kernel to kernel. To skip it for a kernel, run that
+# kernel once with a __PROFILE__ build and add its hash line from the
+# written profile here with the skip policy:
+#   hash:<init_array of the kernel>	skip
+#
+# key			policy
+name:_malloc		skip
+name:_free		skip
+name:_memcpy		skip
+name:_memset		skip
+name:_sbrk		skip
+name:stackAlloc		opt
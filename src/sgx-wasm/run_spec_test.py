@@ -4,6 +4,7 @@ import sys
 import json
 import os
 import subprocess
+import tempfile
 from ctypes import *
 
 def is_hex(s):
@@ -133,13 +134,68 @@ def run_test(path, data):
         else:
             print 'pass: ' + wasm + ' ' + fun + ' ' + n_args + ' ' + args + ret
  
+type_codes = {'i32': '0', 'i64': '1', 'f32': '2', 'f64': '3'}
+
+def to_script_value(v, t):
+    if v.startswith('nan'):
+        return 'nan ' + type_codes[t]
+    return v + ' ' + type_codes[t]
+
+# Translate the json commands into the line script that
+# run_spec_test_script() in the enclave runs in one go.
+def to_script(path, data):
+    lines = []
+    for c in data['commands']:
+        if c['type'] == 'module':
+            lines.append('module ' + os.path.join(path, c['filename']))
+            continue
+
+        if c['type'] not in ('assert_return', 'assert_trap', 'action'):
+            continue
+        action = c['action']
+        if action['type'] != 'invoke':
+            continue
+
+        args = action.get('args', [])
+        line = [action['field'], str(len(args))]
+        for arg in args:
+            line.append(to_script_value(arg['value'], arg['type']))
+
+        if c['type'] == 'assert_return':
+            expected = c['expected']
+            if len(expected) == 0:
+                line.append('0 4')
+            else:
+                line.append(to_script_value(expected[0]['value'],
+                                            expected[0]['type']))
+            lines.append('assert_return ' + ' '.join(line))
+        elif c['type'] == 'assert_trap':
+            lines.append('assert_trap ' + ' '.join(line))
+        else:
+            lines.append('invoke ' + ' '.join(line))
+    return '\n'.join(lines) + '\n'
+
+def run_script(path, data):
+    script = tempfile.NamedTemporaryFile(mode='w', suffix='.spec',
+                                         delete=False)
+    try:
+        script.write(to_script(path, data))
+        script.close()
+        return subprocess.call(['./app', script.name])
+    finally:
+        os.unlink(script.name)
+
 def main():
-    file_name = sys.argv[1]
+    single = len(sys.argv) > 2 and sys.argv[1] == '--single'
+    file_name = sys.argv[-1]
     json_file = open(file_name)
     data = json.load(json_file)
 
     path = os.path.dirname(file_name)
-    run_test(path, data)
+    if single:
+        run_test(path, data)
+    else:
+        sys.exit(run_script(path, data))
 
 if __name__ == "__main__":
     main()
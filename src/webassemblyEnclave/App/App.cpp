@@ -34,6 +34,8 @@
 #include <string.h>
 #include <assert.h>
 #include <getopt.h>
+#include <math.h>
+#include <time.h>
 
 # include <unistd.h>
 # include <pwd.h>
@@ -287,10 +289,68 @@ char **split_string(char *str, int *count) {
 }
 
 void usage(char *prog) {
-    fprintf(stderr, "%s [--debug] WASM_FILE [--repl|-- ARG...]\n", prog);
+    fprintf(stderr, "%s [--debug] [--bench N] [--reset] WASM_FILE [--repl|-- ARG...]\n", prog);
     exit(2);
 }
 
+#define MAX_ARGS 16
+
+char *value_repr(char *value, StackValue *v) {
+    switch (v->value_type) {
+    case I32: snprintf(value, 255, "0x%x:i32",  v->value.uint32); break;
+    case I64: snprintf(value, 255, "0x%llx:i64", (unsigned long long)v->value.uint64); break;
+    case F32: snprintf(value, 255, "%.7g:f32",  v->value.f32);    break;
+    case F64: snprintf(value, 255, "%.7g:f64",  v->value.f64);    break;
+    default:  value[0] = '\0'; break;
+    }
+    return value;
+}
+
+// Parse the arguments of the exported function entry of the module
+// handle by the types of its parameters, like invoke in the enclave
+int parse_args(sgx_enclave_id_t enclave_id, uint32_t handle, char *entry,
+               int argc, char **argv, StackValue *args) {
+    int      ret = -1;
+    uint32_t param_count = 0;
+    uint8_t  params[MAX_ARGS], result_type;
+
+    if (argc > MAX_ARGS) {
+        printf("Error: at most %d arguments, got %d\n", MAX_ARGS, argc);
+        return -1;
+    }
+    ecall_get_signature(enclave_id, &ret, handle, entry, &param_count,
+                        params, MAX_ARGS, &result_type);
+    if (ret != 0) {
+        printf("Error: no exported function named '%s'\n", entry);
+        return -1;
+    }
+    if (param_count != (uint32_t)argc) {
+        printf("Error: '%s' takes %d arguments, got %d\n", entry,
+               param_count, argc);
+        return -1;
+    }
+    for (int i = 0; i < argc; i++) {
+        StackValue *sv = &args[i];
+        sv->value_type = params[i];
+        sv->value.uint64 = 0;
+        switch (params[i]) {
+        case I32: sv->value.uint32 = strtoul(argv[i], NULL, 0); break;
+        case I64: sv->value.uint64 = strtoull(argv[i], NULL, 0); break;
+        case F32: sv->value.f32 = strncasecmp("-nan", argv[i], 4) == 0 ?
+                                  -NAN : atof(argv[i]); break;
+        case F64: sv->value.f64 = strncasecmp("-nan", argv[i], 4) == 0 ?
+                                  -NAN : atof(argv[i]); break;
+        }
+    }
+    return 0;
+}
+
+double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
 // Special test imports
 uint32_t _spectest__global_ = 666;
 
@@ -316,19 +376,22 @@ int SGX_CDECL main(int argc, char *argv[])
     }
     
     char   *mod_path, *entry, *line;
-    int     repl = 0, debug = 0, res = 0;
+    int     repl = 0, debug = 0, res = 0, bench = 0, reset = 0;
 
     // Parse arguments
     int option_index = 0, c;
     struct option long_options[] = {
         {"repl",  no_argument, &repl,  1},
         {"debug", no_argument, &debug, 1},
+        {"bench", required_argument, 0, 'b'},
+        {"reset", no_argument, &reset, 1},
         {0,       0,           0,      0}
     };
     while ((c = getopt_long (argc, argv, "",
                              long_options, &option_index)) != -1) {
         switch (c) {
         case 0: break;
+        case 'b': bench = atoi(optarg); break;
         case '?': usage(argv[0]); break;
         default: usage(argv[0]);
         }
@@ -343,11 +406,11 @@ int SGX_CDECL main(int argc, char *argv[])
 
     // Load the module
     Options opts;
-    Module *m;
-    //Module *m = load_module(mod_path, opts);
     uint8_t  *bytes;
     uint32_t *len;
 
+    memset(&opts, 0, sizeof(opts));
+
     FILE *f = fopen(mod_path, "rb");
     fseek(f, 0, SEEK_END);
     len = (uint32_t*)malloc(sizeof(uint32_t));
@@ -358,64 +421,86 @@ int SGX_CDECL main(int argc, char *argv[])
     bytes = (uint8_t*)malloc(*len);
     fread(bytes, *len, 1, f);
     fclose(f);
-    //printf("here");fflush(stdout);
-    //uint8_t *bytes, char *path, uint32_t *len
-    //ecall_load_module(enclave_id, (int*)&status, *len, bytes,  m, mod_path, opts);
-    //printf("ladeda\n");fflush(stdout);
-    //printf("here in app.cpp %d\n", m->function_count);fflush(stdout);
 
-    //char value_str[256];
     char *output = (char*)malloc(256*sizeof(char));
     memset(output, '\0', 1);
+
+    // The module stays loaded in the enclave for all invocations
+    uint32_t   handle = 0;
+    StackValue args[MAX_ARGS], result;
+    char       value_str[256];
+    bool       ok = false;
+
+    ecall_load_module(enclave_id, &res, *len, bytes, mod_path, opts, &handle);
+    if (res != 0 || handle == 0) {
+        printf("Error: could not load '%s'\n", mod_path);
+        exit(1);
+    }
+    if (reset) {
+        // Restore the state after loading before every invocation
+        ecall_snapshot_module(enclave_id, &res, handle);
+    }
+
     if (!repl) {
         // Invoke one function and exit
-        //res = invoke(m, argv[optind], argc-optind-1, argv+optind+1);
-        //printf("here");fflush(stdout);
-        //ecall_invoke(enclave_id, (int*)&status, (bool*)&res, m, argv[optind], argc-optind-1, argv+optind+1);
-        //printf("here");fflush(stdout);
-        ecall_load_invoke_allInOne(enclave_id, (int*)&status, *len, bytes, mod_path, opts, (bool*)&res, argv[optind], argc-optind-1, argv+optind+1, output);
-
-        if (res) {
-                    printf("%s\n", output);
-	    //if (m->sp >= 0) {
-		//printf("%s\n", value_repr(value_str, &m->stack[m->sp]));
-	    //}
+        entry = optind < argc ? argv[optind++] : (char*)"main";
+        int nargs = argc-optind;
+        if (parse_args(enclave_id, handle, entry, nargs, argv+optind,
+                       args) != 0) {
+            exit(1);
+        }
+
+        if (bench > 0) {
+            // Load, invoke and tear down (cold) versus invoke only (warm)
+            double start = now_us();
+            ecall_load_invoke_allInOne(enclave_id, &res, *len, bytes, mod_path, opts, (bool*)&ok, entry, nargs, argv+optind, output);
+            double cold = now_us() - start;
+
+            double total = 0, min = 0;
+            for (int i = 0; i < bench; i++) {
+                start = now_us();
+                ecall_invoke(enclave_id, &res, handle, entry, nargs, args,
+                             reset, &result, &ok, output);
+                double lat = now_us() - start;
+                total += lat;
+                if (i == 0 || lat < min) { min = lat; }
+            }
+            printf("cold: %.1f us, warm: %.1f us/invocation (min %.1f us), "
+                   "%d invocations\n", cold, total / bench, min, bench);
         } else {
-	    //error("Exception: %s\n", exception); removing these since we don't have the global exception available outside the enclave 
-        printf("Exception\n");
-	    exit(1);
-	}
+            ecall_invoke(enclave_id, &res, handle, entry, nargs, args,
+                         reset, &result, &ok, output);
+        }
+
+        if (ok) {
+            printf("%s\n", value_repr(value_str, &result));
+        } else {
+            printf("Exception: %s\n", output);
+            exit(1);
+        }
     } else {
         // Simple REPL
         if (optind < argc) { usage(argv[0]); }
         while (line = readline("webassembly> ")) {
-            memset(output, '\0', 1);
             int token_cnt = 0;
             char **tokens = split_string(line, &token_cnt);
             if (token_cnt == 0) { continue; }
 
-            // Reset the stacks
-            /*m->sp = -1;
-            m->fp = -1;
-            m->csp = -1;*/
-            //res = invoke(m, tokens[0], token_cnt-1, tokens+1);
-            //ecall_invoke(enclave_id, (int*)&status, (bool*)&res, m, tokens[0], token_cnt-1, tokens+1);
-            ecall_load_invoke_allInOne(enclave_id, (int*)&status, *len, bytes, mod_path, opts, (bool*)&res, argv[optind], argc-optind-1, argv+optind+1, output);
-
-	    if (res) {
-            printf("%s\n", output);
-
-		//if (m->sp >= 0) {
-		//    printf("%s\n", value_repr(value_str, &m->stack[m->sp]));
-		//}
-	    } else {
-		//error("Exception: %s\n", exception);
-        printf("Exception\n");
-
-	    }
+            if (parse_args(enclave_id, handle, tokens[0], token_cnt-1,
+                           tokens+1, args) == 0) {
+                ecall_invoke(enclave_id, &res, handle, tokens[0],
+                             token_cnt-1, args, reset, &result, &ok, output);
+                if (ok) {
+                    printf("%s\n", value_repr(value_str, &result));
+                } else {
+                    printf("Exception: %s\n", output);
+                }
+            }
             free(tokens);
         }
     }
+
+    ecall_unload_module(enclave_id, &res, handle);
  
     /* Utilize edger8r attributes */
     //edger8r_array_attributes();
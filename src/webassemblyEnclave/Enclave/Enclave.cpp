@@ -37,6 +37,7 @@
 
 #include "Enclave.h"
 #include "Enclave_t.h"  /* print_string */
+#include "sgx_thread.h"
 
 #include "wa.h"
 
@@ -79,13 +80,152 @@ int ecall_load_invoke_allInOne(uint32_t len, uint8_t* file_contents, char *path,
     //printf("in ecall\n");
     char value_str[256];
     Module *m = load_module(len, file_contents, path, opts);
-    *b = invoke(m, entry, argc, argv);
     memset(output, '\0', 1);
+    if (m == NULL) {
+        *b = false;
+        return -1;
+    }
+    *b = invoke(m, entry, argc, argv);
     if (m->sp >= 0) {
         char *temp = value_repr(value_str, &m->stack[m->sp]);
 	    snprintf(output, strlen(temp+3), "%s\n", temp);
         //printf("enclave will return string %s\n", output);
     }
     //printf("almost there\n");
+    free_module(m);
+    return SGX_SUCCESS;
+}
+
+// Modules loaded by ecall_load_module. The handle of a module is its
+// index + 1, 0 is never a valid handle. Several threads may enter the
+// enclave (TCSNum), so every slot has a mutex. get_module() locks it and
+// the ecall holds it until put_module(): calls on one module run one at a
+// time and unload waits for the running call to finish.
+#define MAX_MODULES 16
+
+static Module *modules[MAX_MODULES];
+static sgx_thread_mutex_t modules_lock[MAX_MODULES] = {
+    SGX_THREAD_MUTEX_INITIALIZER, SGX_THREAD_MUTEX_INITIALIZER,
+    SGX_THREAD_MUTEX_INITIALIZER, SGX_THREAD_MUTEX_INITIALIZER,
+    SGX_THREAD_MUTEX_INITIALIZER, SGX_THREAD_MUTEX_INITIALIZER,
+    SGX_THREAD_MUTEX_INITIALIZER, SGX_THREAD_MUTEX_INITIALIZER,
+    SGX_THREAD_MUTEX_INITIALIZER, SGX_THREAD_MUTEX_INITIALIZER,
+    SGX_THREAD_MUTEX_INITIALIZER, SGX_THREAD_MUTEX_INITIALIZER,
+    SGX_THREAD_MUTEX_INITIALIZER, SGX_THREAD_MUTEX_INITIALIZER,
+    SGX_THREAD_MUTEX_INITIALIZER, SGX_THREAD_MUTEX_INITIALIZER};
+
+// Returns the module with the slot locked, or NULL (slot not locked)
+static Module *get_module(uint32_t handle) {
+    Module *m = NULL;
+    if (handle == 0 || handle > MAX_MODULES) {
+        return NULL;
+    }
+    sgx_thread_mutex_lock(&modules_lock[handle-1]);
+    m = modules[handle-1];
+    if (m == NULL) {
+        sgx_thread_mutex_unlock(&modules_lock[handle-1]);
+    }
+    return m;
+}
+
+static void put_module(uint32_t handle) {
+    sgx_thread_mutex_unlock(&modules_lock[handle-1]);
+}
+
+int ecall_load_module(uint32_t len, uint8_t* file_contents, char *path, Options opts, uint32_t *handle){
+    *handle = 0;
+    char *module_path = strdup(path);
+    if (module_path == NULL) {
+        return -1;
+    }
+    Module *m = load_module(len, file_contents, module_path, opts);
+    if (m == NULL) {
+        free(module_path);
+        return -1;
+    }
+    // file_contents is only valid during the ecall, the module does not
+    // use it once loaded
+    m->bytes = NULL;
+
+    // A slot that is locked is in use, skip it instead of waiting
+    for (uint32_t i=0; i<MAX_MODULES && *handle == 0; i++) {
+        if (sgx_thread_mutex_trylock(&modules_lock[i]) != 0) {
+            continue;
+        }
+        if (modules[i] == NULL) {
+            modules[i] = m;
+            *handle = i+1;
+        }
+        sgx_thread_mutex_unlock(&modules_lock[i]);
+    }
+    if (*handle == 0) {
+        free_module(m);
+        free(module_path);
+        return -1;
+    }
+    return SGX_SUCCESS;
+}
+
+int ecall_get_signature(uint32_t handle, char *entry, uint32_t *param_count, uint8_t *params, uint32_t max_params, uint8_t *result_type){
+    Module *m = get_module(handle);
+    if (m == NULL) {
+        return -1;
+    }
+    uint32_t fidx = get_export_fidx(m, entry);
+    if (fidx == (uint32_t)-1) {
+        put_module(handle);
+        return -1;
+    }
+    Type *type = m->functions[fidx].type;
+    *param_count = type->param_count;
+    for (uint32_t p=0; p<type->param_count && p<max_params; p++) {
+        params[p] = type->params[p];
+    }
+    *result_type = type->result_count > 0 ? type->results[0] : 0;
+    put_module(handle);
+    return SGX_SUCCESS;
+}
+
+// If reset is set, the state saved by ecall_snapshot_module is restored
+// before the call.
+int ecall_invoke(uint32_t handle, char *entry, uint32_t argc, StackValue *args, int reset, StackValue *result, bool *b, char *output){
+    Module *m = get_module(handle);
+    memset(output, '\0', 1);
+    *b = false;
+    if (m == NULL) {
+        return -1;
+    }
+    if (reset && !reset_module(m)) {
+        snprintf(output, 256, "no snapshot to reset to");
+    } else {
+        *b = invoke_typed(m, entry, argc, args, result);
+        if (!*b) {
+            snprintf(output, 256, "%s", exception);
+        }
+    }
+    put_module(handle);
+    return SGX_SUCCESS;
+}
+
+int ecall_snapshot_module(uint32_t handle){
+    Module *m = get_module(handle);
+    if (m == NULL) {
+        return -1;
+    }
+    snapshot_module(m);
+    put_module(handle);
+    return SGX_SUCCESS;
+}
+
+int ecall_unload_module(uint32_t handle){
+    // Waits for a call that is using the module to return
+    Module *m = get_module(handle);
+    if (m == NULL) {
+        return -1;
+    }
+    modules[handle-1] = NULL;
+    put_module(handle);
+    free(m->path);
+    free_module(m);
     return SGX_SUCCESS;
 }
@@ -103,6 +103,42 @@ void *arecalloc(void *ptr, size_t old_nmemb, size_t nmemb,
     return res;
 }
 
+// Size of the chunks of a module arena. Larger allocations get a chunk
+// of their own.
+#define ARENA_CHUNK_SIZE 0x10000
+
+// Allocate zeroed, 8-byte aligned memory from arena
+void *arena_alloc(Arena *arena, size_t size, char *name) {
+    size = (size + 7) & ~(size_t)7;
+    if (arena->chunk == NULL || arena->used + size > arena->size) {
+        size_t chunk_size = sizeof(uint8_t *) + size;
+        if (chunk_size < ARENA_CHUNK_SIZE) {
+            chunk_size = ARENA_CHUNK_SIZE;
+        }
+        uint8_t *chunk = (uint8_t*) acalloc(1, chunk_size, name);
+        *(uint8_t **)chunk = arena->chunk;
+        arena->chunk = chunk;
+        arena->used = sizeof(uint8_t *);
+        arena->size = chunk_size;
+    }
+    void *res = arena->chunk + arena->used;
+    arena->used += size;
+    return res;
+}
+
+// Free all chunks of arena
+void arena_free(Arena *arena) {
+    uint8_t *chunk = arena->chunk;
+    while (chunk) {
+        uint8_t *next = *(uint8_t **)chunk;
+        free(chunk);
+        chunk = next;
+    }
+    arena->chunk = NULL;
+    arena->used = 0;
+    arena->size = 0;
+}
+
 // Split a space separated strings into an array of strings
 // Returns 0 on failure
 // Memory must be freed by caller
@@ -195,23 +231,61 @@ double wa_fmin(double a, double b) {
 
 // Dynamic lib resolution
 
+// There is no dlopen/dlsym inside the enclave. Modules can import the
+// native functions and globals listed here instead, by symbol name.
+
+// Special test imports
+static uint32_t spectest_global_i32 = 666;
+static uint64_t spectest_global_i64 = 666;
+static float    spectest_global_f32 = 666.6;
+static double   spectest_global_f64 = 666.6;
+
+static void spectest_print(void) { }
+static void spectest_print_i32(uint32_t a) { printf("%d : i32\n", a); }
+static void spectest_print_i64(uint64_t a) { printf("%lld : i64\n", (long long)a); }
+static void spectest_print_f32(float a) { printf("%g : f32\n", a); }
+static void spectest_print_f64(double a) { printf("%g : f64\n", a); }
+static void spectest_print_i32_f32(uint32_t a, float b) {
+    printf("%d : i32\n%g : f32\n", a, b);
+}
+static void spectest_print_f64_f64(double a, double b) {
+    printf("%g : f64\n%g : f64\n", a, b);
+}
+
+static struct {
+    const char *name;
+    void       *addr;
+} host_symbols[] = {
+    {"_spectest__global_",        (void*)&spectest_global_i32},
+    {"_spectest__global_i32_",    (void*)&spectest_global_i32},
+    {"_spectest__global_i64_",    (void*)&spectest_global_i64},
+    {"_spectest__global_f32_",    (void*)&spectest_global_f32},
+    {"_spectest__global_f64_",    (void*)&spectest_global_f64},
+    {"_spectest__print_",         (void*)spectest_print},
+    {"_spectest__print_i32_",     (void*)spectest_print_i32},
+    {"_spectest__print_i64_",     (void*)spectest_print_i64},
+    {"_spectest__print_f32_",     (void*)spectest_print_f32},
+    {"_spectest__print_f64_",     (void*)spectest_print_f64},
+    {"_spectest__print_i32_f32_", (void*)spectest_print_i32_f32},
+    {"_spectest__print_f64_f64_", (void*)spectest_print_f64_f64},
+    {NULL,                        NULL}
+};
+
 // If filename is NULL, a NULL handle will be used
 // Returns true if resolution successful
 // Return false and sets err if resolution is not successful
 bool resolvesym(char *filename, char *symbol, void **val, char **err) {
-    void *handle = NULL;
-    /*dlerror(); // clear errors
     if (filename) {
-        handle = dlopen(filename, RTLD_LAZY);
-        if (!handle) {
-            *err = dlerror();
-            return false;
-        }
-    }
-    *val = dlsym(handle, symbol);
-    if ((*err = dlerror()) != NULL) {
+        // No shared libraries in the enclave
+        *err = (char*)"cannot open shared libraries";
         return false;
     }
-    return true;*/
+    for (int i=0; host_symbols[i].name; i++) {
+        if (strcmp(host_symbols[i].name, symbol) == 0) {
+            *val = host_symbols[i].addr;
+            return true;
+        }
+    }
+    *err = (char*)"undefined symbol";
     return false;
 }
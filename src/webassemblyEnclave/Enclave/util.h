@@ -74,6 +74,9 @@ void *arecalloc(void *ptr, size_t old_nmemb, size_t nmemb,
                 size_t size,  char *name);
 char **split_string(char *str, int *count);
 
+void *arena_alloc(Arena *arena, size_t size, char *name);
+void arena_free(Arena *arena);
+
 // Math
 void sext_8_32(uint32_t *val);
 void sext_16_32(uint32_t *val);
@@ -243,8 +243,8 @@ uint32_t LOAD_SIZE[] = {
     4, 8, 4, 8, 1, 2, 1, 2, 4};               // stores
 
 
-// global exception message
-char  exception[4096];
+// exception message, one per thread (TCSNum threads may run modules)
+__thread char  exception[4096];
 
 // Static definition of block_types
 uint32_t block_type_results[4][1] = {I32, I64, F32, F64};
@@ -269,7 +269,7 @@ Type *get_block_type(uint8_t value_type) {
     }
 }
 
-char _value_str[256];
+__thread char _value_str[256];
 char *value_repr(StackValue *v) {
     switch (v->value_type) {
     case I32: snprintf(_value_str, 255, "0x%x:i32",  v->value.uint32); break;
@@ -280,7 +280,7 @@ char *value_repr(StackValue *v) {
     return _value_str;
 }
 
-char _block_str[1024];
+__thread char _block_str[1024];
 char *block_repr(Block *b) {
     if (b->block_type == 0) {
         snprintf(_block_str, 1023,
@@ -348,104 +348,184 @@ void parse_memory_type(Module *m, uint32_t *pos) {
     }
 }
 
-void skip_immediates(uint8_t *bytes, uint32_t *pos) {
-    uint32_t count, opcode = bytes[*pos];
-    *pos = *pos+1;
-    switch (opcode) {
-    // varuint1
-    case 0x3f ... 0x40:    // current_memory, grow_memory
-        read_LEB(bytes, pos, 1); break;
-    // varuint32, varint32
-    case 0x0c ... 0x0d:    // br, br_if
-    case 0x10:            // call
-    case 0x20 ... 0x24:    // get/set_local, tee_local, get/set_global
-    case 0x41:            // i32.const
-        read_LEB(bytes, pos, 32); break;
-    // varuint32 + varuint1
-    case 0x11:            // call_indirect
-        read_LEB(bytes, pos, 1); read_LEB(bytes, pos, 32); break;
-    // varint64
-    case 0x42:            // i64.const
-        read_LEB(bytes, pos, 64); break;
-    // uint32
-    case 0x43:            // f32.const
-        *pos += 4; break;
-    // uint64
-    case 0x44:            // f64.const
-        *pos += 8; break;
-    // block_type
-    case 0x02 ... 0x04:    // block, loop, if
-        read_LEB(bytes, pos, 7); break;
-    // memory_immediate
-    case 0x28 ... 0x3e:    // *.load*, *.store*
-        read_LEB(bytes, pos, 32); read_LEB(bytes, pos, 32); break;
-    // br_table
-    case 0x0e:            // br_table
-        count = read_LEB(bytes, pos, 32); // target count
-        for (uint32_t i=0; i<count; i++) {
-            read_LEB(bytes, pos, 32);
-        }
-        read_LEB(bytes, pos, 32); // default target
-        break;
-    default:              // no immediates
-        break;
+//
+// Pre-decoding (byte code to Instr)
+//
+
+// Append an instruction to m->code and return its index
+uint32_t emit_instr(Module *m, uint32_t *capacity, uint8_t opcode) {
+    if (m->code_count == *capacity) {
+        uint32_t count = *capacity ? *capacity*2 : 0x400;
+        m->code = (Instr*) arecalloc(m->code, *capacity, count, sizeof(Instr),
+                                     "Module->code");
+        *capacity = count;
     }
+    m->code[m->code_count].opcode = opcode;
+    return m->code_count++;
 }
 
-void find_blocks(Module *m) {
-    Block    *function;
-    Block    *block;
+// Index of the instruction a branch of depth goes to. Branching out of
+// the outermost block goes to the end of the function.
+uint32_t branch_target(Block *function, Block **blockstack, int top,
+                       uint32_t depth) {
+    if ((int)depth > top) {
+        ASSERT((int)depth == top+1, "invalid branch depth %d\n", depth);
+        return function->br_addr;
+    }
+    return blockstack[top-depth]->br_addr;
+}
+
+// Decode the body of function into m->code. The blocks are allocated from
+// the module arena and referenced by the instructions that start them;
+// their addresses and those of the function are indices into m->code.
+// Branches are resolved in a second pass, once every end is known.
+void decode_function(Module *m, Block *function, uint32_t *capacity) {
+    uint8_t  *bytes = m->bytes;
     Block    *blockstack[BLOCKSTACK_SIZE];
+    Block    *block;
     int       top = -1;
-    uint8_t   opcode = 0x00;
-    info("  find_blocks: function_count: %d\n", m->function_count);
-    for (uint32_t f=m->import_count; f<m->function_count; f++) {
-        function = &m->functions[f];
-        debug("    fidx: 0x%x, start: 0x%x, end: 0x%x\n",
-               f, function->start_addr, function->end_addr);
-        uint32_t pos = function->start_addr;
-        while (pos <= function->end_addr) {
-            opcode = m->bytes[pos];
-            switch (opcode) {
-            case 0x02: // block
-            case 0x03: // loop
-            case 0x04: // if
-                block = (Block*) acalloc(1, sizeof(Block), "Block");
-                block->block_type = opcode;
-                block->type = get_block_type(m->bytes[pos+1]);
-                block->start_addr = pos;
-                blockstack[++top] = block;
-                m->block_lookup[pos] = block;
-                break;
-            case 0x05: // else
-                ASSERT(blockstack[top]->block_type == 0x04,
-                       "else not matched with if")
-                blockstack[top]->else_addr = pos+1;
-                break;
-            case 0x0b: // end
-                if (pos == function->end_addr) { break; }
-                ASSERT(top >= 0, "blockstack underflow");
-                block = blockstack[top--];
-                block->end_addr = pos;
-                if (block->block_type == 0x03) {
-                    // loop: label after start
-                    block->br_addr = block->start_addr+2;
-                } else {
-                    // block, if: label at end
-                    block->br_addr = pos;
-                }
-                debug("      block start: 0x%x, end: 0x%x,"
-                       " br_addr: 0x%x, else_addr: 0x%x\n",
-                       block->start_addr, block->end_addr, block->br_addr,
-                       block->else_addr);
-                break;
+    uint32_t  pos = function->start_addr;
+    uint32_t  end = function->end_addr;
+    uint32_t  first = m->code_count;
+    uint32_t  idx, count, *targets;
+
+    while (pos <= end) {
+        uint32_t start = pos;
+        uint8_t opcode = bytes[pos++];
+        idx = emit_instr(m, capacity, opcode);
+        Instr *in = &m->code[idx];
+        switch (opcode) {
+        case 0x02:  // block
+        case 0x03:  // loop
+        case 0x04:  // if
+            block = (Block*) arena_alloc(&m->arena, sizeof(Block), "Block");
+            block->block_type = opcode;
+            block->type = get_block_type(bytes[pos]);
+            read_LEB(bytes, &pos, 7);
+            block->start_addr = idx;
+            if (opcode == 0x03) {
+                // loop: label after start
+                block->br_addr = idx+1;
+            }
+            in->imm.block = block;
+            blockstack[++top] = block;
+            break;
+        case 0x05:  // else
+            ASSERT(top >= 0 && blockstack[top]->block_type == 0x04,
+                   "else not matched with if")
+            blockstack[top]->else_addr = idx+1;
+            break;
+        case 0x0b:  // end
+            if (start == end) { break; }
+            ASSERT(top >= 0, "blockstack underflow");
+            block = blockstack[top--];
+            block->end_addr = idx;
+            if (block->block_type != 0x03) {
+                // block, if: label at end
+                block->br_addr = idx;
+            }
+            debug("      block start: 0x%x, end: 0x%x,"
+                   " br_addr: 0x%x, else_addr: 0x%x\n",
+                   block->start_addr, block->end_addr, block->br_addr,
+                   block->else_addr);
+            m->block_count++;
+            break;
+        case 0x0c:  // br
+        case 0x0d:  // br_if
+        case 0x10:  // call
+        case 0x20 ... 0x24:  // get/set_local, tee_local, get/set_global
+            in->arg = read_LEB(bytes, &pos, 32);
+            break;
+        case 0x0e:  // br_table
+            // (depth, target) pairs, the default one last
+            count = read_LEB(bytes, &pos, 32);
+            targets = (uint32_t*) arena_alloc(&m->arena,
+                                              2*(count+1)*sizeof(uint32_t),
+                                              "br_table targets");
+            for (uint32_t i=0; i<=count; i++) {
+                targets[2*i] = read_LEB(bytes, &pos, 32);
             }
-            skip_immediates(m->bytes, &pos);
+            in->arg = count;
+            in->imm.targets = targets;
+            break;
+        case 0x11:  // call_indirect
+            in->arg = read_LEB(bytes, &pos, 32);
+            read_LEB(bytes, &pos, 1);  // reserved immediate
+            break;
+        case 0x28 ... 0x3e:  // *.load*, *.store*
+            read_LEB(bytes, &pos, 32);  // flags (alignment hint)
+            in->arg = read_LEB(bytes, &pos, 32);
+            break;
+        case 0x3f ... 0x40:  // current_memory, grow_memory
+            read_LEB(bytes, &pos, 1);
+            break;
+        case 0x41:  // i32.const
+            in->imm.uint32 = read_LEB_signed(bytes, &pos, 32);
+            break;
+        case 0x42:  // i64.const
+            in->imm.uint64 = read_LEB_signed(bytes, &pos, 64);
+            break;
+        case 0x43:  // f32.const
+            memcpy(&in->imm.uint32, bytes+pos, 4);
+            pos += 4;
+            break;
+        case 0x44:  // f64.const
+            memcpy(&in->imm.uint64, bytes+pos, 8);
+            pos += 8;
+            break;
+        default:    // no immediates
+            break;
         }
+    }
+    ASSERT(top == -1, "Function ended in middle of block\n")
+
+    function->start_addr = first;
+    function->end_addr = idx;
+    function->br_addr = idx;
+
+    // Resolve branches to instruction indices
+    top = -1;
+    for (idx=first; idx<=function->end_addr; idx++) {
+        Instr *in = &m->code[idx];
+        switch (in->opcode) {
+        case 0x02 ... 0x04:  // block, loop, if
+            blockstack[++top] = in->imm.block;
+            break;
+        case 0x05:  // else: to end of if
+            if (top >= 0) { in->imm.uint32 = blockstack[top]->br_addr; }
+            break;
+        case 0x0b:  // end
+            top--;
+            break;
+        case 0x0c:  // br
+        case 0x0d:  // br_if
+            in->imm.uint32 = branch_target(function, blockstack, top, in->arg);
+            break;
+        case 0x0e:  // br_table
+            for (uint32_t i=0; i<=in->arg; i++) {
+                in->imm.targets[2*i+1] = branch_target(function, blockstack,
+                                                       top,
+                                                       in->imm.targets[2*i]);
+            }
+            break;
+        case 0x0f:  // return: branch out of all blocks to end of function
+            in->arg = top+1;
+            in->imm.uint32 = function->end_addr;
+            break;
+        }
+    }
+}
 
-        ASSERT(top == -1, "Function ended in middle of block\n")
-        ASSERT(opcode == 0x0b, "Function block did not end with 0xb\n")
+void decode_module(Module *m) {
+    uint32_t capacity = 0;
+    info("  decode_module: function_count: %d\n", m->function_count);
+    for (uint32_t f=m->import_count; f<m->function_count; f++) {
+        debug("    fidx: 0x%x, start: 0x%x, end: 0x%x\n",
+               f, m->functions[f].start_addr, m->functions[f].end_addr);
+        decode_function(m, &m->functions[f], &capacity);
     }
+    info("  decode_module: %d instructions, %d blocks\n",
+         m->code_count, m->block_count);
 }
 
 
@@ -499,115 +579,8 @@ Block *pop_block(Module *m) {
     return frame->block;
 }
 
-//
-// Outbound Thunks (calling imported functions)
-//
-
-uint64_t get_thunk_mask(Module *m, uint32_t fidx) {
-    Type  *type = m->functions[fidx].type;
-    uint64_t  thunk_mask = 0x80;
-
-    if (type->result_count == 1) {
-        thunk_mask |= 0x80 - type->results[0];
-    }
-    thunk_mask = thunk_mask << 4;
-    for(int p=0; p<type->param_count; p++) {
-        thunk_mask = ((uint64_t)thunk_mask) << 4;
-        thunk_mask |= 0x80 - type->params[p];
-    }
-
-    return thunk_mask;
-}
-
-void thunk_out(Module *m, uint32_t fidx) {
-    Block    *func = &m->functions[fidx];
-    Type     *type = func->type;
-    uint64_t  thunk_mask = get_thunk_mask(m, fidx);
-    if (TRACE) {
-        warn("  >>> thunk_out 0x%x(%d) %s.%s(",
-             func->fidx, func->fidx,
-             func->import_module, func->import_field);
-        for (int p=type->param_count-1; p >= 0; p--) {
-            warn("%s%s", value_repr(&m->stack[m->sp-p]), p ? " " : "");
-        }
-        warn("), %d results\n", type->result_count);
-        debug("      thunk_mask: 0x%x\n", thunk_mask);
-    }
-
-    switch (thunk_mask) {
-    case 0x800       : thunk_out_0_0      (m, func, type); break;
-    case 0x8001      : thunk_out_0_i      (m, func, type); break;
-    case 0x80011     : thunk_out_0_ii     (m, func, type); break;
-    case 0x8001111   : thunk_out_0_iiii   (m, func, type); break;
-    case 0x810       : thunk_out_i_0      (m, func, type); break;
-    case 0x8101      : thunk_out_i_i      (m, func, type); break;
-    case 0x81011     : thunk_out_i_ii     (m, func, type); break;
-    case 0x810111    : thunk_out_i_iii    (m, func, type); break;
-    case 0x8101111   : thunk_out_i_iiii   (m, func, type); break;
-    case 0x81011111  : thunk_out_i_iiiii  (m, func, type); break;
-    case 0x80033     : thunk_out_0_ff     (m, func, type); break;
-    case 0x800333    : thunk_out_0_fff    (m, func, type); break;
-    case 0x8003333   : thunk_out_0_ffff   (m, func, type); break;
-    case 0x8303      : thunk_out_f_f      (m, func, type); break;
-    case 0x800444444 : thunk_out_0_FFFFFF (m, func, type); break;
-    case 0x8103      : thunk_out_i_f      (m, func, type); break;
-    case 0x8404      : thunk_out_F_F      (m, func, type); break;
-    default: FATAL("unsupported thunk_out mask 0x%llx\n", thunk_mask);
-    }
-
-    if (TRACE) {
-        warn("  <<< thunk_out 0x%x(%d) %s.%s = %s\n",
-             func->fidx, func->fidx, func->import_module, func->import_field,
-             type->result_count > 0 ? value_repr(&m->stack[m->sp]) : "_");
-    }
-}
-
-
-//
-// Inbound Thunks (external calls into exported functions)
-//
-
-Module * _wa_current_module_;
-
-void setup_call(Module *m, uint32_t fidx);
-
-// Push arguments
-// return function pointer to thunk_in_* function
-void (*setup_thunk_in(uint32_t fidx))() {
-    Module   *m = _wa_current_module_; // TODO: global state, clean up somehow
-    Block    *func = &m->functions[fidx];
-    Type     *type = func->type;
-    uint64_t  thunk_mask = get_thunk_mask(m, fidx);
-
-    // Make space on the stack
-    m->sp += type->param_count;
-
-    if (TRACE) {
-        warn("  {{}} setup_thunk_in '%s', mask: 0x%x, ARGS FOR '>>' ARE BOGUS\n",
-             func->export_name, thunk_mask);
-    }
-
-    // Do normal function call setup. The fp will point to the start of stack
-    // elements that were just added above
-    setup_call(m, fidx);
-
-    // Set the type of the unset stack elements
-    for(int p=0; p<type->param_count; p++) {
-        m->stack[m->fp+p].value_type = type->params[p];
-    }
-
-    // Return the thunk_in function
-    void (*f)(void);
-    switch (thunk_mask) {
-    case 0x800      : f = (void (*)(void)) thunk_in_0_0; break;
-    case 0x8101     : f = (void (*)(void)) thunk_in_i_i; break;
-    case 0x80011    : f = (void (*)(void)) thunk_in_0_ii; break;
-    default: FATAL("unsupported thunk_in mask 0x%llx\n", thunk_mask);
-    }
-
-    return f;
-}
-
+// module run by this thread, read by the thunks
+__thread Module * _wa_current_module_;
 
 // Setup a function
 // Push params and locals on the stack and save a call frame on the call stack
@@ -646,851 +619,875 @@ void setup_call(Module *m, uint32_t fidx) {
     return;
 }
 
+// Run the pre-decoded code from m->pc until the function at the bottom of
+// the callstack returns. Dispatch is threaded: every handler jumps
+// directly to the handler of the next instruction through the dispatch
+// table. pc, sp and fp are kept in locals and written back to m around
+// the calls that use them.
 bool interpret(Module *m) {
-    uint8_t     *bytes = m->bytes;
+    static const void *dispatch[256];
+
+    Instr       *code = m->code;
     StackValue  *stack = m->stack;
+    Instr       *ip;
+    uint32_t     pc = m->pc;
+    int          sp = m->sp;
+    int          fp = m->fp;
+    bool         bounds = !m->options.disable_memory_bounds;
+    uint64_t     mem_size = (uint64_t)m->memory.pages*WA_PAGE_SIZE;
 
-    uint32_t     cur_pc;
     Block       *block;
-    uint32_t     arg, val, fidx, tidx, cond, depth, count;
-    uint32_t     flags, offset, addr;
-    uint8_t     *maddr, *mem_end;
-    uint32_t    *depths;
-    uint8_t      opcode;
+    Frame       *frame;
+    uint32_t    *targets;
+    uint32_t     val, fidx, cond, addr;
+    uint64_t     ea;
+    uint8_t     *maddr;
+    StackValue  *sval;
     uint32_t     a, b, c; // I32 math
     uint64_t     d, e, f; // I64 math
-    float        g, h, i; // F32 math
-    double       j, k, l; // F64 math
-    bool         overflow = false;
+    float        g, h;    // F32 math
+    double       j, k;    // F64 math
+
+#define SAVE() { m->pc = pc; m->sp = sp; m->fp = fp; }
+#define LOAD() { pc = m->pc; sp = m->sp; fp = m->fp; \
+                 mem_size = (uint64_t)m->memory.pages*WA_PAGE_SIZE; }
+#define NEXT() { \
+    ip = &code[pc++]; \
+    if (TRACE) { \
+        SAVE(); \
+        if (DEBUG) { dump_stacks(m); } \
+        info("    0x%x <0x%x/%s>\n", pc-1, ip->opcode, \
+             ip->opcode <= 0xbf ? OPERATOR_INFO[ip->opcode] : "?"); \
+    } \
+    goto *dispatch[ip->opcode]; \
+}
+#define TRAP(...) { \
+    snprintf(exception, 1024, __VA_ARGS__); \
+    SAVE(); \
+    return false; \
+}
+#define PUSH_BLOCK(b) { \
+    if (m->csp+1 >= CALLSTACK_SIZE) { TRAP("call stack exhausted"); } \
+    frame = &m->callstack[++m->csp]; \
+    frame->block = (b); \
+    frame->sp = sp; \
+    frame->fp = fp; \
+    frame->ra = pc; \
+}
+#define BOUNDS(size) { \
+    ea = (uint64_t)addr + ip->arg; \
+    if (bounds && ea+(size) > mem_size) { \
+        warn("memory start: %p, memory size: 0x%llx, addr: 0x%x," \
+             " offset: 0x%x\n", m->memory.bytes, mem_size, addr, ip->arg); \
+        TRAP("out of bounds memory access"); \
+    } \
+    maddr = m->memory.bytes+ea; \
+}
 
-    while (m->pc < m->byte_count) {
-        opcode = bytes[m->pc];
-        cur_pc = m->pc;
-        m->pc += 1;
+    if (!dispatch[0x0b]) {
+        for (int o=0; o<256; o++) { dispatch[o] = &&op_unknown; }
+        dispatch[0x00] = &&op_unreachable;
+        dispatch[0x01] = &&op_nop;
+        dispatch[0x02] = &&op_block;
+        dispatch[0x03] = &&op_block;
+        dispatch[0x04] = &&op_if;
+        dispatch[0x05] = &&op_else;
+        dispatch[0x0b] = &&op_end;
+        dispatch[0x0c] = &&op_br;
+        dispatch[0x0d] = &&op_br_if;
+        dispatch[0x0e] = &&op_br_table;
+        dispatch[0x0f] = &&op_return;
+        dispatch[0x10] = &&op_call;
+        dispatch[0x11] = &&op_call_indirect;
+        dispatch[0x1a] = &&op_drop;
+        dispatch[0x1b] = &&op_select;
+        dispatch[0x20] = &&op_get_local;
+        dispatch[0x21] = &&op_set_local;
+        dispatch[0x22] = &&op_tee_local;
+        dispatch[0x23] = &&op_get_global;
+        dispatch[0x24] = &&op_set_global;
+        dispatch[0x28] = &&op_i32_load;
+        dispatch[0x29] = &&op_i64_load;
+        dispatch[0x2a] = &&op_f32_load;
+        dispatch[0x2b] = &&op_f64_load;
+        dispatch[0x2c] = &&op_i32_load8_s;
+        dispatch[0x2d] = &&op_i32_load8_u;
+        dispatch[0x2e] = &&op_i32_load16_s;
+        dispatch[0x2f] = &&op_i32_load16_u;
+        dispatch[0x30] = &&op_i64_load8_s;
+        dispatch[0x31] = &&op_i64_load8_u;
+        dispatch[0x32] = &&op_i64_load16_s;
+        dispatch[0x33] = &&op_i64_load16_u;
+        dispatch[0x34] = &&op_i64_load32_s;
+        dispatch[0x35] = &&op_i64_load32_u;
+        dispatch[0x36] = &&op_store32;  // i32.store
+        dispatch[0x37] = &&op_store64;  // i64.store
+        dispatch[0x38] = &&op_store32;  // f32.store
+        dispatch[0x39] = &&op_store64;  // f64.store
+        dispatch[0x3a] = &&op_store8;   // i32.store8
+        dispatch[0x3b] = &&op_store16;  // i32.store16
+        dispatch[0x3c] = &&op_store8;   // i64.store8
+        dispatch[0x3d] = &&op_store16;  // i64.store16
+        dispatch[0x3e] = &&op_store32;  // i64.store32
+        dispatch[0x3f] = &&op_current_memory;
+        dispatch[0x40] = &&op_grow_memory;
+        dispatch[0x41] = &&op_i32_const;
+        dispatch[0x42] = &&op_i64_const;
+        dispatch[0x43] = &&op_f32_const;
+        dispatch[0x44] = &&op_f64_const;
+        dispatch[0x45] = &&op_i32_eqz;
+        dispatch[0x46] = &&op_i32_eq;
+        dispatch[0x47] = &&op_i32_ne;
+        dispatch[0x48] = &&op_i32_lt_s;
+        dispatch[0x49] = &&op_i32_lt_u;
+        dispatch[0x4a] = &&op_i32_gt_s;
+        dispatch[0x4b] = &&op_i32_gt_u;
+        dispatch[0x4c] = &&op_i32_le_s;
+        dispatch[0x4d] = &&op_i32_le_u;
+        dispatch[0x4e] = &&op_i32_ge_s;
+        dispatch[0x4f] = &&op_i32_ge_u;
+        dispatch[0x50] = &&op_i64_eqz;
+        dispatch[0x51] = &&op_i64_eq;
+        dispatch[0x52] = &&op_i64_ne;
+        dispatch[0x53] = &&op_i64_lt_s;
+        dispatch[0x54] = &&op_i64_lt_u;
+        dispatch[0x55] = &&op_i64_gt_s;
+        dispatch[0x56] = &&op_i64_gt_u;
+        dispatch[0x57] = &&op_i64_le_s;
+        dispatch[0x58] = &&op_i64_le_u;
+        dispatch[0x59] = &&op_i64_ge_s;
+        dispatch[0x5a] = &&op_i64_ge_u;
+        dispatch[0x5b] = &&op_f32_eq;
+        dispatch[0x5c] = &&op_f32_ne;
+        dispatch[0x5d] = &&op_f32_lt;
+        dispatch[0x5e] = &&op_f32_gt;
+        dispatch[0x5f] = &&op_f32_le;
+        dispatch[0x60] = &&op_f32_ge;
+        dispatch[0x61] = &&op_f64_eq;
+        dispatch[0x62] = &&op_f64_ne;
+        dispatch[0x63] = &&op_f64_lt;
+        dispatch[0x64] = &&op_f64_gt;
+        dispatch[0x65] = &&op_f64_le;
+        dispatch[0x66] = &&op_f64_ge;
+        dispatch[0x67] = &&op_i32_clz;
+        dispatch[0x68] = &&op_i32_ctz;
+        dispatch[0x69] = &&op_i32_popcnt;
+        dispatch[0x6a] = &&op_i32_add;
+        dispatch[0x6b] = &&op_i32_sub;
+        dispatch[0x6c] = &&op_i32_mul;
+        dispatch[0x6d] = &&op_i32_div_s;
+        dispatch[0x6e] = &&op_i32_div_u;
+        dispatch[0x6f] = &&op_i32_rem_s;
+        dispatch[0x70] = &&op_i32_rem_u;
+        dispatch[0x71] = &&op_i32_and;
+        dispatch[0x72] = &&op_i32_or;
+        dispatch[0x73] = &&op_i32_xor;
+        dispatch[0x74] = &&op_i32_shl;
+        dispatch[0x75] = &&op_i32_shr_s;
+        dispatch[0x76] = &&op_i32_shr_u;
+        dispatch[0x77] = &&op_i32_rotl;
+        dispatch[0x78] = &&op_i32_rotr;
+        dispatch[0x79] = &&op_i64_clz;
+        dispatch[0x7a] = &&op_i64_ctz;
+        dispatch[0x7b] = &&op_i64_popcnt;
+        dispatch[0x7c] = &&op_i64_add;
+        dispatch[0x7d] = &&op_i64_sub;
+        dispatch[0x7e] = &&op_i64_mul;
+        dispatch[0x7f] = &&op_i64_div_s;
+        dispatch[0x80] = &&op_i64_div_u;
+        dispatch[0x81] = &&op_i64_rem_s;
+        dispatch[0x82] = &&op_i64_rem_u;
+        dispatch[0x83] = &&op_i64_and;
+        dispatch[0x84] = &&op_i64_or;
+        dispatch[0x85] = &&op_i64_xor;
+        dispatch[0x86] = &&op_i64_shl;
+        dispatch[0x87] = &&op_i64_shr_s;
+        dispatch[0x88] = &&op_i64_shr_u;
+        dispatch[0x89] = &&op_i64_rotl;
+        dispatch[0x8a] = &&op_i64_rotr;
+        dispatch[0x8b] = &&op_f32_abs;
+        dispatch[0x8c] = &&op_f32_neg;
+        dispatch[0x8d] = &&op_f32_ceil;
+        dispatch[0x8e] = &&op_f32_floor;
+        dispatch[0x8f] = &&op_f32_trunc;
+        dispatch[0x90] = &&op_f32_nearest;
+        dispatch[0x91] = &&op_f32_sqrt;
+        dispatch[0x92] = &&op_f32_add;
+        dispatch[0x93] = &&op_f32_sub;
+        dispatch[0x94] = &&op_f32_mul;
+        dispatch[0x95] = &&op_f32_div;
+        dispatch[0x96] = &&op_f32_min;
+        dispatch[0x97] = &&op_f32_max;
+        dispatch[0x98] = &&op_f32_copysign;
+        dispatch[0x99] = &&op_f64_abs;
+        dispatch[0x9a] = &&op_f64_neg;
+        dispatch[0x9b] = &&op_f64_ceil;
+        dispatch[0x9c] = &&op_f64_floor;
+        dispatch[0x9d] = &&op_f64_trunc;
+        dispatch[0x9e] = &&op_f64_nearest;
+        dispatch[0x9f] = &&op_f64_sqrt;
+        dispatch[0xa0] = &&op_f64_add;
+        dispatch[0xa1] = &&op_f64_sub;
+        dispatch[0xa2] = &&op_f64_mul;
+        dispatch[0xa3] = &&op_f64_div;
+        dispatch[0xa4] = &&op_f64_min;
+        dispatch[0xa5] = &&op_f64_max;
+        dispatch[0xa6] = &&op_f64_copysign;
+        dispatch[0xa7] = &&op_i32_wrap_i64;
+        dispatch[0xa8] = &&op_i32_trunc_s_f32;
+        dispatch[0xa9] = &&op_i32_trunc_u_f32;
+        dispatch[0xaa] = &&op_i32_trunc_s_f64;
+        dispatch[0xab] = &&op_i32_trunc_u_f64;
+        dispatch[0xac] = &&op_i64_extend_s_i32;
+        dispatch[0xad] = &&op_i64_extend_u_i32;
+        dispatch[0xae] = &&op_i64_trunc_s_f32;
+        dispatch[0xaf] = &&op_i64_trunc_u_f32;
+        dispatch[0xb0] = &&op_i64_trunc_s_f64;
+        dispatch[0xb1] = &&op_i64_trunc_u_f64;
+        dispatch[0xb2] = &&op_f32_convert_s_i32;
+        dispatch[0xb3] = &&op_f32_convert_u_i32;
+        dispatch[0xb4] = &&op_f32_convert_s_i64;
+        dispatch[0xb5] = &&op_f32_convert_u_i64;
+        dispatch[0xb6] = &&op_f32_demote_f64;
+        dispatch[0xb7] = &&op_f64_convert_s_i32;
+        dispatch[0xb8] = &&op_f64_convert_u_i32;
+        dispatch[0xb9] = &&op_f64_convert_s_i64;
+        dispatch[0xba] = &&op_f64_convert_u_i64;
+        dispatch[0xbb] = &&op_f64_promote_f32;
+        dispatch[0xbc] = &&op_i32_reinterpret_f32;
+        dispatch[0xbd] = &&op_i64_reinterpret_f64;
+        dispatch[0xbe] = &&op_f32_reinterpret_i32;
+        dispatch[0xbf] = &&op_f64_reinterpret_i64;
+    }
+
+    NEXT();
 
+    //
+    // Control flow operators
+    //
+op_unreachable:
+    TRAP("%s", "unreachable");
+op_nop:
+    NEXT();
+op_block:   // block, loop
+    PUSH_BLOCK(ip->imm.block);
+    NEXT();
+op_if:
+    block = ip->imm.block;
+    cond = stack[sp--].value.uint32;
+    PUSH_BLOCK(block);
+    if (cond == 0) { // if false (I32)
+        // branch to else block or after end of if
+        if (block->else_addr == 0) {
+            // no else block, pop if block and skip end
+            m->csp -= 1;
+            pc = block->br_addr+1;
+        } else {
+            pc = block->else_addr;
+        }
+    }
+    // if true, keep going
+    if (TRACE) {
+        debug("      - cond: 0x%x jump to 0x%x, block: %s\n",
+               cond, pc, block_repr(block));
+    }
+    NEXT();
+op_else:
+    pc = ip->imm.uint32;
+    NEXT();
+op_end:
+    frame = &m->callstack[m->csp--];
+    block = frame->block;
+    fp = frame->fp; // Restore frame pointer
+    // Validate the result and restore the stack pointer
+    if (block->type->result_count == 1) {
+        if (stack[sp].value_type != block->type->results[0]) {
+            TRAP("call signature mismatch");
+        }
+        if (frame->sp < sp) {
+            // Save top value as result
+            stack[frame->sp+1] = stack[sp];
+            sp = frame->sp+1;
+        }
+    } else if (frame->sp < sp) {
+        sp = frame->sp;
+    }
+    if (TRACE) { debug("      - of %s\n", block_repr(block)); }
+    if (block->block_type == 0x00) { // Function
         if (TRACE) {
-            if (DEBUG) { dump_stacks(m); }
-            info("    0x%x <0x%x/%s>\n", cur_pc, opcode, OPERATOR_INFO[opcode]);
+            warn("  << fn0x%x(%d) %s = %s\n",
+                 block->fidx, block->fidx,
+                 block->export_name ? block->export_name : "",
+                 block->type->result_count > 0 ?
+                   value_repr(&stack[sp]) : "_");
         }
-        //printf("going around the loop, opcode %x\n", opcode);
-        switch (opcode) {
-
-        //
-        // Control flow operators
-        //
-        case 0x00:  // unreachable
-            snprintf(exception, 1024, "%s", "unreachable");
-            return false;
-        case 0x01:  // nop
-            continue;
-        case 0x02:  // block
-            read_LEB(bytes, &m->pc, 32);  // ignore block type
-            push_block(m, m->block_lookup[cur_pc], m->sp);
-            continue;
-        case 0x03:  // loop
-            read_LEB(bytes, &m->pc, 32);  // ignore block type
-            push_block(m, m->block_lookup[cur_pc], m->sp);
-            continue;
-        case 0x04:  // if
-        {
-            read_LEB(bytes, &m->pc, 32);  // ignore block type
-            Block *block = m->block_lookup[cur_pc];
-            push_block(m, block, m->sp);
-
-            cond = stack[m->sp--].value.uint32;
-            if (cond == 0) { // if false (I32)
-                // branch to else block or after end of if
-                if (block->else_addr == 0) {
-                    // no else block, pop if block and skip end
-                    m->csp -= 1;
-                    m->pc = block->br_addr+1;
-                } else {
-                    m->pc = block->else_addr;
-                }
-            }
-            // if true, keep going
-            if (TRACE) {
-                debug("      - cond: 0x%x jump to 0x%x, block: %s\n",
-                       cond, m->pc, block_repr(block));
-            }
+        pc = frame->ra;
+        if (m->csp == -1) {
+            // Return to top-level
+            SAVE();
+            return true;
         }
-            continue;
-        case 0x05:  // else
-            block = m->callstack[m->csp].block;
-            m->pc = block->br_addr;
-            if (TRACE) {
-                debug("      - of %s jump to 0x%x\n", block_repr(block), m->pc);
-            }
-            continue;
-        case 0x0b:  // end
-            block = pop_block(m);
-            if (block == NULL) {
-                return false; // an exception (set by pop_block)
-            }
-            if (TRACE) { debug("      - of %s\n", block_repr(block)); }
-            if (block->block_type == 0x00) { // Function
-                if (TRACE) {
-                 warn("  << fn0x%x(%d) %s = %s\n",
-                      block->fidx, block->fidx,
-                      block->export_name ? block->export_name : "",
-                      block->type->result_count > 0 ?
-                        value_repr(&m->stack[m->sp]) :
-                        "_");
-                }
-                if (m->csp == -1) {
-                                                        //printf("csp1\n");
-                    // Return to top-level
-                    return true;
-                } else {
-                    // Keep going at return address
-                }
-            } else if (block->block_type == 0x01) { // init_expr
-
-                return true;
-            } else {  // Block
-                // End of block/loop/if, keep going
-            }
-            continue;
-        case 0x0c:  // br
-            depth = read_LEB(bytes, &m->pc, 32);
-            m->csp -= depth;
-            // set to end for pop_block
-            m->pc = m->callstack[m->csp].block->br_addr;
-            if (TRACE) { debug("      - to: 0x%x\n", &m->pc); }
-            continue;
-        case 0x0d:  // br_if
-            depth = read_LEB(bytes, &m->pc, 32);
-
-            cond = stack[m->sp--].value.uint32;
-            if (cond) { // if true
-                m->csp -= depth;
-                // set to end for pop_block
-                m->pc = m->callstack[m->csp].block->br_addr;
-            }
-            if (TRACE) { debug("      - depth: 0x%x, cond: 0x%x, to: 0x%x\n", depth, cond, m->pc); }
-            continue;
-        case 0x0e:  // br_table
-        {
-            count = read_LEB(bytes, &m->pc, 32);
-            depths = (uint32_t*) acalloc(count, sizeof(uint32_t), "uint32_t");
-            for(uint32_t i=0; i<count; i++) {
-                depths[i] = read_LEB(bytes, &m->pc, 32);
-            }
-            depth = read_LEB(bytes, &m->pc, 32);
+        // Keep going at return address
+    }
+    NEXT();
+op_br:
+    m->csp -= ip->arg;
+    // set to end for the end handler
+    pc = ip->imm.uint32;
+    NEXT();
+op_br_if:
+    cond = stack[sp--].value.uint32;
+    if (cond) { // if true
+        m->csp -= ip->arg;
+        pc = ip->imm.uint32;
+    }
+    NEXT();
+op_br_table:
+    targets = ip->imm.targets;
+    val = stack[sp--].value.uint32;
+    if (val > ip->arg) {
+        val = ip->arg;  // default target
+    }
+    m->csp -= targets[2*val];
+    pc = targets[2*val+1];
+    NEXT();
+op_return:
+    // Leave the blocks of the function. The end of the function pops the
+    // function frame and returns.
+    m->csp -= ip->arg;
+    pc = ip->imm.uint32;
+    NEXT();
+
+    //
+    // Call operators
+    //
+op_call:
+    fidx = ip->arg;
+    SAVE();
+    if (fidx < m->import_count) {
+        // import/thunk call
+        if (!thunk_out(m, fidx)) { return false; }
+    } else {
+        if (m->csp+1 >= CALLSTACK_SIZE) { TRAP("call stack exhausted"); }
+        setup_call(m, fidx);  // regular function call
+    }
+    LOAD();
+    NEXT();
+op_call_indirect:
+    val = stack[sp--].value.uint32;
+    if (m->options.mangle_table_index) {
+        // val is the table address + the index (not sized for the
+        // pointer size) so get the actual (sized) index
+        val = (uint32_t*)val - m->table.entries;
+    }
+    if (val >= m->table.maximum) {
+        TRAP("undefined element 0x%x", val);
+    }
 
-            int32_t didx = stack[m->sp--].value.uint32;
-            if (didx >= 0 && didx < count) {
-                depth = depths[didx];
-            }
-            free(depths);
+    fidx = m->table.entries[val];
+    if (TRACE) {
+        debug("       - call_indirect tidx: %d, val: 0x%x, fidx: 0x%x\n",
+              ip->arg, val, fidx);
+    }
 
-            m->csp -= depth;
-            // set to end for pop_block
-            m->pc = m->callstack[m->csp].block->br_addr;
-            if (TRACE) {
-                debug("      - count: %d, didx: %d, to: 0x%x\n", count, didx, m->pc);
-            }
+    SAVE();
+    if (fidx < m->import_count) {
+        // import/thunk call
+        if (!thunk_out(m, fidx)) { return false; }
+    } else {
+        if (m->csp+1 >= CALLSTACK_SIZE) { TRAP("call stack exhausted"); }
+        setup_call(m, fidx);   // regular function call
+
+        Block *func = &m->functions[fidx];
+        Type *ftype = func->type;
+        // Validate signatures match
+        if (ftype->param_count + func->local_count != m->sp - m->fp + 1) {
+            snprintf(exception, 1024, "indirect call signature mismatch");
+            return false;
         }
-            continue;
-        case 0x0f:  // return
-            while (m->csp >= 0 &&
-                   m->callstack[m->csp].block->block_type != 0x00) {
-                m->csp--;
-            }
-            // Set the program count to the end of the function
-            // The actual pop_block and return is handled by the end opcode.
-            m->pc = m->callstack[0].block->end_addr;
-            if (TRACE) {
-                debug("      - to: 0x%x\n", m->pc);
-            }
-            continue;
-
-
-        //
-        // Call operators
-        //
-        case 0x10:  // call
-            fidx = read_LEB(bytes, &m->pc, 32);
-
-            if (fidx < m->import_count) {
-                thunk_out(m, fidx);   // import/thunk call
-            } else {
-                setup_call(m, fidx);  // regular function call
-                if (TRACE) {
-                    debug("      - calling function fidx: %d at: 0x%x\n", fidx, m->pc);
-                }
-            }
-            continue;
-        case 0x11:  // call_indirect
-            tidx = read_LEB(bytes, &m->pc, 32); // TODO: use tidx?
-            read_LEB(bytes, &m->pc, 1); // reserved immediate
-            val = stack[m->sp--].value.uint32;
-            if (m->options.mangle_table_index) {
-                // val is the table address + the index (not sized for the
-                // pointer size) so get the actual (sized) index
-                if (TRACE) {
-                    debug("      - entries: %p, original val: 0x%x, new val: 0x%x\n",
-                        m->table.entries, val, m->table.entries - (uint32_t*)val);
-                }
-                val = (uint32_t*)val - m->table.entries;
-            }
-            if (val < 0 || val >= m->table.maximum) {
-                snprintf(exception, 1024, "undefined element 0x%x", val);
+        for (uint32_t p=0; p<ftype->param_count; p++) {
+            if (ftype->params[p] != m->stack[m->fp+p].value_type) {
+                snprintf(exception, 1024, "indirect call signature mismatch");
                 return false;
             }
-
-            fidx = m->table.entries[val];
-            if (TRACE) {
-                debug("       - call_indirect tidx: %d, val: 0x%x, fidx: 0x%x\n",
-                      tidx, val, fidx);
-            }
-
-            if (fidx < m->import_count) {
-                thunk_out(m, fidx);    // import/thunk call
-            } else {
-                setup_call(m, fidx);   // regular function call
-
-                Block *func = &m->functions[fidx];
-                Type *ftype = func->type;
-                // Validate signatures match
-                if (ftype->param_count + func->local_count != m->sp - m->fp + 1) {
-                    snprintf(exception, 1024, "indirect call signature mismatch");
-                    return false;
-                }
-                for (uint32_t f=0; f<ftype->param_count; f++) {
-                    if (ftype->params[f] != m->stack[m->fp+f].value_type) {
-                        snprintf(exception, 1024, "indirect call signature mismatch");
-                        return false;
-                    }
-                }
-
-                if (TRACE) {
-                    debug("      - tidx: %d, table idx: %d, "
-                          "calling function fidx: %d at: 0x%x\n",
-                        tidx, val, fidx, m->pc);
-                }
-            }
-            continue;
-
-        //
-        // Parametric operators
-        //
-        case 0x1a:  // drop
-            m->sp--;
-            continue;
-        case 0x1b:  // select
-            cond = stack[m->sp--].value.uint32;
-            m->sp--;
-            if (!cond) {  // use a instead of b
-                stack[m->sp] = stack[m->sp+1];
-            }
-            continue;
-
-
-        //
-        // Variable access
-        //
-        case 0x20:  // get_local
-            arg = read_LEB(bytes, &m->pc, 32);
-            if (TRACE) {
-                debug("      - arg: 0x%x, got %s\n",
-                       arg, value_repr(&stack[m->fp+arg]));
-            }
-            stack[++m->sp] = stack[m->fp+arg];
-            continue;
-        case 0x21:  // set_local
-            arg = read_LEB(bytes, &m->pc, 32);
-            stack[m->fp+arg] = stack[m->sp--];
-            if (TRACE) {
-                debug("      - arg: 0x%x, to %s\n",
-                       arg, value_repr(&stack[m->sp]));
-            }
-            continue;
-        case 0x22:  // tee_local
-            arg = read_LEB(bytes, &m->pc, 32);
-            stack[m->fp+arg] = stack[m->sp];
-            if (TRACE) {
-                debug("      - arg: 0x%x, to %s\n",
-                       arg, value_repr(&stack[m->sp]));
-            }
-            continue;
-        case 0x23:  // get_global
-            arg = read_LEB(bytes, &m->pc, 32);
-            if (TRACE) {
-                debug("      - arg: 0x%x, got %s\n",
-                       arg, value_repr(&m->globals[arg]));
-            }
-            stack[++m->sp] = m->globals[arg];
-            continue;
-        case 0x24:  // set_global
-            arg = read_LEB(bytes, &m->pc, 32);
-            m->globals[arg] = stack[m->sp--];
-            if (TRACE) {
-                debug("      - arg: 0x%x, to %s\n",
-                       arg, value_repr(&m->globals[arg]));
-            }
-            continue;
-
-        //
-        // Memory-related operators
-        //
-        case 0x3f:  // current_memory
-            read_LEB(bytes, &m->pc, 32); // ignore reserved
-            stack[++m->sp].value_type = I32;
-            stack[m->sp].value.uint32 = m->memory.pages;
-            continue;
-        case 0x40:  // grow_memory
-        {
-            read_LEB(bytes, &m->pc, 32); // ignore reserved
-            uint32_t prev_pages = m->memory.pages;
-            uint32_t delta = stack[m->sp].value.uint32;
-            stack[m->sp].value.uint32 = prev_pages;
-            if (delta == 0) {
-                continue; // No change
-            } else if (delta+prev_pages > m->memory.maximum) {
-                stack[m->sp].value.uint32 = -1;
-                continue;
-            }
-            m->memory.pages += delta;
-            m->memory.bytes = (uint8_t*) arecalloc(m->memory.bytes,
-                                        prev_pages*pow(2,16),
-                                        m->memory.pages*pow(2,16),
-                                        sizeof(uint32_t),
-                                        "Module->memory.bytes");
         }
-            continue;
-
-        // Memory load operators
-        case 0x28 ... 0x35:
-            flags = read_LEB(bytes, &m->pc, 32);
-            offset = read_LEB(bytes, &m->pc, 32);
-            addr = stack[m->sp--].value.uint32;
-            if (flags != 2 && TRACE) {
-                info("      - unaligned load - flags: 0x%x,"
-                      " offset: 0x%x, addr: 0x%x\n",
-                      flags, offset, addr);
-            }
-            if (offset+addr < addr) { overflow = true; }
-            maddr = m->memory.bytes+offset+addr;
-            if (maddr < m->memory.bytes) { overflow = true; }
-            mem_end = m->memory.bytes+m->memory.pages*(uint32_t)pow(2,16);
-            if (maddr+LOAD_SIZE[opcode-0x28] > mem_end) {
-                overflow = true;
-            }
-            info("      - addr: 0x%x, offset: 0x%x, maddr: %p, mem_end: %p\n",
-                 addr, offset, maddr, mem_end);
-            if (!m->options.disable_memory_bounds) {
-                if (overflow) {
-                    warn("memory start: %p, memory end: %p, maddr: %p\n",
-                        m->memory.bytes, mem_end, maddr);
-                    snprintf(exception, 1024,"out of bounds memory access");
-                    return false;
-                }
-            }
-            stack[++m->sp].value.uint64 = 0; // initialize to 0
-            switch (opcode) {
-            case 0x28: memcpy(&stack[m->sp].value, maddr, 4);
-                       stack[m->sp].value_type = I32; break; // i32.load
-            case 0x29: memcpy(&stack[m->sp].value, maddr, 8);
-                       stack[m->sp].value_type = I64; break; // i64.load
-            case 0x2a: memcpy(&stack[m->sp].value, maddr, 4);
-                       stack[m->sp].value_type = F32; break; // f32.load
-            case 0x2b: memcpy(&stack[m->sp].value, maddr, 8);
-                       stack[m->sp].value_type = F64; break; // f64.load
-            case 0x2c: memcpy(&stack[m->sp].value, maddr, 1);
-                       sext_8_32(&stack[m->sp].value.uint32);
-                       stack[m->sp].value_type = I32;
-                       break; // i32.load8_s
-            case 0x2d: memcpy(&stack[m->sp].value, maddr, 1);
-                       stack[m->sp].value_type = I32; break; // i32.load8_u
-            case 0x2e: memcpy(&stack[m->sp].value, maddr, 2);
-                       sext_16_32(&stack[m->sp].value.uint32);
-                       stack[m->sp].value_type = I32; break; // i32.load16_s
-            case 0x2f: memcpy(&stack[m->sp].value, maddr, 2);
-                       stack[m->sp].value_type = I32; break; // i32.load16_u
-            case 0x30: memcpy(&stack[m->sp].value, maddr, 1);
-                       sext_8_64(&stack[m->sp].value.uint64);
-                       stack[m->sp].value_type = I64; break; // i64.load8_s
-            case 0x31: memcpy(&stack[m->sp].value, maddr, 1);
-                       stack[m->sp].value_type = I64; break; // i64.load8_u
-            case 0x32: memcpy(&stack[m->sp].value, maddr, 2);
-                       sext_16_64(&stack[m->sp].value.uint64);
-                       stack[m->sp].value_type = I64; break; // i64.load16_s
-            case 0x33: memcpy(&stack[m->sp].value, maddr, 2);
-                       stack[m->sp].value_type = I64; break; // i64.load16_u
-            case 0x34: memcpy(&stack[m->sp].value, maddr, 4);
-                       sext_32_64(&stack[m->sp].value.uint64);
-                       stack[m->sp].value_type = I64; break; // i64.load32_s
-            case 0x35: memcpy(&stack[m->sp].value, maddr, 4);
-                       stack[m->sp].value_type = I64; break; // i64.load32_u
-            }
-            continue;
-
-        // Memory store operators
-        case 0x36 ... 0x3e:
-        {
-            flags = read_LEB(bytes, &m->pc, 32);
-            offset = read_LEB(bytes, &m->pc, 32);
-            StackValue *sval = &stack[m->sp--];
-            addr = stack[m->sp--].value.uint32;
-            if (flags != 2 && TRACE) {
-                info("      - unaligned store - flags: 0x%x,"
-                      " offset: 0x%x, addr: 0x%x, val: %s\n",
-                      flags, offset, addr, value_repr(sval));
-            }
-            if (offset+addr < addr) { overflow = true; }
-            maddr = m->memory.bytes+offset+addr;
-            if (maddr < m->memory.bytes) { overflow = true; }
-            mem_end = m->memory.bytes+m->memory.pages*(uint32_t)pow(2,16);
-            if (maddr+LOAD_SIZE[opcode-0x28] > mem_end) {
-                overflow = true;
-            }
-            info("      - addr: 0x%x, offset: 0x%x, maddr: %p, mem_end: %p, value: %s\n",
-                 addr, offset, maddr, mem_end, value_repr(sval));
-            if (!m->options.disable_memory_bounds) {
-                if (overflow) {
-                    warn("memory start: %p, memory end: %p, maddr: %p\n",
-                        m->memory.bytes, mem_end, maddr);
-                    snprintf(exception, 1024, "out of bounds memory access");
-                    return false;
-                }
-            }
-            switch (opcode) {
-            case 0x36: memcpy(maddr, &sval->value.uint32, 4); break; // i32.store
-            case 0x37: memcpy(maddr, &sval->value.uint64, 8); break; // i64.store
-            case 0x38: memcpy(maddr, &sval->value.f32, 4); break;    // f32.store
-            case 0x39: memcpy(maddr, &sval->value.f64, 8); break;    // f64.store
-            case 0x3a: memcpy(maddr, &sval->value.uint32, 1); break; // i32.store8
-            case 0x3b: memcpy(maddr, &sval->value.uint32, 2); break; // i32.store16
-            case 0x3c: memcpy(maddr, &sval->value.uint64, 1); break; // i64.store8
-            case 0x3d: memcpy(maddr, &sval->value.uint64, 2); break; // i64.store16
-            case 0x3e: memcpy(maddr, &sval->value.uint64, 4); break; // i64.store32
-            }
-        }
-            continue;
+    }
+    LOAD();
+    NEXT();
 
-        //
-        // Constants
-        //
-        case 0x41:  // i32.const
-            stack[++m->sp].value_type = I32;
-            stack[m->sp].value.uint32 = read_LEB_signed(bytes, &m->pc, 32);
-            continue;
-        case 0x42:  // i64.const
-            stack[++m->sp].value_type = I64;
-            stack[m->sp].value.int64 = read_LEB_signed(bytes, &m->pc, 64);
-            continue;
-        case 0x43:  // f32.const
-            stack[++m->sp].value_type = F32;
-            memcpy(&stack[m->sp].value.uint32, bytes+m->pc, 4);
-            m->pc += 4;
-            //stack[m->sp].value.uint32 = read_LEB_signed(bytes, pm->c, 32);
-            continue;
-        case 0x44:  // f64.const
-            stack[++m->sp].value_type = F64;
-            memcpy(&stack[m->sp].value.uint64, bytes+m->pc, 8);
-            m->pc += 8;
-            //stack[m->sp].value.uint64 = read_LEB_signed(bytes, m->pc, 64);
-            continue;
-
-        //
-        // Comparison operators
-        //
-
-        // unary
-        case 0x45:  // i32.eqz
-            stack[m->sp].value.uint32 = stack[m->sp].value.uint32 == 0;
-            continue;
-        case 0x50:  // i64.eqz
-            stack[m->sp].value_type = I32;
-            stack[m->sp].value.uint32 = stack[m->sp].value.uint64 == 0;
-            continue;
-
-        // i32 binary
-        case 0x46 ... 0x4f:
-            a = stack[m->sp-1].value.uint32;
-            b = stack[m->sp].value.uint32;
-            m->sp -= 1;
-            switch (opcode) {
-            case 0x46: c = a == b; break;  // i32.eq
-            case 0x47: c = a != b; break;  // i32.ne
-            case 0x48: c = (int32_t)a <  (int32_t)b; break;  // i32.lt_s
-            case 0x49: c = a <  b; break;  // i32.lt_u
-            case 0x4a: c = (int32_t)a >  (int32_t)b; break;  // i32.gt_s
-            case 0x4b: c = a >  b; break;  // i32.gt_u
-            case 0x4c: c = (int32_t)a <= (int32_t)b; break;  // i32.le_s
-            case 0x4d: c = a <= b; break;  // i32.le_u
-            case 0x4e: c = (int32_t)a >= (int32_t)b; break;  // i32.ge_s
-            case 0x4f: c = a >= b; break;  // i32.ge_u
-            }
-            stack[m->sp].value_type = I32;
-            stack[m->sp].value.uint32 = c;
-            continue;
-        case 0x51 ... 0x5a:
-            d = stack[m->sp-1].value.uint64;
-            e = stack[m->sp].value.uint64;
-            m->sp -= 1;
-            switch (opcode) {
-            case 0x51: c = d == e; break;  // i64.eq
-            case 0x52: c = d != e; break;  // i64.ne
-            case 0x53: c = (int64_t)d <  (int64_t)e; break;  // i64.lt_s
-            case 0x54: c = d <  e; break;  // i64.lt_u
-            case 0x55: c = (int64_t)d >  (int64_t)e; break;  // i64.gt_s
-            case 0x56: c = d >  e; break;  // i64.gt_u
-            case 0x57: c = (int64_t)d <= (int64_t)e; break;  // i64.le_s
-            case 0x58: c = d <= e; break;  // i64.le_u
-            case 0x59: c = (int64_t)d >= (int64_t)e; break;  // i64.ge_s
-            case 0x5a: c = d >= e; break;  // i64.ge_u
-            }
-            stack[m->sp].value_type = I32;
-            stack[m->sp].value.uint32 = c;
-            continue;
-        case 0x5b ... 0x60:
-            g = stack[m->sp-1].value.f32;
-            h = stack[m->sp].value.f32;
-            m->sp -= 1;
-            switch (opcode) {
-            case 0x5b: c = g == h; break;  // f32.eq
-            case 0x5c: c = g != h; break;  // f32.ne
-            case 0x5d: c = g <  h; break;  // f32.lt
-            case 0x5e: c = g >  h; break;  // f32.gt
-            case 0x5f: c = g <= h; break;  // f32.le
-            case 0x60: c = g >= h; break;  // f32.ge
-            }
-            stack[m->sp].value_type = I32;
-            stack[m->sp].value.uint32 = c;
-            continue;
-        case 0x61 ... 0x66:
-            j = stack[m->sp-1].value.f64;
-            k = stack[m->sp].value.f64;
-            m->sp -= 1;
-            switch (opcode) {
-            case 0x61: c = j == k; break;  // f64.eq
-            case 0x62: c = j != k; break;  // f64.ne
-            case 0x63: c = j <  k; break;  // f64.lt
-            case 0x64: c = j >  k; break;  // f64.gt
-            case 0x65: c = j <= k; break;  // f64.le
-            case 0x66: c = j >= k; break;  // f64.ge
-            }
-            stack[m->sp].value_type = I32;
-            stack[m->sp].value.uint32 = c;
-            continue;
-
-        //
-        // Numeric operators
-        //
-
-        // unary i32
-        case 0x67 ... 0x69:
-            a = stack[m->sp].value.uint32;
-            switch (opcode) {
-            case 0x67: c = a==0 ? 32 : __builtin_clz(a); break; // i32.clz
-            case 0x68: c = a==0 ? 32 : __builtin_ctz(a); break; // i32.ctz
-            case 0x69: c = __builtin_popcount(a); break;        // i32.popcnt
-            }
-            stack[m->sp].value.uint32 = c;
-            continue;
-
-        // unary i64
-        case 0x79 ... 0x7b:
-            d = stack[m->sp].value.uint64;
-            switch (opcode) {
-            case 0x79: f = d==0 ? 64 : __builtin_clzll(d); break; // i64.clz
-            case 0x7a: f = d==0 ? 64 : __builtin_ctzll(d); break; // i64.ctz
-            case 0x7b: f = __builtin_popcountll(d); break;        // i64.popcnt
-            }
-            stack[m->sp].value.uint64 = f;
-            continue;
-
-        // unary f32
-        case 0x8b: stack[m->sp].value.f32
-                   = fabs(stack[m->sp].value.f32); break;  // f32.abs
-        case 0x8c: stack[m->sp].value.f32
-                   = -stack[m->sp].value.f32; break;       // f32.neg
-        case 0x8d: stack[m->sp].value.f32
-                   = ceil(stack[m->sp].value.f32); break;  // f32.ceil
-        case 0x8e: stack[m->sp].value.f32
-                   = floor(stack[m->sp].value.f32); break; // f32.floor
-        case 0x8f: stack[m->sp].value.f32
-                   = trunc(stack[m->sp].value.f32); break; // f32.trunc
-        case 0x90: stack[m->sp].value.f32
-                   = rint(stack[m->sp].value.f32); break; // f32.nearest
-        case 0x91: stack[m->sp].value.f32
-                   = sqrt(stack[m->sp].value.f32); break;  // f32.sqrt
-
-        // unary f64
-        case 0x99: stack[m->sp].value.f64
-                   = fabs(stack[m->sp].value.f64); break;  // f64.abs
-        case 0x9a: stack[m->sp].value.f64
-                   = -stack[m->sp].value.f64; break;       // f64.neg
-        case 0x9b: stack[m->sp].value.f64
-                   = ceil(stack[m->sp].value.f64); break;  // f64.ceil
-        case 0x9c: stack[m->sp].value.f64
-                   = floor(stack[m->sp].value.f64); break; // f64.floor
-        case 0x9d: stack[m->sp].value.f64
-                   = trunc(stack[m->sp].value.f64); break; // f64.trunc
-        case 0x9e: stack[m->sp].value.f64
-                   = rint(stack[m->sp].value.f64); break; // f64.nearest
-        case 0x9f: stack[m->sp].value.f64
-                   = sqrt(stack[m->sp].value.f64); break;  // f64.sqrt
-
-        // i32 binary
-        case 0x6a ... 0x78:
-            a = stack[m->sp-1].value.uint32;
-            b = stack[m->sp].value.uint32;
-            m->sp -= 1;
-            if (opcode >= 0x6d && opcode <= 0x70 && b == 0) {
-                snprintf(exception, 1024, "integer divide by zero");
-                return false;
-            }
-            switch (opcode) {
-            //case 0x6a: o = __builtin_add_overflow(a, b, &c); break;  // i32.add
-            //case 0x6b: o = __builtin_sub_overflow(a, b, &c); break;  // i32.sub
-            case 0x6a: c = a + b; break;  // i32.add
-            case 0x6b: c = a - b; break;  // i32.sub
-            case 0x6c: c = a * b; break;  // i32.mul
-            case 0x6d: if (a == 0x80000000 && b == -1) {
-                           snprintf(exception,1024, "integer overflow");
-                           return false;
-                       }
-                       c = (int32_t)a / (int32_t)b; break;  // i32.div_s
-            case 0x6e: c = a / b; break;  // i32.div_u
-            case 0x6f: if (a == 0x80000000 && b == -1) {
-                           c = 0;
-                       } else {
-                           c = (int32_t)a % (int32_t)b;
-                       }; break;  // i32.rem_s
-            case 0x70: c = a % b; break;  // i32.rem_u
-            case 0x71: c = a & b; break;  // i32.and
-            case 0x72: c = a | b; break;  // i32.or
-            case 0x73: c = a ^ b; break;  // i32.xor
-            case 0x74: c = a << b; break; // i32.shl
-            case 0x75: c = (int32_t)a >> b; break; // i32.shr_s
-            case 0x76: c = a >> b; break; // i32.shr_u
-            case 0x77: c = rotl32(a, b); break; // i32.rotl
-            case 0x78: c = rotr32(a, b); break; // i32.rotr
-            }
-            //if (o == 1) {
-            //    snprintf(exception, 1024,"integer overflow");
-            //    return false;
-            //}
-            stack[m->sp].value.uint32 = c;
-            continue;
-
-        // i64 binary
-        case 0x7c ... 0x8a:
-            d = stack[m->sp-1].value.uint64;
-            e = stack[m->sp].value.uint64;
-            m->sp -= 1;
-            if (opcode >= 0x7f && opcode <= 0x82 && e == 0) {
-                snprintf(exception, 1024,"integer divide by zero");
-                return false;
-            }
-            switch (opcode) {
-            case 0x7c: f = d + e; break;  // i64.add
-            case 0x7d: f = d - e; break;  // i64.sub
-            case 0x7e: f = d * e; break;  // i64.mul
-            case 0x7f: if (d == 0x8000000000000000 && e == -1) {
-                           snprintf(exception,1024, "integer overflow");
-                           return false;
-                       }
-                       f = (int64_t)d / (int64_t)e; break;  // i64.div_s
-            case 0x80: f = d / e; break;  // i64.div_u
-            case 0x81: if (d == 0x8000000000000000 && e == -1) {
-                           f = 0;
-                       } else {
-                           f = (int64_t)d % (int64_t)e;
-                       }
-                       break;  // i64.rem_s
-            case 0x82: f = d % e; break;  // i64.rem_u
-            case 0x83: f = d & e; break;  // i64.and
-            case 0x84: f = d | e; break;  // i64.or
-            case 0x85: f = d ^ e; break;  // i64.xor
-            case 0x86: f = d << e; break; // i64.shl
-            case 0x87: f = ((int64_t)d) >> e; break; // i64.shr_s
-            case 0x88: f = d >> e; break; // i64.shr_u
-            case 0x89: f = rotl64(d, e); break; // i64.rotl
-            case 0x8a: f = rotr64(d, e); break; // i64.rotr
-            }
-            stack[m->sp].value.uint64 = f;
-            continue;
-
-        // f32 binary
-        case 0x92 ... 0x98:
-            g = stack[m->sp-1].value.f32;
-            h = stack[m->sp].value.f32;
-            m->sp -= 1;
-            switch (opcode) {
-            case 0x92: i = g + h; break;  // f32.add
-            case 0x93: i = g - h; break;  // f32.sub
-            case 0x94: i = g * h; break;  // f32.mul
-            case 0x95: i = g / h; break;  // f32.div
-            case 0x96: i = wa_fmin(g, h); break;  // f32.min
-            case 0x97: i = wa_fmax(g, h); break;  // f32.max
-            case 0x98: i = signbit(h) ? -fabs(g) : fabs(g); break;  // f32.copysign
-            }
-            stack[m->sp].value.f32 = i;
-            continue;
-
-        // f64 binary
-        case 0xa0 ... 0xa6:
-            j = stack[m->sp-1].value.f64;
-            k = stack[m->sp].value.f64;
-            m->sp -= 1;
-            switch (opcode) {
-            case 0xa0: l = j + k; break;  // f64.add
-            case 0xa1: l = j - k; break;  // f64.sub
-            case 0xa2: l = j * k; break;  // f64.mul
-            case 0xa3: l = j / k; break;  // f64.div
-            case 0xa4: l = wa_fmin(j, k); break;  // f64.min
-            case 0xa5: l = wa_fmax(j, k); break;  // f64.max
-            case 0xa6: l = signbit(k) ? -fabs(j) : fabs(j); break;  // f64.copysign
-            }
-            stack[m->sp].value.f64 = l;
-            continue;
-
-        // conversion operations
-        //case 0xa7 ... 0xbb:
-        case 0xa7: stack[m->sp].value.uint64 &= 0x00000000ffffffff;
-                   stack[m->sp].value_type = I32; break;  // i32.wrap/i64
-        case 0xa8: if (isnan(stack[m->sp].value.f32)) {
-                       snprintf(exception, 1024,"invalid conversion to integer");
-                       return false;
-                   } else if (stack[m->sp].value.f32 >= INT32_MAX ||
-                              stack[m->sp].value.f32 < INT32_MIN) {
-                       snprintf(exception, 1024,"integer overflow");
-                       return false;
-                   }
-                   stack[m->sp].value.int32 = stack[m->sp].value.f32;
-                   stack[m->sp].value_type = I32; break;  // i32.trunc_s/f32
-        case 0xa9: if (isnan(stack[m->sp].value.f32)) {
-                       snprintf(exception, 1024,"invalid conversion to integer");
-                       return false;
-                   } else if (stack[m->sp].value.f32 >= UINT32_MAX ||
-                              stack[m->sp].value.f32 <= -1) {
-                       snprintf(exception, 1024,"integer overflow");
-                       return false;
-                   }
-                   stack[m->sp].value.uint32 = stack[m->sp].value.f32;
-                   stack[m->sp].value_type = I32; break;  // i32.trunc_u/f32
-        case 0xaa: if (isnan(stack[m->sp].value.f64)) {
-                       snprintf(exception, 1024,"invalid conversion to integer");
-                       return false;
-                   } else if (stack[m->sp].value.f64 > INT32_MAX ||
-                              stack[m->sp].value.f64 < INT32_MIN) {
-                       snprintf(exception, 1024,"integer overflow");
-                       return false;
-                   }
-                   stack[m->sp].value.int32 = stack[m->sp].value.f64;
-                   stack[m->sp].value_type = I32; break;  // i32.trunc_s/f64
-        case 0xab: if (isnan(stack[m->sp].value.f64)) {
-                       snprintf(exception, 1024,"invalid conversion to integer");
-                       return false;
-                   } else if (stack[m->sp].value.f64 > UINT32_MAX ||
-                              stack[m->sp].value.f64 <= -1) {
-                       snprintf(exception, 1024,"integer overflow");
-                       return false;
-                   }
-                   stack[m->sp].value.uint32 = stack[m->sp].value.f64;
-                   stack[m->sp].value_type = I32; break;  // i32.trunc_u/f64
-        case 0xac: stack[m->sp].value.uint64 = stack[m->sp].value.uint32;
-                   sext_32_64(&stack[m->sp].value.uint64);
-                   stack[m->sp].value_type = I64; break;  // i64.extend_s/i32
-        case 0xad: stack[m->sp].value.uint64 = stack[m->sp].value.uint32;
-                   stack[m->sp].value_type = I64; break;  // i64.extend_u/i32
-        case 0xae: if (isnan(stack[m->sp].value.f32)) {
-                       snprintf(exception, 1024,"invalid conversion to integer");
-                       return false;
-                   } else if (stack[m->sp].value.f32 >= INT64_MAX ||
-                              stack[m->sp].value.f32 < INT64_MIN) {
-                       snprintf(exception, 1024,"integer overflow");
-                       return false;
-                   }
-                   stack[m->sp].value.int64 = stack[m->sp].value.f32;
-                   stack[m->sp].value_type = I64; break;  // i64.trunc_s/f32
-        case 0xaf: if (isnan(stack[m->sp].value.f32)) {
-                       snprintf(exception, 1024,"invalid conversion to integer");
-                       return false;
-                   } else if (stack[m->sp].value.f32 >= UINT64_MAX ||
-                              stack[m->sp].value.f32 <= -1) {
-                       snprintf(exception, 1024,"integer overflow");
-                       return false;
-                   }
-                   stack[m->sp].value.uint64 = stack[m->sp].value.f32;
-                   stack[m->sp].value_type = I64; break;  // i64.trunc_u/f32
-        case 0xb0: if (isnan(stack[m->sp].value.f64)) {
-                       snprintf(exception, 1024,"invalid conversion to integer");
-                       return false;
-                   } else if (stack[m->sp].value.f64 >= INT64_MAX ||
-                              stack[m->sp].value.f64 < INT64_MIN) {
-                       snprintf(exception, 1024,"integer overflow");
-                       return false;
-                   }
-                   stack[m->sp].value.int64 = stack[m->sp].value.f64;
-                   stack[m->sp].value_type = I64; break;  // i64.trunc_s/f64
-        case 0xb1: if (isnan(stack[m->sp].value.f64)) {
-                       snprintf(exception, 1024,"invalid conversion to integer");
-                       return false;
-                   } else if (stack[m->sp].value.f64 >= UINT64_MAX ||
-                              stack[m->sp].value.f64 <= -1) {
-                       snprintf(exception, 1024,"integer overflow");
-                       return false;
-                   }
-                   stack[m->sp].value.uint64 = stack[m->sp].value.f64;
-                   stack[m->sp].value_type = I64; break;  // i64.trunc_u/f64
-        case 0xb2: stack[m->sp].value.f32 = stack[m->sp].value.int32;
-                   stack[m->sp].value_type = F32; break;  // f32.convert_s/i32
-        case 0xb3: stack[m->sp].value.f32 = stack[m->sp].value.uint32;
-                   stack[m->sp].value_type = F32; break;  // f32.convert_u/i32
-        case 0xb4: stack[m->sp].value.f32 = stack[m->sp].value.int64;
-                   stack[m->sp].value_type = F32; break;  // f32.convert_s/i64
-        case 0xb5: stack[m->sp].value.f32 = stack[m->sp].value.uint64;
-                   stack[m->sp].value_type = F32; break;  // f32.convert_u/i64
-        case 0xb6: stack[m->sp].value.f32 = stack[m->sp].value.f64;
-                   stack[m->sp].value_type = F32; break;  // f32.demote/f64
-        case 0xb7: stack[m->sp].value.f64 = stack[m->sp].value.int32;
-                   stack[m->sp].value_type = F64; break;  // f64.convert_s/i32
-        case 0xb8: stack[m->sp].value.f64 = stack[m->sp].value.uint32;
-                   stack[m->sp].value_type = F64; break;  // f64.convert_u/i32
-        case 0xb9: stack[m->sp].value.f64 = stack[m->sp].value.int64;
-                   stack[m->sp].value_type = F64; break;  // f64.convert_s/i64
-        case 0xba: stack[m->sp].value.f64 = stack[m->sp].value.uint64;
-                   stack[m->sp].value_type = F64; break;  // f64.convert_u/i64
-        case 0xbb: stack[m->sp].value.f64 = stack[m->sp].value.f32;
-                   stack[m->sp].value_type = F64; break;  // f64.promote/f32
-
-        // reinterpretations
-        case 0xbc: stack[m->sp].value_type = I32; break;  // i32.reinterpret/f32
-        case 0xbd: stack[m->sp].value_type = I64; break;  // i64.reinterpret/f64
-        case 0xbe: //memmove(&stack[m->sp].value.f32, &stack[m->sp].value.uint32, 4);
-                   stack[m->sp].value_type = F32; break;  // f32.reinterpret/i32
-        case 0xbf: stack[m->sp].value_type = F64; break;  // f64.reinterpret/i64
+    //
+    // Parametric operators
+    //
+op_drop:
+    sp--;
+    NEXT();
+op_select:
+    cond = stack[sp--].value.uint32;
+    sp--;
+    if (!cond) {  // use a instead of b
+        stack[sp] = stack[sp+1];
+    }
+    NEXT();
 
-        default:
-            snprintf(exception,1024, "unrecognized opcode 0x%x", opcode);
-            return false;
+    //
+    // Variable access
+    //
+op_get_local:
+    stack[++sp] = stack[fp+ip->arg];
+    NEXT();
+op_set_local:
+    stack[fp+ip->arg] = stack[sp--];
+    NEXT();
+op_tee_local:
+    stack[fp+ip->arg] = stack[sp];
+    NEXT();
+op_get_global:
+    stack[++sp] = m->globals[ip->arg];
+    NEXT();
+op_set_global:
+    m->globals[ip->arg] = stack[sp--];
+    NEXT();
+
+    //
+    // Memory-related operators
+    //
+op_current_memory:
+    stack[++sp].value_type = I32;
+    stack[sp].value.uint32 = m->memory.pages;
+    NEXT();
+op_grow_memory:
+    {
+        uint32_t prev_pages = m->memory.pages;
+        uint32_t delta = stack[sp].value.uint32;
+        stack[sp].value.uint32 = prev_pages;
+        if (delta == 0) {
+            NEXT(); // No change
+        } else if (delta+prev_pages > m->memory.maximum) {
+            stack[sp].value.uint32 = -1;
+            NEXT();
         }
+        m->memory.pages += delta;
+        m->memory.bytes = (uint8_t*) arecalloc(m->memory.bytes,
+                                    prev_pages*WA_PAGE_SIZE,
+                                    m->memory.pages*WA_PAGE_SIZE, 1,
+                                    "Module->memory.bytes");
+        mem_size = (uint64_t)m->memory.pages*WA_PAGE_SIZE;
     }
+    NEXT();
+
+    // Memory load operators
+#define LOAD_OP(name, size, type, ext) \
+op_##name: \
+    addr = stack[sp].value.uint32; \
+    BOUNDS(size); \
+    stack[sp].value.uint64 = 0; /* initialize to 0 */ \
+    memcpy(&stack[sp].value, maddr, size); \
+    ext; \
+    stack[sp].value_type = type; \
+    NEXT();
+
+    LOAD_OP(i32_load,     4, I32, )
+    LOAD_OP(i64_load,     8, I64, )
+    LOAD_OP(f32_load,     4, F32, )
+    LOAD_OP(f64_load,     8, F64, )
+    LOAD_OP(i32_load8_s,  1, I32, sext_8_32(&stack[sp].value.uint32))
+    LOAD_OP(i32_load8_u,  1, I32, )
+    LOAD_OP(i32_load16_s, 2, I32, sext_16_32(&stack[sp].value.uint32))
+    LOAD_OP(i32_load16_u, 2, I32, )
+    LOAD_OP(i64_load8_s,  1, I64, sext_8_64(&stack[sp].value.uint64))
+    LOAD_OP(i64_load8_u,  1, I64, )
+    LOAD_OP(i64_load16_s, 2, I64, sext_16_64(&stack[sp].value.uint64))
+    LOAD_OP(i64_load16_u, 2, I64, )
+    LOAD_OP(i64_load32_s, 4, I64, sext_32_64(&stack[sp].value.uint64))
+    LOAD_OP(i64_load32_u, 4, I64, )
+
+    // Memory store operators. Values are little endian, so a narrow store
+    // copies the low bytes of either integer width.
+#define STORE_OP(name, size) \
+op_##name: \
+    sval = &stack[sp--]; \
+    addr = stack[sp--].value.uint32; \
+    BOUNDS(size); \
+    memcpy(maddr, &sval->value, size); \
+    NEXT();
+
+    STORE_OP(store8,  1)
+    STORE_OP(store16, 2)
+    STORE_OP(store32, 4)
+    STORE_OP(store64, 8)
+
+    //
+    // Constants
+    //
+op_i32_const:
+    stack[++sp].value_type = I32;
+    stack[sp].value.uint32 = ip->imm.uint32;
+    NEXT();
+op_i64_const:
+    stack[++sp].value_type = I64;
+    stack[sp].value.uint64 = ip->imm.uint64;
+    NEXT();
+op_f32_const:
+    stack[++sp].value_type = F32;
+    stack[sp].value.uint32 = ip->imm.uint32;
+    NEXT();
+op_f64_const:
+    stack[++sp].value_type = F64;
+    stack[sp].value.uint64 = ip->imm.uint64;
+    NEXT();
+
+    //
+    // Comparison operators
+    //
+
+    // unary
+op_i32_eqz:
+    stack[sp].value.uint32 = stack[sp].value.uint32 == 0;
+    NEXT();
+op_i64_eqz:
+    stack[sp].value_type = I32;
+    stack[sp].value.uint32 = stack[sp].value.uint64 == 0;
+    NEXT();
+
+    // binary: operands x and y in field, i32 result
+#define CMP_OP(name, field, x, y, expr) \
+op_##name: \
+    x = stack[sp-1].value.field; \
+    y = stack[sp].value.field; \
+    sp -= 1; \
+    stack[sp].value_type = I32; \
+    stack[sp].value.uint32 = (expr); \
+    NEXT();
+
+    CMP_OP(i32_eq,   uint32, a, b, a == b)
+    CMP_OP(i32_ne,   uint32, a, b, a != b)
+    CMP_OP(i32_lt_s, uint32, a, b, (int32_t)a <  (int32_t)b)
+    CMP_OP(i32_lt_u, uint32, a, b, a <  b)
+    CMP_OP(i32_gt_s, uint32, a, b, (int32_t)a >  (int32_t)b)
+    CMP_OP(i32_gt_u, uint32, a, b, a >  b)
+    CMP_OP(i32_le_s, uint32, a, b, (int32_t)a <= (int32_t)b)
+    CMP_OP(i32_le_u, uint32, a, b, a <= b)
+    CMP_OP(i32_ge_s, uint32, a, b, (int32_t)a >= (int32_t)b)
+    CMP_OP(i32_ge_u, uint32, a, b, a >= b)
+
+    CMP_OP(i64_eq,   uint64, d, e, d == e)
+    CMP_OP(i64_ne,   uint64, d, e, d != e)
+    CMP_OP(i64_lt_s, uint64, d, e, (int64_t)d <  (int64_t)e)
+    CMP_OP(i64_lt_u, uint64, d, e, d <  e)
+    CMP_OP(i64_gt_s, uint64, d, e, (int64_t)d >  (int64_t)e)
+    CMP_OP(i64_gt_u, uint64, d, e, d >  e)
+    CMP_OP(i64_le_s, uint64, d, e, (int64_t)d <= (int64_t)e)
+    CMP_OP(i64_le_u, uint64, d, e, d <= e)
+    CMP_OP(i64_ge_s, uint64, d, e, (int64_t)d >= (int64_t)e)
+    CMP_OP(i64_ge_u, uint64, d, e, d >= e)
+
+    CMP_OP(f32_eq, f32, g, h, g == h)
+    CMP_OP(f32_ne, f32, g, h, g != h)
+    CMP_OP(f32_lt, f32, g, h, g <  h)
+    CMP_OP(f32_gt, f32, g, h, g >  h)
+    CMP_OP(f32_le, f32, g, h, g <= h)
+    CMP_OP(f32_ge, f32, g, h, g >= h)
+
+    CMP_OP(f64_eq, f64, j, k, j == k)
+    CMP_OP(f64_ne, f64, j, k, j != k)
+    CMP_OP(f64_lt, f64, j, k, j <  k)
+    CMP_OP(f64_gt, f64, j, k, j >  k)
+    CMP_OP(f64_le, f64, j, k, j <= k)
+    CMP_OP(f64_ge, f64, j, k, j >= k)
+
+    //
+    // Numeric operators
+    //
+
+    // unary: operand x in field, result of the same type
+#define UNARY_OP(name, field, x, expr) \
+op_##name: \
+    x = stack[sp].value.field; \
+    stack[sp].value.field = (expr); \
+    NEXT();
+
+    UNARY_OP(i32_clz,    uint32, a, a==0 ? 32 : __builtin_clz(a))
+    UNARY_OP(i32_ctz,    uint32, a, a==0 ? 32 : __builtin_ctz(a))
+    UNARY_OP(i32_popcnt, uint32, a, __builtin_popcount(a))
+
+    UNARY_OP(i64_clz,    uint64, d, d==0 ? 64 : __builtin_clzll(d))
+    UNARY_OP(i64_ctz,    uint64, d, d==0 ? 64 : __builtin_ctzll(d))
+    UNARY_OP(i64_popcnt, uint64, d, __builtin_popcountll(d))
+
+    UNARY_OP(f32_abs,     f32, g, fabs(g))
+    UNARY_OP(f32_neg,     f32, g, -g)
+    UNARY_OP(f32_ceil,    f32, g, ceil(g))
+    UNARY_OP(f32_floor,   f32, g, floor(g))
+    UNARY_OP(f32_trunc,   f32, g, trunc(g))
+    UNARY_OP(f32_nearest, f32, g, rint(g))
+    UNARY_OP(f32_sqrt,    f32, g, sqrt(g))
+
+    UNARY_OP(f64_abs,     f64, j, fabs(j))
+    UNARY_OP(f64_neg,     f64, j, -j)
+    UNARY_OP(f64_ceil,    f64, j, ceil(j))
+    UNARY_OP(f64_floor,   f64, j, floor(j))
+    UNARY_OP(f64_trunc,   f64, j, trunc(j))
+    UNARY_OP(f64_nearest, f64, j, rint(j))
+    UNARY_OP(f64_sqrt,    f64, j, sqrt(j))
+
+    // binary: operands x and y in field, result of the same type
+#define BINARY_OP(name, field, x, y, expr) \
+op_##name: \
+    x = stack[sp-1].value.field; \
+    y = stack[sp].value.field; \
+    sp -= 1; \
+    stack[sp].value.field = (expr); \
+    NEXT();
+
+    BINARY_OP(i32_add,  uint32, a, b, a + b)
+    BINARY_OP(i32_sub,  uint32, a, b, a - b)
+    BINARY_OP(i32_mul,  uint32, a, b, a * b)
+    BINARY_OP(i32_and,  uint32, a, b, a & b)
+    BINARY_OP(i32_or,   uint32, a, b, a | b)
+    BINARY_OP(i32_xor,  uint32, a, b, a ^ b)
+    BINARY_OP(i32_shl,  uint32, a, b, a << b)
+    BINARY_OP(i32_shr_s, uint32, a, b, (int32_t)a >> b)
+    BINARY_OP(i32_shr_u, uint32, a, b, a >> b)
+    BINARY_OP(i32_rotl, uint32, a, b, rotl32(a, b))
+    BINARY_OP(i32_rotr, uint32, a, b, rotr32(a, b))
+
+    BINARY_OP(i64_add,  uint64, d, e, d + e)
+    BINARY_OP(i64_sub,  uint64, d, e, d - e)
+    BINARY_OP(i64_mul,  uint64, d, e, d * e)
+    BINARY_OP(i64_and,  uint64, d, e, d & e)
+    BINARY_OP(i64_or,   uint64, d, e, d | e)
+    BINARY_OP(i64_xor,  uint64, d, e, d ^ e)
+    BINARY_OP(i64_shl,  uint64, d, e, d << e)
+    BINARY_OP(i64_shr_s, uint64, d, e, ((int64_t)d) >> e)
+    BINARY_OP(i64_shr_u, uint64, d, e, d >> e)
+    BINARY_OP(i64_rotl, uint64, d, e, rotl64(d, e))
+    BINARY_OP(i64_rotr, uint64, d, e, rotr64(d, e))
+
+    BINARY_OP(f32_add,      f32, g, h, g + h)
+    BINARY_OP(f32_sub,      f32, g, h, g - h)
+    BINARY_OP(f32_mul,      f32, g, h, g * h)
+    BINARY_OP(f32_div,      f32, g, h, g / h)
+    BINARY_OP(f32_min,      f32, g, h, wa_fmin(g, h))
+    BINARY_OP(f32_max,      f32, g, h, wa_fmax(g, h))
+    BINARY_OP(f32_copysign, f32, g, h, signbit(h) ? -fabs(g) : fabs(g))
+
+    BINARY_OP(f64_add,      f64, j, k, j + k)
+    BINARY_OP(f64_sub,      f64, j, k, j - k)
+    BINARY_OP(f64_mul,      f64, j, k, j * k)
+    BINARY_OP(f64_div,      f64, j, k, j / k)
+    BINARY_OP(f64_min,      f64, j, k, wa_fmin(j, k))
+    BINARY_OP(f64_max,      f64, j, k, wa_fmax(j, k))
+    BINARY_OP(f64_copysign, f64, j, k, signbit(k) ? -fabs(j) : fabs(j))
+
+    // division and remainder trap on a zero divisor
+op_i32_div_s:
+    a = stack[sp-1].value.uint32;
+    b = stack[sp].value.uint32;
+    sp -= 1;
+    if (b == 0) { TRAP("integer divide by zero"); }
+    if (a == 0x80000000 && b == -1) { TRAP("integer overflow"); }
+    stack[sp].value.uint32 = (int32_t)a / (int32_t)b;
+    NEXT();
+op_i32_div_u:
+    a = stack[sp-1].value.uint32;
+    b = stack[sp].value.uint32;
+    sp -= 1;
+    if (b == 0) { TRAP("integer divide by zero"); }
+    stack[sp].value.uint32 = a / b;
+    NEXT();
+op_i32_rem_s:
+    a = stack[sp-1].value.uint32;
+    b = stack[sp].value.uint32;
+    sp -= 1;
+    if (b == 0) { TRAP("integer divide by zero"); }
+    if (a == 0x80000000 && b == -1) {
+        c = 0;
+    } else {
+        c = (int32_t)a % (int32_t)b;
+    }
+    stack[sp].value.uint32 = c;
+    NEXT();
+op_i32_rem_u:
+    a = stack[sp-1].value.uint32;
+    b = stack[sp].value.uint32;
+    sp -= 1;
+    if (b == 0) { TRAP("integer divide by zero"); }
+    stack[sp].value.uint32 = a % b;
+    NEXT();
+op_i64_div_s:
+    d = stack[sp-1].value.uint64;
+    e = stack[sp].value.uint64;
+    sp -= 1;
+    if (e == 0) { TRAP("integer divide by zero"); }
+    if (d == 0x8000000000000000 && e == -1) { TRAP("integer overflow"); }
+    stack[sp].value.uint64 = (int64_t)d / (int64_t)e;
+    NEXT();
+op_i64_div_u:
+    d = stack[sp-1].value.uint64;
+    e = stack[sp].value.uint64;
+    sp -= 1;
+    if (e == 0) { TRAP("integer divide by zero"); }
+    stack[sp].value.uint64 = d / e;
+    NEXT();
+op_i64_rem_s:
+    d = stack[sp-1].value.uint64;
+    e = stack[sp].value.uint64;
+    sp -= 1;
+    if (e == 0) { TRAP("integer divide by zero"); }
+    if (d == 0x8000000000000000 && e == -1) {
+        f = 0;
+    } else {
+        f = (int64_t)d % (int64_t)e;
+    }
+    stack[sp].value.uint64 = f;
+    NEXT();
+op_i64_rem_u:
+    d = stack[sp-1].value.uint64;
+    e = stack[sp].value.uint64;
+    sp -= 1;
+    if (e == 0) { TRAP("integer divide by zero"); }
+    stack[sp].value.uint64 = d % e;
+    NEXT();
+
+    // conversion operations
+op_i32_wrap_i64:
+    stack[sp].value.uint64 &= 0x00000000ffffffff;
+    stack[sp].value_type = I32;
+    NEXT();
+
+    // float to integer, trapping on NaN and on values out of range
+#define TRUNC_OP(name, ffield, ifield, type, out_of_range) \
+op_##name: \
+    if (isnan(stack[sp].value.ffield)) { \
+        TRAP("invalid conversion to integer"); \
+    } else if (out_of_range) { \
+        TRAP("integer overflow"); \
+    } \
+    stack[sp].value.ifield = stack[sp].value.ffield; \
+    stack[sp].value_type = type; \
+    NEXT();
+
+    TRUNC_OP(i32_trunc_s_f32, f32, int32, I32,
+             stack[sp].value.f32 >= INT32_MAX ||
+             stack[sp].value.f32 < INT32_MIN)
+    TRUNC_OP(i32_trunc_u_f32, f32, uint32, I32,
+             stack[sp].value.f32 >= UINT32_MAX ||
+             stack[sp].value.f32 <= -1)
+    TRUNC_OP(i32_trunc_s_f64, f64, int32, I32,
+             stack[sp].value.f64 > INT32_MAX ||
+             stack[sp].value.f64 < INT32_MIN)
+    TRUNC_OP(i32_trunc_u_f64, f64, uint32, I32,
+             stack[sp].value.f64 > UINT32_MAX ||
+             stack[sp].value.f64 <= -1)
+    TRUNC_OP(i64_trunc_s_f32, f32, int64, I64,
+             stack[sp].value.f32 >= INT64_MAX ||
+             stack[sp].value.f32 < INT64_MIN)
+    TRUNC_OP(i64_trunc_u_f32, f32, uint64, I64,
+             stack[sp].value.f32 >= UINT64_MAX ||
+             stack[sp].value.f32 <= -1)
+    TRUNC_OP(i64_trunc_s_f64, f64, int64, I64,
+             stack[sp].value.f64 >= INT64_MAX ||
+             stack[sp].value.f64 < INT64_MIN)
+    TRUNC_OP(i64_trunc_u_f64, f64, uint64, I64,
+             stack[sp].value.f64 >= UINT64_MAX ||
+             stack[sp].value.f64 <= -1)
+
+op_i64_extend_s_i32:
+    stack[sp].value.uint64 = stack[sp].value.uint32;
+    sext_32_64(&stack[sp].value.uint64);
+    stack[sp].value_type = I64;
+    NEXT();
+op_i64_extend_u_i32:
+    stack[sp].value.uint64 = stack[sp].value.uint32;
+    stack[sp].value_type = I64;
+    NEXT();
+
+    // value conversion from field from to field to
+#define CONVERT_OP(name, from, to, type) \
+op_##name: \
+    stack[sp].value.to = stack[sp].value.from; \
+    stack[sp].value_type = type; \
+    NEXT();
+
+    CONVERT_OP(f32_convert_s_i32, int32,  f32, F32)
+    CONVERT_OP(f32_convert_u_i32, uint32, f32, F32)
+    CONVERT_OP(f32_convert_s_i64, int64,  f32, F32)
+    CONVERT_OP(f32_convert_u_i64, uint64, f32, F32)
+    CONVERT_OP(f32_demote_f64,    f64,    f32, F32)
+    CONVERT_OP(f64_convert_s_i32, int32,  f64, F64)
+    CONVERT_OP(f64_convert_u_i32, uint32, f64, F64)
+    CONVERT_OP(f64_convert_s_i64, int64,  f64, F64)
+    CONVERT_OP(f64_convert_u_i64, uint64, f64, F64)
+    CONVERT_OP(f64_promote_f32,   f32,    f64, F64)
+
+    // reinterpretations
+op_i32_reinterpret_f32:
+    stack[sp].value_type = I32;
+    NEXT();
+op_i64_reinterpret_f64:
+    stack[sp].value_type = I64;
+    NEXT();
+op_f32_reinterpret_i32:
+    stack[sp].value_type = F32;
+    NEXT();
+op_f64_reinterpret_i64:
+    stack[sp].value_type = F64;
+    NEXT();
+
+op_unknown:
+    TRAP("unrecognized opcode 0x%x", ip->opcode);
+
+#undef SAVE
+#undef LOAD
+#undef NEXT
+#undef TRAP
+#undef PUSH_BLOCK
+#undef BOUNDS
+#undef LOAD_OP
+#undef STORE_OP
+#undef CMP_OP
+#undef UNARY_OP
+#undef BINARY_OP
+#undef TRUNC_OP
+#undef CONVERT_OP
 }
 
+// Evaluate an init_expr: a constant or a get_global followed by end
 void run_init_expr(Module *m, uint8_t type, uint32_t *pc) {
-    // Run the init_expr
-    /*Block block = { .block_type = 0x01,
-                    .type = get_block_type(type),
-                    .start_addr = *pc };*/
-                    
-    Block block;
-    block.block_type = 0x01;
-    block.type = get_block_type(type);
-    block.start_addr = *pc;
-                    
-    m->pc = *pc;
-    push_block(m, &block, m->sp);
-    // WARNING: running code here to get initial value!
-    info("  running init_expr at 0x%x: %s\n",
-            m->pc, block_repr(&block));
-    interpret(m);
-    *pc = m->pc;
+    uint8_t    *bytes = m->bytes;
+    uint32_t    pos = *pc;
+    uint8_t     opcode = bytes[pos++];
+    StackValue *sv = &m->stack[++m->sp];
+
+    info("  running init_expr at 0x%x\n", *pc);
+    sv->value.uint64 = 0;
+    switch (opcode) {
+    case 0x23:  // get_global
+        *sv = m->globals[read_LEB(bytes, &pos, 32)];
+        break;
+    case 0x41:  // i32.const
+        sv->value_type = I32;
+        sv->value.uint32 = read_LEB_signed(bytes, &pos, 32);
+        break;
+    case 0x42:  // i64.const
+        sv->value_type = I64;
+        sv->value.int64 = read_LEB_signed(bytes, &pos, 64);
+        break;
+    case 0x43:  // f32.const
+        sv->value_type = F32;
+        memcpy(&sv->value.uint32, bytes+pos, 4);
+        pos += 4;
+        break;
+    case 0x44:  // f64.const
+        sv->value_type = F64;
+        memcpy(&sv->value.uint64, bytes+pos, 8);
+        pos += 8;
+        break;
+    default:
+        FATAL("unsupported init_expr opcode 0x%x\n", opcode);
+    }
+    ASSERT(bytes[pos] == 0x0b, "init_expr did not end with 0x0b\n");
+    *pc = pos+1;
 
     ASSERT(m->stack[m->sp].value_type == type,
             "init_expr type mismatch 0x%x != 0x%x",
@@ -1526,6 +1523,9 @@ Module *load_module(uint32_t len, uint8_t* file_contents, char *path, Options op
 
     // Allocate the module
     m = (Module*) acalloc(1, sizeof(Module), "Module");
+    if (m == NULL) {
+        return NULL;
+    }
     m->path = path;
     m->options = options;
 
@@ -1541,18 +1541,29 @@ Module *load_module(uint32_t len, uint8_t* file_contents, char *path, Options op
     mod_len = len;
     m->byte_count = mod_len;
     m->bytes = bytes;
-    m->block_lookup = (Block**) acalloc(m->byte_count, sizeof(Block *),
-                                "function->block_lookup");
     m->start_function = -1;
 
     // Check the module
+    if (mod_len < 8) {
+        FATAL("Module too short (%d bytes)\n", mod_len);
+        free_module(m);
+        return NULL;
+    }
     pos = 0;
     memcpy(&word, &bytes[0], 4);
     //word = read_uint32(bytes, &pos);printf("checkpoint\n");
-    ASSERT(word == WA_MAGIC, "Wrong module magic 0x%x %x %x\n", word, bytes[0], WA_MAGIC);
+    if (word != WA_MAGIC) {
+        FATAL("Wrong module magic 0x%x %x %x\n", word, bytes[0], WA_MAGIC);
+        free_module(m);
+        return NULL;
+    }
     //word = read_uint32(bytes, &pos);
     memcpy(&word, &bytes[4], 4);
-    ASSERT(word == WA_VERSION, "Wrong module version 0x%x %x\n", word, WA_VERSION);
+    if (word != WA_VERSION) {
+        FATAL("Wrong module version 0x%x %x\n", word, WA_VERSION);
+        free_module(m);
+        return NULL;
+    }
     pos = 8;
 
     // Read the sections
@@ -1636,7 +1647,7 @@ Module *load_module(uint32_t len, uint8_t* file_contents, char *path, Options op
                     mutability = read_LEB(bytes, &pos, 1); break;
                 }
 
-                void *val;
+                void *val = NULL;
                 char *err;
                 char *sym = (char*) malloc(module_len + field_len + 5);
 
@@ -1676,7 +1687,7 @@ Module *load_module(uint32_t len, uint8_t* file_contents, char *path, Options op
                 // Store in the right place
                 switch (external_kind) {
                 case 0x00:  // Function
-                {/* just removing this and hoping it works out...
+                {
                     fidx = m->function_count;
                     m->import_count += 1;
                     m->function_count += 1;
@@ -1685,6 +1696,7 @@ Module *load_module(uint32_t len, uint8_t* file_contents, char *path, Options op
                                            sizeof(Block), "Block(imports)");
 
                     Block *func = &m->functions[fidx];
+                    func->fidx = fidx;
                     func->import_module = import_module;
                     func->import_field = import_field;
                     func->type = &m->types[type_index];
@@ -1692,10 +1704,13 @@ Module *load_module(uint32_t len, uint8_t* file_contents, char *path, Options op
                         func->import_module, func->import_field, fidx,
                         type_index);
 
-                    func->func_ptr = val;*/
+                    // Unresolved imports trap when called (see thunk_out)
+                    func->func_ptr = (void *(*)())val;
+                    get_host_call(m, func);
                 }
                     break;
                 case 0x01:  // Table
+                    if (!val) { break; }
                     ASSERT(!m->table.entries,
                            "More than 1 table not supported\n");
                     m->table.entries = (uint32_t*)val;
@@ -1703,6 +1718,7 @@ Module *load_module(uint32_t len, uint8_t* file_contents, char *path, Options op
                     m->table.entries = *(uint32_t **)val;
                     break;
                 case 0x02:  // Memory
+                    if (!val) { break; }
                     ASSERT(!m->memory.bytes,
                            "More than 1 memory not supported\n");
                     warn("  setting memory.bytes to: %p\n", *(uint8_t **)val);
@@ -1717,6 +1733,8 @@ Module *load_module(uint32_t len, uint8_t* file_contents, char *path, Options op
                     StackValue *glob = &m->globals[m->global_count-1];
                     glob->value_type = content_type;
 
+                    // Unresolved globals are 0
+                    if (!val) { break; }
                     switch (content_type) {
                     case I32: memcpy(&glob->value.uint32, val, 4); break;
                     case I64: memcpy(&glob->value.uint64, val, 8); break;
@@ -1746,6 +1764,7 @@ Module *load_module(uint32_t len, uint8_t* file_contents, char *path, Options op
                                 "Block(function)");
             if (m->import_count != 0) {
                 memcpy(functions, m->functions, sizeof(Block)*m->import_count);
+                free(m->functions);
             }
             m->functions = functions;
 
@@ -1784,8 +1803,7 @@ Module *load_module(uint32_t len, uint8_t* file_contents, char *path, Options op
             // Allocate memory
             //for (uint32_t c=0; c<memory_count; c++) {
             parse_memory_type(m, &pos);
-            m->memory.bytes = (uint8_t*) acalloc(m->memory.pages*pow(2,16),
-                                    sizeof(uint32_t),
+            m->memory.bytes = (uint8_t*) acalloc(m->memory.pages*WA_PAGE_SIZE, 1,
                                     "Module->memory.bytes");
             //}
         }
@@ -1893,9 +1911,9 @@ Module *load_module(uint32_t len, uint8_t* file_contents, char *path, Options op
                 // Copy the data to the memory offset
                 uint32_t size = read_LEB(bytes, &pos, 32);
                 if (!m->options.disable_memory_bounds) {
-                    ASSERT(offset+size <= m->memory.pages*pow(2,16),
+                    ASSERT(offset+size <= m->memory.pages*WA_PAGE_SIZE,
                         "memory overflow %d+%d > %d\n", offset, size,
-                        (uint32_t)(m->memory.pages*pow(2,16)));
+                        (uint32_t)(m->memory.pages*WA_PAGE_SIZE));
                 }
                 info("  setting 0x%x bytes of memory at offset 0x%x\n",
                      size, offset);
@@ -1957,7 +1975,7 @@ Module *load_module(uint32_t len, uint8_t* file_contents, char *path, Options op
     }
 
 
-    find_blocks(m);
+    decode_module(m);
 
     if (m->start_function != -1) {
         uint32_t fidx = m->start_function;
@@ -1968,20 +1986,21 @@ Module *load_module(uint32_t len, uint8_t* file_contents, char *path, Options op
         if (TRACE && DEBUG) { dump_stacks(m); }
 
         if (fidx < m->import_count) {
-            thunk_out(m, fidx);     // import/thunk call
+            result = thunk_out(m, fidx);     // import/thunk call
         } else {
             setup_call(m, fidx);    // regular function call
         }
 
         if (m->csp < 0) {
             // start function was a direct external call
-            result = true;
         } else {
             // run the function setup by setup_call
             result = interpret(m);
         }
         if (!result) {
             FATAL("Exception: %s\n", exception);
+            free_module(m);
+            return NULL;
         }
     }
 
@@ -2055,3 +2074,113 @@ bool invoke(Module *m, char *entry, int argc, char **argv) {
 
     return result;
 }
+
+// Invoke the exported function entry with typed arguments. The stacks are
+// reset first, so a loaded module can be invoked any number of times.
+// The result, if the function has one, is stored in result.
+// Return value of false means exception occured
+bool invoke_typed(Module *m, char *entry, uint32_t argc, StackValue *args,
+                  StackValue *result) {
+    uint32_t  fidx = get_export_fidx(m, entry);
+    Type     *type;
+    bool      ok;
+
+    result->value_type = 0;
+    result->value.uint64 = 0;
+    if (fidx == (uint32_t)-1) {
+        snprintf(exception, 1024, "no exported function named '%s'", entry);
+        return false;
+    }
+    type = m->functions[fidx].type;
+    if (argc != type->param_count) {
+        snprintf(exception, 1024, "'%s' takes %d arguments, got %d",
+                 entry, type->param_count, argc);
+        return false;
+    }
+    for (uint32_t i=0; i<argc; i++) {
+        if (args[i].value_type != type->params[i]) {
+            snprintf(exception, 1024, "argument %d of '%s' has wrong type",
+                     i, entry);
+            return false;
+        }
+    }
+
+    // Empty stacks
+    m->sp  = -1;
+    m->fp  = -1;
+    m->csp = -1;
+    for (uint32_t i=0; i<argc; i++) {
+        m->stack[++m->sp] = args[i];
+    }
+    _wa_current_module_ = m;
+
+    setup_call(m, fidx);
+    ok = interpret(m);
+    if (ok && type->result_count > 0) {
+        *result = m->stack[m->sp];
+    }
+    return ok;
+}
+
+// Save the linear memory and the globals, to be restored by reset_module
+void snapshot_module(Module *m) {
+    Snapshot *snap = &m->snapshot;
+    uint32_t  size = m->memory.pages*WA_PAGE_SIZE;
+
+    snap->bytes = (uint8_t*) arecalloc(snap->bytes, 0, size, 1,
+                                       "Module->snapshot.bytes");
+    memcpy(snap->bytes, m->memory.bytes, size);
+    snap->pages = m->memory.pages;
+    snap->globals = (StackValue*) arecalloc(snap->globals, 0, m->global_count,
+                                            sizeof(StackValue),
+                                            "Module->snapshot.globals");
+    memcpy(snap->globals, m->globals, m->global_count*sizeof(StackValue));
+    snap->valid = true;
+}
+
+// Restore the state saved by snapshot_module. Memory grown since then is
+// given back.
+// Return value of false means there is no snapshot
+bool reset_module(Module *m) {
+    Snapshot *snap = &m->snapshot;
+    uint32_t  size = snap->pages*WA_PAGE_SIZE;
+
+    if (!snap->valid) {
+        return false;
+    }
+    if (m->memory.pages != snap->pages) {
+        m->memory.bytes = (uint8_t*) arecalloc(m->memory.bytes, 0, size, 1,
+                                               "Module->memory.bytes");
+        m->memory.pages = snap->pages;
+    }
+    memcpy(m->memory.bytes, snap->bytes, size);
+    memcpy(m->globals, snap->globals, m->global_count*sizeof(StackValue));
+    return true;
+}
+
+// Free a module returned by load_module
+void free_module(Module *m) {
+    for (uint32_t t=0; t<m->type_count; t++) {
+        free(m->types[t].params);
+        free(m->types[t].results);
+    }
+    free(m->types);
+    for (uint32_t f=0; f<m->function_count; f++) {
+        free(m->functions[f].locals);
+        free(m->functions[f].export_name);
+        free(m->functions[f].import_module);
+        free(m->functions[f].import_field);
+    }
+    free(m->functions);
+    free(m->code);
+    arena_free(&m->arena);
+    free(m->table.entries);
+    free(m->memory.bytes);
+    free(m->globals);
+    free(m->snapshot.bytes);
+    free(m->snapshot.globals);
+    if (_wa_current_module_ == m) {
+        _wa_current_module_ = NULL;
+    }
+    free(m);
+}
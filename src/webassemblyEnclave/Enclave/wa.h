@@ -1,6 +1,7 @@
 #ifndef WAC_H
 #define WAC_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -11,6 +12,8 @@
 #define BLOCKSTACK_SIZE 0x1000   // 4096
 #define CALLSTACK_SIZE  0x1000   // 4096
 
+#define WA_PAGE_SIZE    0x10000  // 64K
+
 #define I32       0x7f  // -0x01
 #define I64       0x7e  // -0x02
 #define F32       0x7d  // -0x03
@@ -43,7 +46,16 @@ typedef union FuncPtr {
     double (*f64_f64)    (double);
 } FuncPtr;
 
+// How the parameters of a function are passed to or from native code
+// (see thunks.cpp), computed once per function
+typedef struct HostCall {
+    uint32_t   stack_count;   // parameters passed on the native stack
+    uint32_t  *slots;         // register file slot of each parameter
+} HostCall;
+
 // A block or function
+// The addresses are indices into Module->code (for functions, byte
+// positions in the module until the function is decoded).
 typedef struct Block {
     uint8_t    block_type;    // 0x00: function, 0x01: init_exp
                               // 0x02: block, 0x03: loop, 0x04: if
@@ -59,8 +71,22 @@ typedef struct Block {
     char      *import_module; // function only (imported)
     char      *import_field;  // function only (imported)
     void      *(*func_ptr)(); // function only (imported)
+    HostCall  *host_call;     // function only (imported or called natively)
 } Block;
 
+// A pre-decoded instruction
+typedef struct Instr {
+    uint32_t   opcode;
+    uint32_t   arg;           // local/global/function index, branch depth,
+                              // memory offset or br_table count
+    union {
+        uint32_t   uint32;    // i32/f32.const, branch target
+        uint64_t   uint64;    // i64/f64.const
+        Block     *block;     // block, loop, if
+        uint32_t  *targets;   // br_table (depth, target) pairs
+    }          imm;
+} Instr;
+
 ///
 
 typedef struct StackValue {
@@ -100,6 +126,21 @@ typedef struct Memory {
     uint8_t    *bytes;    // memory area
 } Memory;
 
+// Bump allocator for data that lives as long as its module
+typedef struct Arena {
+    uint8_t    *chunk;    // current chunk, chunks are linked by first word
+    size_t      used;     // bytes used in the current chunk
+    size_t      size;     // size of the current chunk
+} Arena;
+
+// Linear memory and globals saved by snapshot_module
+typedef struct Snapshot {
+    bool        valid;
+    uint32_t    pages;    // size of bytes (64K pages)
+    uint8_t    *bytes;
+    StackValue *globals;  // global_count entries
+} Snapshot;
+
 typedef struct Options {
     // when true: host memory addresses will be outside allocated memory area
     // so do not do bounds checking
@@ -128,10 +169,14 @@ typedef struct Module {
     uint32_t    import_count;   // number of leading imports in functions
     uint32_t    function_count; // number of function (including imports)
     Block      *functions;      // imported and locally defined functions
-    Block     **block_lookup;   // map of module byte position to Blocks
-                                // same length as byte_count
     uint32_t    start_function; // function to run on module load
 
+    uint32_t    code_count;     // number of decoded instructions
+    Instr      *code;           // decoded function bodies
+    uint32_t    block_count;    // number of blocks/loops/ifs
+
+    Arena       arena;          // blocks and br_table targets
+
     Table       table;
 
     Memory      memory;
@@ -139,8 +184,10 @@ typedef struct Module {
     uint32_t    global_count;   // number of globals
     StackValue *globals;        // globals
 
+    Snapshot    snapshot;       // state restored by reset_module
+
     // Runtime state
-    uint32_t    pc;                // program counter
+    uint32_t    pc;                // program counter (index into code)
     int         sp;                // operand stack pointer
     int         fp;                // current frame pointer into stack
     StackValue  stack[STACK_SIZE]; // main operand stack
@@ -152,12 +199,19 @@ typedef struct Module {
 // Function declarations (Public API)
 //
 
-extern char exception[];
+extern __thread char exception[];
 char *value_repr(StackValue *v);
 uint32_t get_export_fidx(Module *m, char *name);
 void (*setup_thunk_in(uint32_t fidx))();
 bool interpret(Module *m);
+// NULL if the module is malformed or its start function traps. The
+// module keeps path, which the caller frees after free_module.
 Module *load_module(uint32_t len, uint8_t* file_contents, char *path, Options opts);
 bool invoke(Module *m, char *entry, int argc, char **argv);
+bool invoke_typed(Module *m, char *entry, uint32_t argc, StackValue *args,
+                  StackValue *result);
+void snapshot_module(Module *m);
+bool reset_module(Module *m);
+void free_module(Module *m);
 
 #endif // of WAC_H